@@ -0,0 +1,679 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/program_options.hpp"
+
+#include "fmt/format.h"
+
+#include "osmium/io/pbf_input.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/object.hpp"
+
+#include "utl/enumerate.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/keystroke_trace.h"
+#include "adr/normalize.h"
+#include "adr/osm_filter.h"
+#include "adr/osm_filter_reference.h"
+#include "adr/query_profile.h"
+#include "adr/result_cache.h"
+#include "adr/reverse.h"
+#include "adr/score.h"
+#include "adr/sift4.h"
+#include "adr/typeahead.h"
+
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+
+using bench_clock = std::chrono::steady_clock;
+
+// Keeps benchmarked results alive (the optimizer can't drop the calls).
+static volatile std::uint64_t sink = 0U;
+
+struct micro_result {
+  std::string name_;
+  std::uint64_t iterations_;
+  double ns_per_op_;
+};
+
+// Runs fn(i) for i = 0, 1, ... Doubles the number of iterations until one
+// round takes at least min_seconds, like Google Benchmark.
+template <typename Fn>
+micro_result run_micro(std::string name, double const min_seconds, Fn&& fn) {
+  auto n = std::uint64_t{1U};
+  while (true) {
+    auto const start = bench_clock::now();
+    for (auto i = std::uint64_t{0U}; i != n; ++i) {
+      fn(i);
+    }
+    auto const ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            bench_clock::now() - start)
+            .count());
+    if (ns >= min_seconds * 1e9 || n >= (std::uint64_t{1U} << 32U)) {
+      return {std::move(name), n, ns / static_cast<double>(n)};
+    }
+    n *= 2U;
+  }
+}
+
+// Latency percentiles in microseconds as JSON object (sorts the values).
+std::string latency_json(std::vector<std::uint64_t>& ns) {
+  std::sort(begin(ns), end(ns));
+  return fmt::format(
+      "{{\"count\": {}, \"p50\": {:.1f}, \"p90\": {:.1f}, "
+      "\"p99\": {:.1f}, \"p999\": {:.1f}, \"max\": {:.1f}}}",
+      ns.size(), adr::percentile(ns, 0.5) / 1e3,
+      adr::percentile(ns, 0.9) / 1e3, adr::percentile(ns, 0.99) / 1e3,
+      adr::percentile(ns, 0.999) / 1e3, (ns.empty() ? 0U : ns.back()) / 1e3);
+}
+
+double ratio(std::uint64_t const a, std::uint64_t const b) {
+  return b == 0U ? 0.0 : static_cast<double>(a) / static_cast<double>(b);
+}
+
+// Keystroke latencies are reported per input length (code points).
+constexpr auto const kPrefixBucketNames =
+    std::array<std::string_view, 7U>{"1", "2", "3", "4", "5-8", "9-16", "17+"};
+
+std::uint8_t get_prefix_bucket(std::string_view input) {
+  auto const len = adr::utf8_codepoint_count(input);
+  if (len <= 4U) {
+    return static_cast<std::uint8_t>(std::max(len, std::size_t{1U}) - 1U);
+  } else if (len <= 8U) {
+    return 4U;
+  } else if (len <= 16U) {
+    return 5U;
+  }
+  return 6U;
+}
+
+struct replay_sample {
+  std::uint64_t latency_ns_;
+  std::uint64_t lag_ns_;  // start behind the trace schedule
+  std::uint8_t prefix_bucket_;
+};
+
+// Query with the expected location (recall measurement).
+struct labelled_query {
+  std::string input_;
+  geo::latlng expected_;
+};
+
+// Tab separated: query, lat, lng (one per line).
+std::vector<labelled_query> read_labelled_queries(fs::path const& file) {
+  auto labelled = std::vector<labelled_query>{};
+  for (auto const& line : adr::read_queries(file)) {
+    auto const lng_sep = line.rfind('\t');
+    auto const lat_sep = lng_sep == std::string::npos || lng_sep == 0U
+                             ? std::string::npos
+                             : line.rfind('\t', lng_sep - 1U);
+    if (lat_sep == std::string::npos) {
+      continue;
+    }
+    labelled.push_back(
+        {.input_ = line.substr(0U, lat_sep),
+         .expected_ = {std::stod(line.substr(lat_sep + 1U)),
+                       std::stod(line.substr(lng_sep + 1U))}});
+  }
+  return labelled;
+}
+
+// Samples places (name) and addresses (street + house number) from the
+// extract with a fixed seed.
+std::vector<labelled_query> generate_labelled_queries(adr::typeahead const& t,
+                                                      unsigned const n) {
+  auto rng = std::mt19937{42U};
+  auto labelled = std::vector<labelled_query>{};
+  auto const n_places = t.place_names_.size();
+  auto const n_streets = t.street_names_.size();
+  for (auto i = 0U; i != 16U * n && labelled.size() != n; ++i) {
+    if (i % 2U == 0U && n_places != 0U) {
+      auto const p =
+          adr::place_idx_t{static_cast<std::uint32_t>(rng() % n_places)};
+      if (t.place_names_[p].empty()) {
+        continue;
+      }
+      labelled.push_back(
+          {.input_ = std::string{t.strings_[t.place_names_[p][0]].view()},
+           .expected_ = t.place_coordinates_[p].as_latlng()});
+    } else if (n_streets != 0U) {
+      auto const s =
+          adr::street_idx_t{static_cast<std::uint32_t>(rng() % n_streets)};
+      auto const house_numbers = t.house_numbers_[s];
+      if (house_numbers.empty() || t.street_names_[s].empty()) {
+        continue;
+      }
+      auto const h = rng() % house_numbers.size();
+      labelled.push_back(
+          {.input_ = fmt::format("{} {}",
+                                 t.strings_[t.street_names_[s][0]].view(),
+                                 t.strings_[house_numbers[h]].view()),
+           .expected_ = t.house_coordinates_[s][h].as_latlng()});
+    }
+  }
+  return labelled;
+}
+
+// Runs the labelled queries with the given candidate limits (one thread,
+// fresh ngram cache) and returns the result as JSON object.
+std::string tune_run(adr::typeahead const& t,
+                     std::vector<labelled_query> const& labelled,
+                     std::string_view name,
+                     adr::candidate_limits const& limits,
+                     unsigned const n,
+                     double const radius) {
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto cache = adr::cache{t.strings_.size(), 1000U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(t);
+  ctx.limits_ = limits;
+
+  auto hits_at_1 = 0U;
+  auto hits_at_n = 0U;
+  auto strings = std::uint64_t{0U};
+  auto scored = std::uint64_t{0U};
+  auto latencies = std::vector<std::uint64_t>{};
+  for (auto const& q : labelled) {
+    adr::get_suggestions<false>(t, q.input_, n, langs, ctx, std::nullopt,
+                                1.0F);
+    latencies.push_back(ctx.profile_.ns(adr::query_stage::kTotal));
+    strings += ctx.profile_.n_string_matches_;
+    scored += ctx.profile_.n_street_matches_ + ctx.profile_.n_place_matches_;
+    for (auto const [i, s] : utl::enumerate(ctx.suggestions_)) {
+      if (geo::distance(s.coordinates_.as_latlng(), q.expected_) <= radius) {
+        hits_at_1 += i == 0U ? 1U : 0U;
+        ++hits_at_n;
+        break;
+      }
+    }
+  }
+
+  auto const n_queries = static_cast<std::uint64_t>(labelled.size());
+  return fmt::format(
+      "{{\"name\": \"{}\", \"cos_sim_ratio\": {}, \"score_gap\": {}, "
+      "\"recall_at_1\": {:.4f}, \"recall_at_n\": {:.4f}, "
+      "\"mean_strings\": {:.1f}, \"mean_scored\": {:.1f}, "
+      "\"latency_us\": {}}}",
+      name, limits.cos_sim_ratio_, limits.score_gap_,
+      ratio(hits_at_1, n_queries), ratio(hits_at_n, n_queries),
+      ratio(strings, n_queries), ratio(scored, n_queries),
+      latency_json(latencies));
+}
+
+// Recall / latency tradeoff of the fixed limits and a grid of adaptive
+// cutoffs on a labelled query set.
+std::string tune(adr::typeahead const& t,
+                 std::vector<labelled_query> const& labelled,
+                 unsigned const n,
+                 double const radius) {
+  auto json = fmt::format(
+      "{{\n  \"queries\": {},\n  \"radius_m\": {},\n  \"runs\": [",
+      labelled.size(), radius);
+  json += fmt::format(
+      "\n    {}", tune_run(t, labelled, "fixed",
+                          adr::candidate_limits::fixed(), n, radius));
+  for (auto const cos_sim_ratio : {0.0F, 0.4F, 0.5F, 0.6F, 0.7F}) {
+    for (auto const score_gap : {0.0F, 2.0F, 4.0F, 8.0F}) {
+      if (cos_sim_ratio == 0.0F && score_gap == 0.0F) {
+        continue;  // = fixed
+      }
+      auto limits = adr::candidate_limits::fixed();
+      limits.cos_sim_ratio_ = cos_sim_ratio;
+      limits.score_gap_ = score_gap;
+      json += fmt::format(",\n    {}", tune_run(t, labelled, "adaptive",
+                                                 limits, n, radius));
+    }
+  }
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+int main(int ac, char** av) {
+  auto in = fs::path{"adr"};
+  auto queries_file = fs::path{"test/darmstadt_queries.txt"};
+  auto out = fs::path{};
+  auto threads = std::thread::hardware_concurrency();
+  auto runs = 10U;
+  auto n = 10U;
+  auto min_seconds = 0.5;
+  auto micro = false;
+  auto keystrokes = false;
+  auto trace_file = fs::path{};
+  auto write_trace_file = fs::path{};
+  auto sessions = 1000U;
+  auto time_scale = 0.0;
+  auto result_cache_size = 0U;
+  auto tune_mode = false;
+  auto labels_file = fs::path{};
+  auto osm_file = fs::path{};
+  auto tune_queries = 1000U;
+  auto tune_radius = 100.0;
+  auto lat = 49.8731001322536;
+  auto lng = 8.647738878714677;
+
+  try {
+    bpo::options_description desc{"Options"};
+    desc.add_options()  //
+        ("help,h", "Help screen")  //
+        ("in,i", bpo::value(&in)->default_value(in), "extract directory")  //
+        ("queries,q", bpo::value(&queries_file)->default_value(queries_file),
+         "query corpus (one query per line)")  //
+        ("out,o", bpo::value(&out), "JSON output file (default: stdout)")  //
+        ("threads,t", bpo::value(&threads)->default_value(threads),
+         "replay concurrency")  //
+        ("runs,r", bpo::value(&runs)->default_value(runs),
+         "passes over the query corpus")  //
+        (",n", bpo::value(&n)->default_value(n), "number of suggestions")  //
+        ("micro", "run the micro benchmarks")  //
+        ("keystrokes,k",
+         "replay the corpus as keystroke sessions (prefix per key)")  //
+        ("sessions", bpo::value(&sessions)->default_value(sessions),
+         "number of generated keystroke sessions")  //
+        ("trace", bpo::value(&trace_file),
+         "replay a recorded keystroke trace")  //
+        ("write-trace", bpo::value(&write_trace_file),
+         "write the replayed requests as keystroke trace")  //
+        ("time-scale", bpo::value(&time_scale)->default_value(time_scale),
+         "trace timing: 1 = real time, 0.5 = twice as fast, 0 = no waits")  //
+        ("result-cache",
+         bpo::value(&result_cache_size)->default_value(result_cache_size),
+         "result cache entries (0 = disabled)")  //
+        ("min-time", bpo::value(&min_seconds)->default_value(min_seconds),
+         "minimum time per micro benchmark (seconds)")  //
+        ("osm", bpo::value(&osm_file),
+         "OSM PBF for the classify_tags micro benchmark")  //
+        ("tune",
+         "recall / latency of fixed vs. adaptive candidate limits")  //
+        ("labels", bpo::value(&labels_file),
+         "labelled queries for --tune (query<TAB>lat<TAB>lng, default: "
+         "generated from the extract)")  //
+        ("tune-queries", bpo::value(&tune_queries)->default_value(tune_queries),
+         "number of generated labelled queries")  //
+        ("tune-radius", bpo::value(&tune_radius)->default_value(tune_radius),
+         "max. distance (meters) of a correct suggestion")  //
+        ("lat", bpo::value<double>(&lat)->default_value(lat), "bias lat")  //
+        ("lng", bpo::value<double>(&lng)->default_value(lng), "bias lng");
+
+    auto const parsed_options =
+        bpo::command_line_parser{ac, av}.options(desc).run();
+    auto vm = bpo::variables_map{};
+    bpo::store(parsed_options, vm);
+    bpo::notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << '\n';
+      return 0;
+    }
+    if (vm.count("micro")) {
+      micro = true;
+    }
+    if (vm.count("keystrokes")) {
+      keystrokes = true;
+    }
+    if (vm.count("tune")) {
+      tune_mode = true;
+    }
+  } catch (bpo::error const& ex) {
+    std::cerr << ex.what() << '\n';
+    return 1;
+  }
+
+  if (tune_mode) {
+    auto const t = adr::read(in / "t.bin");
+    auto const labelled = labels_file.empty()
+                              ? generate_labelled_queries(*t, tune_queries)
+                              : read_labelled_queries(labels_file);
+    if (labelled.empty()) {
+      std::cerr << "no labelled queries\n";
+      return 1;
+    }
+    auto const json = tune(*t, labelled, n, tune_radius);
+    if (out.empty()) {
+      std::cout << json;
+    } else {
+      auto f = std::ofstream{out};
+      f << json;
+    }
+    return 0;
+  }
+
+  auto const queries = adr::read_queries(queries_file);
+  if (queries.empty() || threads == 0U) {
+    std::cerr << "no queries or no threads\n";
+    return 1;
+  }
+
+  auto const t = adr::read(in / "t.bin");
+  auto const r = adr::reverse{in, cista::mmap::protection::READ};
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const coord = std::optional{geo::latlng{lat, lng}};
+
+  // Micro benchmarks: single thread, fixed seed inputs from the extract.
+  auto micro_results = std::vector<micro_result>{};
+  if (micro) {
+    auto rng = std::mt19937{42U};
+    auto sample = std::vector<std::string>{};
+    auto normalized = std::vector<std::string>{};
+    auto buf = adr::utf8_normalize_buf_t{};
+    for (auto i = 0U; i != 1024U && !t->strings_.empty(); ++i) {
+      auto const s = t->strings_[adr::string_idx_t{static_cast<std::uint32_t>(
+          rng() % t->strings_.size())}];
+      sample.emplace_back(s.view());
+      normalized.emplace_back(adr::normalize(s.view(), buf));
+    }
+    auto normalized_queries = std::vector<std::string>{};
+    for (auto const& q : queries) {
+      normalized_queries.emplace_back(adr::normalize(q, buf));
+    }
+
+    auto const at = [](auto const& v, std::uint64_t const i) -> auto const& {
+      return v[i % v.size()];
+    };
+
+    if (!sample.empty()) {
+      auto offsets = std::vector<adr::sift_offset>{};
+      micro_results.push_back(
+          run_micro("sift4", min_seconds, [&](std::uint64_t const i) {
+            auto const& a = at(normalized, i);
+            auto const& b = at(normalized, i * 7U + 1U);
+            sink = sink + adr::sift4(a, b, 3U,
+                                     static_cast<adr::edit_dist_t>(
+                                         std::min(a.size(), b.size()) / 2U +
+                                         2U),
+                                     offsets);
+          }));
+
+      micro_results.push_back(
+          run_micro("normalize", min_seconds, [&](std::uint64_t const i) {
+            sink = sink + adr::normalize(at(sample, i), buf).size();
+          }));
+
+      auto mem = std::string{};
+      auto tokens = std::vector<std::string_view>{};
+      micro_results.push_back(run_micro(
+          "get_match_score", min_seconds, [&](std::uint64_t const i) {
+            auto const score =
+                adr::get_match_score(at(sample, i), at(normalized, i * 7U + 1U),
+                                     offsets, buf, mem, tokens);
+            sink = sink + std::bit_cast<std::uint32_t>(score);
+          }));
+    }
+
+    {  // Bigram counting + cos sim without ngram cache (max_size=0).
+      auto no_cache = adr::cache{t->strings_.size(), 0U};
+      auto ctx = adr::guess_context{no_cache};
+      ctx.resize(*t);
+      micro_results.push_back(
+          run_micro("guess", min_seconds, [&](std::uint64_t const i) {
+            t->guess<false>(at(normalized_queries, i), ctx, std::nullopt,
+                            adr::filter_type::kNone);
+            sink = sink + ctx.string_matches_.size();
+          }));
+
+      // Same queries with dynamic pruning (falls back to counting if the
+      // query bigrams are not worth it).
+      ctx.prune_candidates_ = true;
+      micro_results.push_back(
+          run_micro("guess_pruned", min_seconds, [&](std::uint64_t const i) {
+            t->guess<false>(at(normalized_queries, i), ctx, std::nullopt,
+                            adr::filter_type::kNone);
+            sink = sink + ctx.string_matches_.size();
+          }));
+    }
+
+    {  // match_streets() is internal: street_match stage of the profile.
+      auto cache = adr::cache{t->strings_.size(), 1000U};
+      auto ctx = adr::guess_context{cache};
+      ctx.resize(*t);
+      auto street_match_ns = std::uint64_t{0U};
+      auto const res = run_micro(
+          "get_suggestions", min_seconds, [&](std::uint64_t const i) {
+            adr::get_suggestions<false>(*t, at(queries, i), n, langs, ctx,
+                                        coord, 1.0F);
+            street_match_ns +=
+                ctx.profile_.ns(adr::query_stage::kStreetMatch);
+          });
+      micro_results.push_back(res);
+      micro_results.push_back(
+          {"match_streets", res.iterations_,
+           static_cast<double>(street_match_ns) /
+               static_cast<double>(res.iterations_)});
+    }
+
+    if (!osm_file.empty()) {  // Tag filter of extract() pass 2.
+      auto buffers = std::vector<osmium::memory::Buffer>{};
+      auto objects = std::vector<osmium::OSMObject const*>{};
+      auto reader = osmium::io::Reader{
+          osm_file.generic_string(),
+          osmium::osm_entity_bits::node | osmium::osm_entity_bits::way};
+      while (auto buffer = reader.read()) {
+        for (auto const& o : buffer.select<osmium::OSMObject>()) {
+          objects.push_back(&o);
+        }
+        buffers.push_back(std::move(buffer));
+      }
+      reader.close();
+
+      // classify_tags() vs. the tag list searches it replaced (same checks).
+      if (!objects.empty()) {
+        micro_results.push_back(run_micro(
+            "classify_tags", min_seconds, [&](std::uint64_t const i) {
+              auto const& o = *at(objects, i);
+              auto const c = adr::classify_tags(o.tags());
+              sink = sink +
+                     (o.type() == osmium::item_type::way
+                          ? c.is_relevant_way()
+                          : c.is_relevant_node()) +
+                     c.has(adr::tag_class::kName) +
+                     c.has(adr::tag_class::kHighway) + c.is_address();
+            }));
+        micro_results.push_back(run_micro(
+            "classify_tags_reference", min_seconds,
+            [&](std::uint64_t const i) {
+              auto const& o = *at(objects, i);
+              auto const& tags = o.tags();
+              sink = sink +
+                     (o.type() == osmium::item_type::way
+                          ? adr::is_relevant_way_reference(tags)
+                          : adr::is_relevant_node_reference(tags)) +
+                     tags.has_key("name") + tags.has_key("highway") +
+                     adr::is_address_reference(tags);
+            }));
+      }
+    }
+
+    if (!t->place_coordinates_.empty()) {
+      auto const n_places =
+          static_cast<std::uint32_t>(t->place_coordinates_.size());
+      auto jitter = std::uniform_real_distribution{-0.001, 0.001};
+      auto points = std::vector<geo::latlng>{};
+      for (auto i = 0U; i != 1024U; ++i) {
+        auto const p = adr::place_idx_t{static_cast<std::uint32_t>(rng()) %
+                                        n_places};
+        auto const c = t->place_coordinates_[p].as_latlng();
+        points.emplace_back(c.lat() + jitter(rng), c.lng() + jitter(rng));
+      }
+      micro_results.push_back(
+          run_micro("reverse_lookup", min_seconds, [&](std::uint64_t const i) {
+            sink = sink + r.lookup(*t, at(points, i), 10U).size();
+          }));
+    }
+  }
+
+  // Replay: full queries (`runs` passes over the corpus) or a keystroke
+  // trace. Workers claim whole sessions (each exactly once via fetch_add)
+  // and replay their keystrokes in order, like one user per session.
+  auto requests = std::vector<adr::keystroke>{};
+  if (!trace_file.empty()) {
+    requests = adr::read_keystroke_trace(trace_file);
+  } else if (keystrokes) {
+    requests = adr::generate_keystroke_trace(queries, sessions);
+  } else {
+    for (auto run = 0U; run != runs; ++run) {
+      for (auto const [i, q] : utl::enumerate(queries)) {
+        requests.push_back(
+            {.session_ = static_cast<std::uint32_t>(run * queries.size() + i),
+             .offset_ms_ = 0U,
+             .input_ = q});
+      }
+    }
+  }
+  if (!write_trace_file.empty()) {
+    auto f = std::ofstream{write_trace_file};
+    adr::write_keystroke_trace(f, requests);
+  }
+  auto const is_trace = keystrokes || !trace_file.empty();
+
+  // Request indices per session (in trace order).
+  auto session_requests = std::vector<std::vector<std::size_t>>{};
+  {
+    auto session_idx = cista::raw::ankerl_map<std::uint32_t, std::size_t>{};
+    for (auto const [i, k] : utl::enumerate(requests)) {
+      auto const [it, inserted] =
+          session_idx.emplace(k.session_, session_requests.size());
+      if (inserted) {
+        session_requests.emplace_back();
+      }
+      session_requests[it->second].push_back(i);
+    }
+  }
+
+  auto cache = adr::cache{t->strings_.size(), 1000U};
+  auto result_cache = std::optional<adr::result_cache>{};
+  if (result_cache_size != 0U) {
+    result_cache.emplace(result_cache_size);
+  }
+  auto metrics = adr::query_metrics{};
+  auto next = std::atomic_uint64_t{0U};
+  auto samples = std::vector<std::vector<replay_sample>>(threads);
+  auto workers = std::vector<std::thread>{};
+
+  auto const start = bench_clock::now();
+  for (auto i = 0U; i != threads; ++i) {
+    workers.emplace_back([&, i]() {
+      auto ctx = adr::guess_context{cache};
+      ctx.resize(*t);
+      ctx.query_metrics_ = &metrics;
+      ctx.result_cache_ = result_cache.has_value() ? &*result_cache : nullptr;
+      auto& thread_samples = samples[i];
+      for (auto session = next.fetch_add(1U);
+           session < session_requests.size(); session = next.fetch_add(1U)) {
+        for (auto const req : session_requests[session]) {
+          auto const& k = requests[req];
+          auto const scheduled =
+              start + std::chrono::duration_cast<bench_clock::duration>(
+                          std::chrono::duration<double, std::milli>{
+                              static_cast<double>(k.offset_ms_) * time_scale});
+          if (time_scale > 0.0) {
+            std::this_thread::sleep_until(scheduled);
+          }
+          auto const lag = time_scale > 0.0 ? bench_clock::now() - scheduled
+                                            : bench_clock::duration{};
+          adr::get_suggestions<false>(*t, k.input_, n, langs, ctx, coord, 1.0F);
+          thread_samples.push_back(
+              {.latency_ns_ = ctx.profile_.ns(adr::query_stage::kTotal),
+               .lag_ns_ = static_cast<std::uint64_t>(std::max(
+                   std::int64_t{0},
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(lag)
+                       .count())),
+               .prefix_bucket_ = get_prefix_bucket(k.input_)});
+        }
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  auto const wall_seconds =
+      std::chrono::duration<double>{bench_clock::now() - start}.count();
+
+  auto all = std::vector<std::uint64_t>{};
+  auto lags = std::vector<std::uint64_t>{};
+  auto by_prefix =
+      std::array<std::vector<std::uint64_t>, kPrefixBucketNames.size()>{};
+  for (auto const& thread_samples : samples) {
+    for (auto const& x : thread_samples) {
+      all.push_back(x.latency_ns_);
+      lags.push_back(x.lag_ns_);
+      by_prefix[x.prefix_bucket_].push_back(x.latency_ns_);
+    }
+  }
+
+  auto json = fmt::format(
+      "{{\n"
+      "  \"input\": \"{}\",\n"
+      "  \"trace\": {},\n"
+      "  \"threads\": {},\n"
+      "  \"queries\": {},\n"
+      "  \"wall_seconds\": {:.6f},\n"
+      "  \"throughput_qps\": {:.2f},\n"
+      "  \"latency_us\": {},\n",
+      trace_file.empty() ? queries_file.generic_string()
+                         : trace_file.generic_string(),
+      is_trace, threads, all.size(), wall_seconds,
+      static_cast<double>(all.size()) / wall_seconds, latency_json(all));
+
+  if (is_trace) {
+    json += "  \"latency_us_by_prefix_length\": {";
+    for (auto const [i, name] : utl::enumerate(kPrefixBucketNames)) {
+      json += fmt::format("{}\n    \"{}\": {}", i == 0U ? "" : ",", name,
+                          latency_json(by_prefix[i]));
+    }
+    json += "\n  },\n";
+    if (time_scale > 0.0) {
+      json += fmt::format("  \"lag_us\": {},\n", latency_json(lags));
+    }
+  }
+
+  auto const ngram_cache = cache.get_stats();
+  auto const lookups =
+      ngram_cache.hits_ + ngram_cache.partial_hits_ + ngram_cache.misses_;
+  json += fmt::format(
+      "  \"ngram_cache\": {{\"hits\": {}, \"partial_hits\": {}, "
+      "\"misses\": {}, \"hit_ratio\": {:.4f}, \"bigram_reuse\": {:.4f}}},\n"
+      "  \"short_prefix_queries\": {},\n",
+      ngram_cache.hits_, ngram_cache.partial_hits_, ngram_cache.misses_,
+      ratio(ngram_cache.hits_ + ngram_cache.partial_hits_, lookups),
+      ratio(metrics.cached_ngrams_.load(), metrics.ngrams_.load()),
+      metrics.short_prefix_queries_.load());
+  if (result_cache.has_value()) {
+    auto const rc = result_cache->get_stats();
+    json += fmt::format(
+        "  \"result_cache\": {{\"hits\": {}, \"misses\": {}, "
+        "\"hit_ratio\": {:.4f}}},\n",
+        rc.hits_, rc.misses_, ratio(rc.hits_, rc.hits_ + rc.misses_));
+  }
+
+  json += "  \"micro\": [";
+  for (auto const [i, m] : utl::enumerate(micro_results)) {
+    json += fmt::format(
+        "{}\n    {{\"name\": \"{}\", \"iterations\": {}, "
+        "\"ns_per_op\": {:.1f}}}",
+        i == 0U ? "" : ",", m.name_, m.iterations_, m.ns_per_op_);
+  }
+  json += micro_results.empty() ? "]\n}\n" : "\n  ]\n}\n";
+
+  if (out.empty()) {
+    std::cout << json;
+  } else {
+    auto f = std::ofstream{out};
+    f << json;
+  }
+}
\ No newline at end of file
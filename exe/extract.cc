@@ -16,6 +16,7 @@ int main(int ac, char** av) {
   auto in = std::string{"osm.pbf"};
   auto out = std::string{"adr"};
   auto tmp = std::string{"."};
+  auto geo_index = false;
 
   try {
     bpo::options_description desc{"Options"};
@@ -26,7 +27,9 @@ int main(int ac, char** av) {
         ("out,o", bpo::value(&out)->default_value(out),
          "output file")  //
         ("tmp_dir,t", bpo::value(&tmp)->default_value(tmp),
-         "directory for temporary files");
+         "directory for temporary files")  //
+        ("geo-index",
+         "build the geo-partitioned bigram index (adr-typeahead --geo)");
 
     auto const pos_desc =
         bpo::positional_options_description{}.add("in", 1).add("out", -1);
@@ -44,6 +47,7 @@ int main(int ac, char** av) {
       std::cout << desc << '\n';
       return 0;
     }
+    geo_index = vm.count("geo-index") != 0U;
   } catch (bpo::error const& ex) {
     std::cerr << ex.what() << '\n';
     return 1;
@@ -52,5 +56,5 @@ int main(int ac, char** av) {
   std::cout << "IN: " << in << "\n"
             << "OUT: " << out << "\n"
             << "TMP: " << tmp << "\n";
-  adr::extract(in, out, tmp);
+  adr::extract(in, out, tmp, geo_index);
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <filesystem>
+#include <iostream>
+
+#include "boost/program_options.hpp"
+
+#include "utl/to_vec.h"
+
+#include "adr/adr.h"
+
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+
+int main(int ac, char** av) {
+  auto in = std::vector<std::string>{};
+  auto out = std::string{"adr"};
+
+  try {
+    bpo::options_description desc{"Options"};
+    desc.add_options()  //
+        ("help,h", "Help screen")  //
+        ("in,i", bpo::value(&in)->multitoken(),
+         "extract directories to merge")  //
+        ("out,o", bpo::value(&out)->default_value(out),
+         "output directory");
+
+    auto const pos_desc =
+        bpo::positional_options_description{}.add("in", -1);
+
+    auto const parsed_options = bpo::command_line_parser{ac, av}
+                                    .options(desc)
+                                    .positional(pos_desc)
+                                    .run();
+    auto vm = bpo::variables_map{};
+    bpo::store(parsed_options, vm);
+    bpo::notify(vm);
+
+    if (vm.count("help") || in.empty()) {
+      std::cout << desc << '\n';
+      return 0;
+    }
+  } catch (bpo::error const& ex) {
+    std::cerr << ex.what() << '\n';
+    return 1;
+  }
+
+  for (auto const& x : in) {
+    std::cout << "IN: " << x << "\n";
+  }
+  std::cout << "OUT: " << out << "\n";
+  adr::merge(utl::to_vec(in, [](auto&& x) { return fs::path{x}; }), out);
+}
\ No newline at end of file
@@ -0,0 +1,633 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/asio/executor_work_guard.hpp"
+#include "boost/asio/io_context.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/post.hpp"
+#include "boost/asio/signal_set.hpp"
+#include "boost/beast/core.hpp"
+#include "boost/beast/http.hpp"
+#include "boost/program_options.hpp"
+
+#include "fmt/format.h"
+
+
+#include "adr/adr.h"
+#include "adr/guess_context.h"
+#include "adr/index_handle.h"
+#include "adr/json.h"
+#include "adr/keystroke_trace.h"
+#include "adr/query_profile.h"
+#include "adr/reverse.h"
+#include "adr/typeahead.h"
+
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+namespace bpo = boost::program_options;
+namespace fs = std::filesystem;
+namespace http = beast::http;
+using tcp = asio::ip::tcp;
+
+using bench_clock = std::chrono::steady_clock;
+
+constexpr auto const kMaxSuggestions = 100U;
+constexpr auto const kIdleTimeout = std::chrono::seconds{30};
+
+// Percent decoding of URL query components ('+' is a space).
+std::string url_decode(std::string_view in) {
+  auto const hex = [](char const c) -> int {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    return -1;
+  };
+
+  auto out = std::string{};
+  out.reserve(in.size());
+  for (auto i = 0U; i < in.size(); ++i) {
+    if (in[i] == '+') {
+      out.push_back(' ');
+    } else if (in[i] == '%' && i + 2U < in.size() && hex(in[i + 1U]) != -1 &&
+               hex(in[i + 2U]) != -1) {
+      out.push_back(
+          static_cast<char>(hex(in[i + 1U]) * 16 + hex(in[i + 2U])));
+      i += 2U;
+    } else {
+      out.push_back(in[i]);
+    }
+  }
+  return out;
+}
+
+std::string url_encode(std::string_view in) {
+  constexpr auto const kHex = std::string_view{"0123456789ABCDEF"};
+  auto out = std::string{};
+  out.reserve(in.size() * 3U);
+  for (auto const c : in) {
+    auto const u = static_cast<unsigned char>(c);
+    if (std::isalnum(u) || c == '-' || c == '_' || c == '.' || c == '~') {
+      out.push_back(c);
+    } else {
+      out.push_back('%');
+      out.push_back(kHex[u >> 4U]);
+      out.push_back(kHex[u & 0xFU]);
+    }
+  }
+  return out;
+}
+
+// Value of the query parameter `name` in a request target "/path?a=1&b=2".
+std::optional<std::string> get_param(std::string_view target,
+                                     std::string_view name) {
+  auto const q = target.find('?');
+  if (q == std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto query = target.substr(q + 1U);
+  while (!query.empty()) {
+    auto const amp = query.find('&');
+    auto const kv = query.substr(0U, amp);
+    auto const eq = kv.find('=');
+    if (kv.substr(0U, eq) == name) {
+      return eq == std::string_view::npos ? std::string{}
+                                          : url_decode(kv.substr(eq + 1U));
+    }
+    query = amp == std::string_view::npos ? std::string_view{}
+                                          : query.substr(amp + 1U);
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<T> get_number(std::string_view target, std::string_view name) {
+  auto const s = get_param(target, name);
+  if (!s.has_value()) {
+    return std::nullopt;
+  }
+  auto x = T{};
+  auto const [ptr, ec] = std::from_chars(s->data(), s->data() + s->size(), x);
+  if (ec != std::errc{} || ptr != s->data() + s->size()) {
+    throw std::runtime_error{fmt::format("invalid number {}={}", name, *s)};
+  }
+  return x;
+}
+
+std::string_view get_path(std::string_view target) {
+  return target.substr(0U, target.find('?'));
+}
+
+struct server_config {
+  std::size_t n_suggestions_{10U};
+  std::uint64_t budget_us_{0U};  // 0 = unlimited
+  bool geo_candidates_{false};
+  bool prune_candidates_{false};
+  adr::candidate_limits limits_;
+};
+
+// One per thread: owns an io_context (sessions accepted for this worker only
+// run on its thread) and the guess_context used by all of them. No locking.
+struct worker {
+  adr::guess_context& get_context(
+      std::shared_ptr<adr::index_generation const> const& g) {
+    if (g != generation_) {
+      if (ctx_.has_value()) {
+        g->bind(*ctx_);
+      } else {
+        ctx_.emplace(g->make_context());
+      }
+      generation_ = g;
+    }
+    return *ctx_;
+  }
+
+  asio::io_context ioc_{1};
+  std::shared_ptr<adr::index_generation const> generation_;
+  std::optional<adr::guess_context> ctx_;
+};
+
+struct server {
+  server(adr::index_handle& index, server_config const& config, unsigned n)
+      : index_{index},
+        config_{config},
+        workers_(n),
+        acceptor_{workers_.front().ioc_} {}
+
+  void listen(std::string const& host, unsigned short port) {
+    auto const ep = tcp::endpoint{asio::ip::make_address(host), port};
+    acceptor_.open(ep.protocol());
+    acceptor_.set_option(asio::socket_base::reuse_address{true});
+    acceptor_.bind(ep);
+    acceptor_.listen(asio::socket_base::max_listen_connections);
+    accept();
+  }
+
+  unsigned short port() const { return acceptor_.local_endpoint().port(); }
+
+  void run() {
+    auto guards = std::vector<
+        asio::executor_work_guard<asio::io_context::executor_type>>{};
+    for (auto& w : workers_) {
+      guards.emplace_back(asio::make_work_guard(w.ioc_));
+    }
+    auto threads = std::vector<std::thread>{};
+    for (auto& w : workers_) {
+      threads.emplace_back([&w]() { w.ioc_.run(); });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  void stop() {
+    for (auto& w : workers_) {
+      w.ioc_.stop();
+    }
+  }
+
+  void accept();
+
+  void handle(worker&,
+              http::request<http::string_body> const&,
+              http::response<http::string_body>&);
+
+  adr::index_handle& index_;
+  server_config config_;
+  adr::query_metrics metrics_;
+  std::vector<worker> workers_;
+  std::size_t next_worker_{0U};
+  tcp::acceptor acceptor_;
+};
+
+// Keep-alive connection. Requests are read one after another from the same
+// buffer, so pipelined requests are answered in order. The response (and
+// its body capacity) is reused for all requests of the connection.
+struct session : public std::enable_shared_from_this<session> {
+  session(tcp::socket&& socket, server& s, worker& w)
+      : stream_{std::move(socket)}, server_{s}, worker_{w} {}
+
+  void read() {
+    req_ = {};
+    stream_.expires_after(kIdleTimeout);
+    http::async_read(stream_, buf_, req_,
+                     [self = shared_from_this()](beast::error_code const ec,
+                                                 std::size_t) {
+                       self->on_read(ec);
+                     });
+  }
+
+  void on_read(beast::error_code const ec) {
+    if (ec == http::error::end_of_stream) {
+      auto ignore = beast::error_code{};
+      stream_.socket().shutdown(tcp::socket::shutdown_send, ignore);
+      return;
+    }
+    if (ec) {
+      return;
+    }
+
+    server_.handle(worker_, req_, res_);
+    res_.keep_alive(req_.keep_alive());
+    res_.prepare_payload();
+    http::async_write(stream_, res_,
+                      [self = shared_from_this()](beast::error_code const e,
+                                                  std::size_t) {
+                        self->on_write(e);
+                      });
+  }
+
+  void on_write(beast::error_code const ec) {
+    if (ec) {
+      return;
+    }
+    if (res_.need_eof()) {
+      auto ignore = beast::error_code{};
+      stream_.socket().shutdown(tcp::socket::shutdown_send, ignore);
+      return;
+    }
+    read();
+  }
+
+  beast::tcp_stream stream_;
+  beast::flat_buffer buf_;
+  http::request<http::string_body> req_;
+  http::response<http::string_body> res_;
+  server& server_;
+  worker& worker_;
+};
+
+void server::accept() {
+  auto& w = workers_[next_worker_++ % workers_.size()];
+  acceptor_.async_accept(
+      w.ioc_, [this, &w](beast::error_code const ec, tcp::socket socket) {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        if (!ec) {
+          socket.set_option(tcp::no_delay{true});
+          auto s = std::make_shared<session>(std::move(socket), *this, w);
+          asio::post(w.ioc_, [s]() { s->read(); });
+        }
+        accept();
+      });
+}
+
+void server::handle(worker& w,
+                    http::request<http::string_body> const& req,
+                    http::response<http::string_body>& res) {
+  auto& body = res.body();
+  body.clear();
+  res.base().clear();
+  res.version(req.version());
+  res.set(http::field::content_type, "application/json");
+
+  auto const target = std::string_view{req.target().data(),
+                                       req.target().size()};
+  auto const path = get_path(target);
+  try {
+    if (req.method() != http::verb::get) {
+      res.result(http::status::method_not_allowed);
+      body = R"({"error":"method not allowed"})";
+      return;
+    }
+
+    auto const g = index_.get();
+    auto const& t = *g->t_;
+
+    auto languages = adr::language_list_t{adr::kDefaultLang};
+    if (auto const lang = get_param(target, "lang"); lang.has_value()) {
+      auto const l = t.resolve_language(*lang);
+      if (l != adr::language_idx_t::invalid()) {
+        languages.push_back(l);
+      }
+    }
+    auto const n = std::min(
+        get_number<unsigned>(target, "n")
+            .value_or(static_cast<unsigned>(config_.n_suggestions_)),
+        kMaxSuggestions);
+    auto const lat = get_number<double>(target, "lat");
+    auto const lng = get_number<double>(target, "lng");
+    auto const coord = lat.has_value() && lng.has_value()
+                           ? std::optional{geo::latlng{*lat, *lng}}
+                           : std::nullopt;
+
+    if (path == "/api/typeahead") {
+      auto q = get_param(target, "q");
+      if (!q.has_value() || q->empty()) {
+        res.result(http::status::bad_request);
+        body = R"({"error":"missing parameter q"})";
+        return;
+      }
+
+      auto filter = adr::filter_type::kNone;
+      if (auto const f = get_param(target, "filter"); f.has_value()) {
+        if (*f == "address") {
+          filter = adr::filter_type::kAddress;
+        } else if (*f == "place") {
+          filter = adr::filter_type::kPlace;
+        }
+      }
+      auto const bias = get_number<float>(target, "bias").value_or(1.0F);
+      auto const budget_us = get_number<std::uint64_t>(target, "budget_us")
+                                 .value_or(config_.budget_us_);
+
+      auto& ctx = w.get_context(g);
+      ctx.geo_candidates_ = config_.geo_candidates_;
+      ctx.prune_candidates_ = config_.prune_candidates_;
+      ctx.limits_ = config_.limits_;
+      ctx.query_metrics_ = &metrics_;
+      ctx.budget_.set_time_limit_us(budget_us);
+      adr::get_suggestions<false>(t, std::move(*q), n, languages, ctx, coord,
+                                  bias, filter);
+      res.result(http::status::ok);
+      if (ctx.profile_.truncated_) {
+        res.set("X-Adr-Truncated", "true");
+      }
+      adr::append_suggestions_json(body, t, languages, ctx.suggestions_);
+    } else if (path == "/api/reverse") {
+      if (!coord.has_value()) {
+        res.result(http::status::bad_request);
+        body = R"({"error":"missing parameter lat/lng"})";
+        return;
+      }
+      auto const suggestions = g->r_.lookup(t, *coord, n);
+      res.result(http::status::ok);
+      adr::append_suggestions_json(body, t, languages, suggestions);
+    } else if (path == "/metrics") {
+      auto out = std::stringstream{};
+      metrics_.print_prometheus(out);
+      res.result(http::status::ok);
+      res.set(http::field::content_type, "text/plain; version=0.0.4");
+      body = out.str();
+    } else {
+      res.result(http::status::not_found);
+      body = R"({"error":"not found"})";
+    }
+  } catch (std::exception const& e) {
+    res.result(http::status::bad_request);
+    body.clear();
+    body.append(R"({"error":)");
+    adr::append_json_string(body, e.what());
+    body.push_back('}');
+  }
+}
+
+void print_latencies(std::string_view name,
+                     std::vector<std::uint64_t>& ns,
+                     double const seconds) {
+  std::sort(begin(ns), end(ns));
+  std::cout << fmt::format(
+      "{:<8} requests={} qps={:.0f} p50={:.1f}us p90={:.1f}us "
+      "p99={:.1f}us max={:.1f}us\n",
+      name, ns.size(), static_cast<double>(ns.size()) / seconds,
+      adr::percentile(ns, 0.5) / 1e3, adr::percentile(ns, 0.9) / 1e3,
+      adr::percentile(ns, 0.99) / 1e3,
+      (ns.empty() ? 0U : ns.back()) / 1e3);
+}
+
+// Load generator: every connection sends its share of the corpus in batches
+// of `pipeline` requests (written back to back, then all responses read).
+// The same queries are then run directly against the library with the same
+// concurrency, the difference is the per request server overhead.
+void run_load(server& s,
+              std::vector<std::string> const& queries,
+              unsigned const connections,
+              unsigned const pipeline,
+              unsigned const runs,
+              std::size_t const n) {
+  auto const port = s.port();
+  auto const targets = [&]() {
+    auto v = std::vector<std::string>{};
+    for (auto const& q : queries) {
+      v.emplace_back(
+          fmt::format("/api/typeahead?q={}&n={}", url_encode(q), n));
+    }
+    return v;
+  }();
+  auto const total = static_cast<std::uint64_t>(targets.size()) * runs;
+
+  auto const measure = [&](auto&& per_thread) {
+    auto next = std::atomic_uint64_t{0U};
+    auto latencies = std::vector<std::vector<std::uint64_t>>(connections);
+    auto threads = std::vector<std::thread>{};
+    auto const start = bench_clock::now();
+    for (auto i = 0U; i != connections; ++i) {
+      threads.emplace_back(
+          [&, i]() { per_thread(next, total, latencies[i]); });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    auto const seconds =
+        std::chrono::duration<double>(bench_clock::now() - start).count();
+    auto merged = std::vector<std::uint64_t>{};
+    for (auto const& l : latencies) {
+      merged.insert(end(merged), begin(l), end(l));
+    }
+    return std::pair{std::move(merged), seconds};
+  };
+
+  auto [http_ns, http_seconds] = measure([&](std::atomic_uint64_t& next,
+                                             std::uint64_t const max,
+                                             std::vector<std::uint64_t>& out) {
+    auto ioc = asio::io_context{};
+    auto stream = beast::tcp_stream{ioc};
+    stream.connect(tcp::endpoint{asio::ip::make_address("127.0.0.1"), port});
+    stream.socket().set_option(tcp::no_delay{true});
+    auto buf = beast::flat_buffer{};
+    auto req = http::request<http::empty_body>{};
+    auto res = http::response<http::string_body>{};
+    req.version(11);
+    req.method(http::verb::get);
+    req.set(http::field::host, "localhost");
+    req.keep_alive(true);
+
+    while (true) {
+      auto const first = next.fetch_add(pipeline);
+      if (first >= max) {
+        break;
+      }
+      auto const last = std::min(first + pipeline, max);
+      auto const start = bench_clock::now();
+      for (auto i = first; i != last; ++i) {
+        req.target(targets[i % targets.size()]);
+        http::write(stream, req);
+      }
+      for (auto i = first; i != last; ++i) {
+        res = {};
+        http::read(stream, buf, res);
+        out.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                bench_clock::now() - start)
+                .count()));
+      }
+    }
+
+    auto ignore = beast::error_code{};
+    stream.socket().shutdown(tcp::socket::shutdown_both, ignore);
+  });
+
+  auto [direct_ns, direct_seconds] = measure(
+      [&](std::atomic_uint64_t& next, std::uint64_t const max,
+          std::vector<std::uint64_t>& out) {
+        auto const g = s.index_.get();
+        auto ctx = g->make_context();
+        ctx.geo_candidates_ = s.config_.geo_candidates_;
+        ctx.prune_candidates_ = s.config_.prune_candidates_;
+        ctx.limits_ = s.config_.limits_;
+        auto const languages = adr::language_list_t{adr::kDefaultLang};
+        for (auto i = next.fetch_add(1U); i < max; i = next.fetch_add(1U)) {
+          auto const start = bench_clock::now();
+          adr::get_suggestions<false>(
+              *g->t_, queries[i % queries.size()],
+              static_cast<unsigned>(n), languages, ctx, std::nullopt, 1.0F);
+          out.push_back(static_cast<std::uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  bench_clock::now() - start)
+                  .count()));
+        }
+      });
+
+  std::cout << "connections=" << connections << " pipeline=" << pipeline
+            << "\n";
+  print_latencies("http", http_ns, http_seconds);
+  print_latencies("direct", direct_ns, direct_seconds);
+  if (!http_ns.empty() && !direct_ns.empty()) {
+    std::cout << fmt::format(
+        "overhead p50={:.1f}us (per request, pipelined latencies include "
+        "queueing behind the batch)\n",
+        (static_cast<double>(adr::percentile(http_ns, 0.5)) -
+         static_cast<double>(adr::percentile(direct_ns, 0.5))) /
+            1e3);
+  }
+}
+
+int main(int ac, char** av) {
+  auto in = fs::path{"adr"};
+  auto host = std::string{"0.0.0.0"};
+  auto port = static_cast<unsigned short>(8080U);
+  auto threads = std::thread::hardware_concurrency();
+  auto config = server_config{};
+  auto cache_size = std::size_t{1000U};
+  auto result_cache_size = std::size_t{0U};
+  auto mmap = false;
+  auto bench = false;
+  auto queries_file = fs::path{"test/darmstadt_queries.txt"};
+  auto connections = 4U;
+  auto pipeline = 1U;
+  auto runs = 10U;
+
+  try {
+    bpo::options_description desc{"Options"};
+    desc.add_options()  //
+        ("help,h", "Help screen")  //
+        ("in,i", bpo::value(&in)->default_value(in), "extract directory")  //
+        ("host", bpo::value(&host)->default_value(host), "listen address")  //
+        ("port,p", bpo::value(&port)->default_value(port),
+         "listen port (0 = any)")  //
+        ("threads,t", bpo::value(&threads)->default_value(threads),
+         "worker threads")  //
+        (",n",
+         bpo::value(&config.n_suggestions_)
+             ->default_value(config.n_suggestions_),
+         "default number of suggestions")  //
+        ("geo", "generate candidates near the bias coordinate first")  //
+        ("mmap", "map t.bin instead of reading it into memory")  //
+        ("adaptive", "adaptive candidate limits (see adr-bench --tune)")  //
+        ("prune", "candidates by dynamic pruning of the bigram postings")  //
+        ("budget-us",
+         bpo::value(&config.budget_us_)->default_value(config.budget_us_),
+         "default typeahead time budget in microseconds (0 or more than one "
+         "hour = unlimited), per request: budget_us=")  //
+        ("cache", bpo::value(&cache_size)->default_value(cache_size),
+         "ngram cache entries")  //
+        ("result-cache",
+         bpo::value(&result_cache_size)->default_value(result_cache_size),
+         "result cache entries (0 = disabled)")  //
+        ("bench",
+         "run the load generator against a local server and the library, "
+         "then exit")  //
+        ("queries,q", bpo::value(&queries_file)->default_value(queries_file),
+         "load generator query corpus (one query per line)")  //
+        ("connections,c", bpo::value(&connections)->default_value(connections),
+         "load generator keep-alive connections")  //
+        ("pipeline", bpo::value(&pipeline)->default_value(pipeline),
+         "load generator requests in flight per connection")  //
+        ("runs,r", bpo::value(&runs)->default_value(runs),
+         "load generator passes over the query corpus");
+
+    auto const parsed_options =
+        bpo::command_line_parser{ac, av}.options(desc).run();
+    auto vm = bpo::variables_map{};
+    bpo::store(parsed_options, vm);
+    bpo::notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << '\n';
+      return 0;
+    }
+    config.geo_candidates_ = vm.count("geo") != 0U;
+    config.prune_candidates_ = vm.count("prune") != 0U;
+    if (vm.count("adaptive") != 0U) {
+      config.limits_ = adr::candidate_limits::adaptive();
+    }
+    mmap = vm.count("mmap") != 0U;
+    bench = vm.count("bench") != 0U;
+  } catch (bpo::error const& ex) {
+    std::cerr << ex.what() << '\n';
+    return 1;
+  }
+
+  if (threads == 0U || connections == 0U || pipeline == 0U) {
+    std::cerr << "threads, connections and pipeline must be > 0\n";
+    return 1;
+  }
+
+  auto index = adr::index_handle{
+      in, {.load_mode_ = mmap ? adr::load_mode::kMmap : adr::load_mode::kRead,
+           .cache_size_ = cache_size,
+           .result_cache_size_ = result_cache_size}};
+  adr::print_stats(*index.get()->t_);
+
+  auto s = server{index, config, threads};
+  try {
+    s.listen(bench ? "127.0.0.1" : host,
+             bench ? static_cast<unsigned short>(0U) : port);
+  } catch (std::exception const& e) {
+    std::cerr << "unable to listen on " << host << ":" << port << ": "
+              << e.what() << "\n";
+    return 1;
+  }
+
+  if (bench) {
+    auto const queries = adr::read_queries(queries_file);
+    auto server_thread = std::thread{[&]() { s.run(); }};
+    run_load(s, queries, connections, pipeline, runs, config.n_suggestions_);
+    s.stop();
+    server_thread.join();
+    return 0;
+  }
+
+  auto signals = asio::signal_set{s.workers_.front().ioc_, SIGINT, SIGTERM};
+  signals.async_wait([&](beast::error_code const, int) { s.stop(); });
+
+  std::cout << "listening on " << host << ":" << s.port() << " with "
+            << threads << " workers\n";
+  s.run();
+}
\ No newline at end of file
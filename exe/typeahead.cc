@@ -18,6 +18,8 @@
 #include "ftxui/util/ref.hpp"  // for Ref
 
 #include "adr/adr.h"
+#include "adr/query_profile.h"
+#include "adr/result_cache.h"
 #include "adr/typeahead.h"
 
 namespace bpo = boost::program_options;
@@ -52,6 +54,13 @@ int main(int ac, char** av) {
   auto warmup = false;
   auto benchmark = false;
   auto dark = false;
+  auto geo = false;
+  auto adaptive = false;
+  auto prune = false;
+  auto result_cache_size = 0U;
+  auto budget_us = 0U;
+  auto mmap = false;
+  auto metrics = false;
   auto lat = 49.8731001322536;
   auto lng = 8.647738878714677;
 
@@ -62,6 +71,18 @@ int main(int ac, char** av) {
         ("verbose,v", "Print debug output")  //
         ("benchmark,b", "parallel benchmark on all threads")  //
         ("dark,d", "dark mode")  //
+        ("geo", "generate candidates near the bias coordinate first")  //
+        ("adaptive", "adaptive candidate limits (see adr-bench --tune)")  //
+        ("prune", "candidates by dynamic pruning of the bigram postings")  //
+        ("mmap", "map t.bin instead of reading it into memory")  //
+        ("metrics", "print Prometheus query metrics at the end")  //
+        ("result-cache",
+         bpo::value<unsigned>(&result_cache_size)
+             ->default_value(result_cache_size),
+         "result cache entries (0 = disabled)")  //
+        ("budget-us", bpo::value(&budget_us)->default_value(budget_us),
+         "time budget per query in microseconds (0 or more than one hour = "
+         "unlimited)")  //
         ("lat", bpo::value<double>(&lat)->default_value(lat), "bias lat")  //
         ("lng", bpo::value<double>(&lng)->default_value(lng), "bias lng")  //
         ("file,f", bpo::value<std::string>(&file)->default_value(file),
@@ -107,12 +128,28 @@ int main(int ac, char** av) {
     if (vm.count("dark")) {
       dark = true;
     }
+    if (vm.count("geo")) {
+      geo = true;
+    }
+    if (vm.count("adaptive")) {
+      adaptive = true;
+    }
+    if (vm.count("prune")) {
+      prune = true;
+    }
+    if (vm.count("mmap")) {
+      mmap = true;
+    }
+    if (vm.count("metrics")) {
+      metrics = true;
+    }
   } catch (bpo::error const& ex) {
     std::cerr << ex.what() << '\n';
     return 1;
   }
 
-  auto const t = adr::read(in);
+  auto const t = adr::read(
+      in, mmap ? adr::load_mode::kMmapPrefault : adr::load_mode::kRead);
   adr::print_stats(*t);
 
   auto lang_indices =
@@ -128,8 +165,31 @@ int main(int ac, char** av) {
   auto const coord = std::optional{geo::latlng{lat, lng}};
 
   auto cache = adr::cache{t->strings_.size(), 1000U};
+  auto result_cache = std::optional<adr::result_cache>{};
+  if (result_cache_size != 0U) {
+    result_cache.emplace(result_cache_size);
+  }
+  auto const result_cache_ptr =
+      result_cache.has_value() ? &*result_cache : nullptr;
+
+  auto query_metrics = adr::query_metrics{};
+  auto const query_metrics_ptr = metrics ? &query_metrics : nullptr;
+  auto const print_metrics = [&]() {
+    if (metrics) {
+      query_metrics.print_prometheus(std::cout);
+    }
+  };
+
   auto ctx = adr::guess_context{cache};
   ctx.resize(*t);
+  ctx.geo_candidates_ = geo;
+  ctx.prune_candidates_ = prune;
+  if (adaptive) {
+    ctx.limits_ = adr::candidate_limits::adaptive();
+  }
+  ctx.result_cache_ = result_cache_ptr;
+  ctx.query_metrics_ = query_metrics_ptr;
+  ctx.budget_.set_time_limit_us(budget_us);
 
   if (warmup) {
     adr::get_suggestions<false>(
@@ -148,13 +208,16 @@ int main(int ac, char** av) {
       adr::get_suggestions<false>(*t, line.to_str(), n, lang_indices, ctx,
                                   coord, 1.0);
       UTL_STOP_TIMING(timer);
-      std::cout << UTL_TIMING_MS(timer) << " ms\n";
+      std::cout << UTL_TIMING_MS(timer) << " ms\t";
+      ctx.profile_.print(std::cout);
+      std::cout << "\n";
     });
+    print_metrics();
     return 0;
   }
 
   if (benchmark) {
-    auto count = std::atomic_uint32_t{0U};
+    auto next = std::atomic_uint32_t{0U};
     auto threads = std::vector<std::thread>{};
     auto const num_threads = std::thread::hardware_concurrency();
 
@@ -163,15 +226,20 @@ int main(int ac, char** av) {
       threads.emplace_back([&]() {
         auto ctx = adr::guess_context{cache};
         ctx.resize(*t);
+        ctx.geo_candidates_ = geo;
+        ctx.prune_candidates_ = prune;
+        if (adaptive) {
+          ctx.limits_ = adr::candidate_limits::adaptive();
+        }
+        ctx.result_cache_ = result_cache_ptr;
+        ctx.query_metrics_ = query_metrics_ptr;
+        ctx.budget_.set_time_limit_us(budget_us);
 
-        while (true) {
+        // fetch_add claims each query index exactly once.
+        for (auto i = next.fetch_add(1U); i < 1'000U; i = next.fetch_add(1U)) {
           adr::get_suggestions<false>(
-              *t, std::string{kAddresses[count % kAddresses.size()]}, n,
+              *t, std::string{kAddresses[i % kAddresses.size()]}, n,
               lang_indices, ctx, coord, 1.0);
-          ++count;
-          if (count > 1'000) {
-            break;
-          }
         }
       });
     }
@@ -179,7 +247,16 @@ int main(int ac, char** av) {
       thread.join();
     }
     UTL_STOP_TIMING(timer);
-    std::cout << UTL_TIMING_MS(timer) << " ms\n";
+    std::cout << UTL_TIMING_MS(timer) << " ms for 1000 queries\n";
+    if (result_cache.has_value()) {
+      auto const stats = result_cache->get_stats();
+      std::cout << "result cache: hits=" << stats.hits_
+                << ", misses=" << stats.misses_
+                << ", inserts=" << stats.inserts_
+                << ", rejected=" << stats.rejected_
+                << ", evictions=" << stats.evictions_ << "\n";
+    }
+    print_metrics();
     return 0;
   }
 
@@ -199,11 +276,14 @@ int main(int ac, char** av) {
       std::cout << ", average=" << (UTL_TIMING_MS(timer) / runs) << " ms";
     }
     std::cout << "\n";
+    ctx.profile_.print(std::cout);
+    std::cout << "\n";
 
     for (auto const& [i, s] : utl::enumerate(ctx.suggestions_)) {
       std::cout << "[" << i << "]\t";
       s.print(std::cout, *t, lang_indices);
     }
+    print_metrics();
     return 0;
   } else {
     using namespace ftxui;
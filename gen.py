@@ -197,6 +197,104 @@ def parse_tag(tag_str: str) -> Tuple[str, str]:
     key, value = tag_str.split('=', 1)
     return key.strip(), value.strip()
 
+def fnv1a(s: str) -> int:
+    """64 bit FNV-1a as computed by cista::hash."""
+    h = 14695981039346656037
+    for c in s.encode('utf-8'):
+        h ^= c
+        h = (h * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def build_rules(condition_entries: List[Dict]) -> List[Dict]:
+    """Flatten entries into rules (one per tag combination) in priority order.
+
+    Conditions are (key, value) pairs, value None = any non-empty value."""
+    rules: List[Dict] = []
+    for entry in condition_entries:
+        for combo in entry['tag_combos']:
+            conditions: List[Tuple[str, Optional[str]]] = []
+            for tag_str in combo:
+                parts = [p.strip() for p in tag_str.split('+')] if '+' in tag_str else [tag_str]
+                for part in parts:
+                    key, value = parse_tag(part)
+                    if not key or not value:
+                        continue
+                    if value == '*' or value.startswith('*'):
+                        conditions.append((key, None))
+                    else:
+                        value_clean = value.replace('*', '')
+                        if value_clean:
+                            conditions.append((key, value_clean))
+            if conditions:
+                rules.append({
+                    'category': entry['enum_name'],
+                    'name_source': entry['name_source'],
+                    'conditions': conditions
+                })
+    return rules
+
+def generate_rule_table(rules: List[Dict]) -> List[str]:
+    """Emit the constexpr rule table."""
+    lines = [f"constexpr std::array<amenity_rule, {len(rules)}> amenity_rules = {{{{"]
+    for rule in rules:
+        conditions = ', '.join(
+            f'{{"{key}", "{value or ""}"}}' for key, value in rule['conditions'])
+        lines.append(
+            f"  {{amenity_category::{rule['category']}, {len(rule['conditions'])}U, "
+            f"{{{{{conditions}}}}}}},  // {rule['name_source']}")
+    lines.append("}};")
+    return lines
+
+def condition_expr(tag_keys: Dict[str, str], conditions) -> str:
+    """C++ expression checking all conditions of a rule."""
+    return ' && '.join(
+        f"!{tag_keys[key]}_.empty()" if value is None
+        else f'{tag_keys[key]}_ == "{value}"sv'
+        for key, value in conditions)
+
+def generate_dispatch(rules: List[Dict], tag_keys: Dict[str, str]) -> List[str]:
+    """Emit the two-level (key, value hash) switch for get_category.
+
+    Every rule is filed under its first key=value condition (or its first
+    key if it only has wildcard conditions) and fully checked there."""
+    wildcard_rules: Dict[str, List[int]] = {}
+    value_rules: Dict[str, Dict[str, List[int]]] = {}
+    for idx, rule in enumerate(rules):
+        primary = next(((k, v) for k, v in rule['conditions'] if v is not None),
+                       rule['conditions'][0])
+        key, value = primary
+        if value is None:
+            wildcard_rules.setdefault(key, []).append(idx)
+        else:
+            value_rules.setdefault(key, {}).setdefault(value, []).append(idx)
+
+    lines: List[str] = []
+    for key in sorted(set(wildcard_rules) | set(value_rules)):
+        var_name = tag_keys[key]
+        lines.append(f"if (!{var_name}_.empty()) {{")
+        for idx in wildcard_rules.get(key, []):
+            lines.append(
+                f"  match({idx}U, {condition_expr(tag_keys, rules[idx]['conditions'])});")
+        values = value_rules.get(key, {})
+        if values:
+            hashes = {}
+            for value in values:
+                h = fnv1a(value)
+                if h in hashes:
+                    raise ValueError(f"hash collision: {key}={value} / {key}={hashes[h]}")
+                hashes[h] = value
+            lines.append(f"  switch (cista::hash({var_name}_)) {{")
+            for value, idxs in values.items():
+                lines.append(f'    case cista::hash("{value}"):')
+                for idx in idxs:
+                    lines.append(
+                        f"      match({idx}U, {condition_expr(tag_keys, rules[idx]['conditions'])});")
+                lines.append("      break;")
+            lines.append("    default: break;")
+            lines.append("  }")
+        lines.append("}")
+    return lines
+
 def generate_cpp_header(entries: List[Dict]) -> str:
     """Generate C++ header file using Jinja2 template, one rule per SVG/icon row."""
     template = Template(
@@ -233,6 +331,36 @@ inline constexpr char const* to_str(amenity_category const cat) {
   return amenity_category_names[static_cast<std::size_t>(cat)];
 }
 
+struct amenity_rule_condition {
+  std::string_view key_;
+  std::string_view value_;  // empty: any non-empty value
+};
+
+struct amenity_rule {
+  amenity_category category_;
+  std::uint8_t n_conditions_;
+  std::array<amenity_rule_condition, {{ max_conditions }}> conditions_;
+};
+
+// Classification rules in priority order: the first matching rule wins.
+{% for line in rule_table %}
+{{ line }}
+{% endfor %}
+
+constexpr auto const kNoAmenityRule = static_cast<std::uint16_t>({{ rule_count }}U);
+
+// True if the key (its cista::hash) is used by the classification rules.
+// Objects without any of these keys are always amenity_category::kNone.
+constexpr bool is_amenity_key(std::uint64_t const key_hash) {
+  switch (key_hash) {
+{% for key in tag_keys %}
+    case cista::hash("{{ key }}"):
+{% endfor %}
+      return true;
+    default: return false;
+  }
+}
+
 struct amenity_tags {
   explicit amenity_tags(osmium::TagList const& tags) {
     using namespace std::string_view_literals;
@@ -247,15 +375,22 @@ struct amenity_tags {
     }
   }
 
+  // Equivalent to checking amenity_rules in order. Each rule is only
+  // checked if the value of its first (key=value) condition matches:
+  // two-level switch on the key (present tags) and the value hash.
   amenity_category get_category() const {
     using namespace std::string_view_literals;
-{% for entry in condition_entries %}
-    // {{ entry.name_source }}
-{% for condition in entry.conditions %}
-    {{ condition }}
-{% endfor %}
+    auto rule = kNoAmenityRule;
+    auto const match = [&](std::uint16_t const r, bool const cond) {
+      if (r < rule && cond) {
+        rule = r;
+      }
+    };
+{% for line in dispatch %}
+    {{ line }}
 {% endfor %}
-    return amenity_category::kNone;
+    return rule == kNoAmenityRule ? amenity_category::kNone
+                                  : amenity_rules[rule].category_;
   }
 
 private:
@@ -301,42 +436,16 @@ private:
         seen_enum_names.add(entry['enum_name'])
         unique_entries.append(entry)
 
-    # Build conditions for each entry
-    for entry in condition_entries:
-        conditions: List[str] = []
-        for combo in entry['tag_combos']:
-            combo_conditions: List[str] = []
-            for tag_str in combo:
-                parts = [p.strip() for p in tag_str.split('+')] if '+' in tag_str else [tag_str]
-                for part in parts:
-                    key, value = parse_tag(part)
-                    if not key:
-                        continue
-                    var_name = tag_keys[key]
-                    if not value:
-                        continue
-                    if value == '*' or value.startswith('*'):
-                        combo_conditions.append(f"!{var_name}_.empty()")
-                    else:
-                        value_clean = value.replace('*', '')
-                        if value_clean:
-                            combo_conditions.append(f'{var_name}_ == "{value_clean}"sv')
-            if combo_conditions:
-                if len(combo_conditions) == 1:
-                    cond_expr = combo_conditions[0]
-                else:
-                    cond_expr = ' && '.join(combo_conditions)
-                conditions.append(
-                    f"if ({cond_expr}) return amenity_category::{entry['enum_name']};"
-                )
-        entry['conditions'] = conditions
+    rules = build_rules(condition_entries)
 
     return template.render(
         unique_entries=unique_entries,
-        condition_entries=condition_entries,
-        sanitize_enum_name=sanitize_enum_name,
         tag_keys=tag_keys,
-        member_vars=member_vars
+        member_vars=member_vars,
+        max_conditions=max(len(r['conditions']) for r in rules),
+        rule_count=len(rules),
+        rule_table=generate_rule_table(rules),
+        dispatch=generate_dispatch(rules, tag_keys)
     )
 
 def main():
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "geo/box.h"
 
+#include "cista/containers/bitvec.h"
 #include "cista/memory_holder.h"
 
 #include "adr/guess_context.h"
@@ -21,11 +24,48 @@ struct token {
   std::uint16_t size_;
 };
 
+// Restricts the places that may be suggested. Either a predicate or a bitset
+// of allowed places (bit i = place_idx_t{i}). The bitset variant avoids the
+// indirect call for every candidate.
+struct place_filter {
+  place_filter() = default;
+
+  explicit place_filter(cista::raw::bitvec const& allowed)
+      : allowed_{&allowed} {}
+
+  template <typename Fn>
+    requires(!std::is_same_v<std::decay_t<Fn>, place_filter> &&
+             std::is_invocable_r_v<bool, Fn, place_idx_t>)
+  place_filter(Fn&& fn) : fn_{std::forward<Fn>(fn)} {}
+
+  std::function<bool(place_idx_t)> fn_;
+  cista::raw::bitvec const* allowed_{nullptr};
+};
+
+// geo_index: also build the geo-partitioned bigram postings required by
+// guess_context::geo_candidates_ (about doubles the bigram index).
 void extract(std::filesystem::path const& in,
              std::filesystem::path const& out,
-             std::filesystem::path const& tmp_dname);
+             std::filesystem::path const& tmp_dname,
+             bool geo_index = false);
+
+// Merges extract directories (e.g. regional shards extracted separately)
+// into one. Strings, languages, timezones, area sets and streets (by name)
+// are deduplicated. Areas and places contained in several inputs are kept
+// once.
+void merge(std::vector<std::filesystem::path> const& in,
+           std::filesystem::path const& out);
+
+enum class load_mode : std::uint8_t {
+  kRead,  // read the whole file into memory
+  kMmap,  // map the file read-only, pages are loaded on first access
+  kMmapPrefault  // map the file read-only and prefault all pages
+};
+
+cista::wrapped<typeahead> read(std::filesystem::path const&,
+                               load_mode = load_mode::kRead);
 
-cista::wrapped<typeahead> read(std::filesystem::path const&);
+void write(std::filesystem::path const&, typeahead const&);
 
 template <bool Debug>
 std::vector<token> get_suggestions(
@@ -37,7 +77,7 @@ std::vector<token> get_suggestions(
     std::optional<geo::latlng> const& coord,
     float bias,
     filter_type filter = filter_type::kNone,
-    std::function<bool(place_idx_t)> const& place_filter = {},
+    place_filter const& allowed_places = {},
     std::optional<geo::box> const& = std::nullopt);
 
 void print_stats(typeahead const&);
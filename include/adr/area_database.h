@@ -2,9 +2,13 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
+#include <utility>
 
 #include "cista/mmap.h"
 
+#include "geo/box.h"
+
 #include "osmium/osm/area.hpp"
 
 #include "adr/types.h"
@@ -21,8 +25,18 @@ struct area_database final {
 
   void lookup(typeahead const&, coordinates, basic_string<area_idx_t>&) const;
   void add_area(area_idx_t, osmium::Area const&);
+
+  // Adds the union of areas from other databases (e.g. the same boundary
+  // from two regional extracts). Identical outer rings are only added once.
+  void add_area(
+      area_idx_t,
+      std::span<std::pair<area_database const*, area_idx_t> const> parts);
+
   bool is_within(coordinates, area_idx_t) const;
 
+  // Bounding box of the outer rings.
+  geo::box get_bounds(area_idx_t) const;
+
   struct impl;
   std::unique_ptr<impl> impl_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cinttypes>
 #include <deque>
@@ -50,6 +51,15 @@ inline ngram_set_t missing_elements(ngram_set_t const& subset,
 }
 
 struct cache {
+  // hits_: counts for the exact bigram set were cached.
+  // partial_hits_: counts of a cached subset were copied and completed.
+  // misses_: counted from scratch.
+  struct stats {
+    std::uint64_t hits_;
+    std::uint64_t partial_hits_;
+    std::uint64_t misses_;
+  };
+
   cache(string_match_count_vector_t::size_type const n_strings,
         std::size_t const max_size)
       : n_strings_{n_strings}, max_size_{max_size} {}
@@ -77,6 +87,7 @@ struct cache {
 
     auto const existing_it = entries_.find(ref);
     if (existing_it != end(entries_)) {
+      ++hits_;
       missing.clear();
       return existing_it->second;
     }
@@ -92,19 +103,29 @@ struct cache {
     }
 
     if (max_it == end(entries_)) {
+      ++misses_;
       missing = ref;
       return std::make_shared<string_match_count_vector_t>(n_strings_);
     } else {
+      ++partial_hits_;
       missing = missing_elements(max_it->first, ref);
       return std::make_shared<string_match_count_vector_t>(*max_it->second);
     }
   }
 
+  stats get_stats() const {
+    return {.hits_ = hits_, .partial_hits_ = partial_hits_, .misses_ = misses_};
+  }
+
   std::mutex mtx_;
   string_match_count_vector_t::size_type n_strings_{0U};
   std::size_t max_size_{0U};
   std::deque<ngram_set_t> insert_order_;
   std::map<ngram_set_t, std::shared_ptr<string_match_count_vector_t>> entries_;
+
+  std::atomic_uint64_t hits_{0U};
+  std::atomic_uint64_t partial_hits_{0U};
+  std::atomic_uint64_t misses_{0U};
 };
 
 }  // namespace adr
\ No newline at end of file
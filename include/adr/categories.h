@@ -637,6 +637,417 @@ inline constexpr char const* to_str(amenity_category const cat) {
   return amenity_category_names[static_cast<std::size_t>(cat)];
 }
 
+struct amenity_rule_condition {
+  std::string_view key_;
+  std::string_view value_;  // empty: any non-empty value
+};
+
+struct amenity_rule {
+  amenity_category category_;
+  std::uint8_t n_conditions_;
+  std::array<amenity_rule_condition, 3> conditions_;
+};
+
+// Classification rules in priority order: the first matching rule wins.
+constexpr std::array<amenity_rule, 345> amenity_rules = {{
+  {amenity_category::kRestaurant14, 1U, {{{"amenity", "restaurant"}}}},  // Restaurant-14
+  {amenity_category::kRestaurant14, 1U, {{{"amenity", "food_court"}}}},  // Restaurant-14
+  {amenity_category::kCafe16, 1U, {{{"amenity", "cafe"}}}},  // Cafe-16
+  {amenity_category::kFastFood16, 1U, {{{"amenity", "fast_food"}}}},  // Fast-food-16
+  {amenity_category::kBar16, 1U, {{{"amenity", "bar"}}}},  // Bar-16
+  {amenity_category::kPub16, 1U, {{{"amenity", "pub"}}}},  // Pub-16
+  {amenity_category::kIceCream14, 1U, {{{"amenity", "ice_cream"}}}},  // Ice-cream-14
+  {amenity_category::kBiergarten16, 1U, {{{"amenity", "biergarten"}}}},  // Biergarten-16
+  {amenity_category::kOutdoorSeating14, 1U, {{{"leisure", "outdoor_seating"}}}},  // Outdoor_seating-14
+  {amenity_category::kArtwork14, 1U, {{{"tourism", "artwork"}}}},  // Artwork-14
+  {amenity_category::kCommunityCentre14, 1U, {{{"amenity", "community_centre"}}}},  // Community_centre-14
+  {amenity_category::kLibrary16, 1U, {{{"amenity", "library"}}}},  // Library-16
+  {amenity_category::kMuseum16, 1U, {{{"tourism", "museum"}}}},  // Museum-16
+  {amenity_category::kTheatre16, 1U, {{{"amenity", "theatre"}}}},  // Theatre-16
+  {amenity_category::kCinema16, 1U, {{{"amenity", "cinema"}}}},  // Cinema-16
+  {amenity_category::kNightclub16, 1U, {{{"amenity", "nightclub"}}}},  // Nightclub-16
+  {amenity_category::kArtsCentre, 1U, {{{"amenity", "arts_centre"}}}},  // Arts_centre
+  {amenity_category::kGallery14, 1U, {{{"tourism", "gallery"}}}},  // Gallery-14
+  {amenity_category::kInternetCafe14, 1U, {{{"amenity", "internet_cafe"}}}},  // Internet_cafe-14
+  {amenity_category::kCasino14, 1U, {{{"amenity", "casino"}}}},  // Casino-14
+  {amenity_category::kPublicBookcase14, 1U, {{{"amenity", "public_bookcase"}}}},  // Public_bookcase-14
+  {amenity_category::kAmusementArcade14, 1U, {{{"leisure", "amusement_arcade"}}}},  // Amusement_arcade-14
+  {amenity_category::kMemorial16, 1U, {{{"historic", "memorial"}}}},  // Memorial-16
+  {amenity_category::kArchaeologicalSite16, 1U, {{{"historic", "archaeological_site"}}}},  // Archaeological-site-16
+  {amenity_category::kCartoShrine, 1U, {{{"historic", "wayside_shrine"}}}},  // Carto_shrine
+  {amenity_category::kMonument16, 1U, {{{"historic", "monument"}}}},  // Monument-16
+  {amenity_category::kCastle14, 1U, {{{"historic", "castle"}}}},  // Castle-14
+  {amenity_category::kPlaque, 2U, {{{"historic", "memorial"}, {"memorial", "plaque"}}}},  // Plaque
+  {amenity_category::kPlaque, 2U, {{{"historic", "memorial"}, {"memorial", "blue_plaque"}}}},  // Plaque
+  {amenity_category::kStatue14, 2U, {{{"historic", "memorial"}, {"memorial", "statue"}}}},  // Statue-14
+  {amenity_category::kStatue14, 2U, {{{"tourism", "artwork"}, {"artwork_type", "statue"}}}},  // Statue-14
+  {amenity_category::kStone14, 2U, {{{"historic", "memorial"}, {"memorial", "stone"}}}},  // Stone-14
+  {amenity_category::kPalace14, 2U, {{{"historic", "castle"}, {"castle_type", "palace"}}}},  // Palace-14
+  {amenity_category::kPalace14, 2U, {{{"historic", "castle"}, {"castle_type", "stately"}}}},  // Palace-14
+  {amenity_category::kFortress14, 2U, {{{"historic", "castle"}, {"castle_type", ""}}}},  // Fortress-14
+  {amenity_category::kHistoricFort, 1U, {{{"historic", "fort"}}}},  // Historic-fort
+  {amenity_category::kBust14, 2U, {{{"historic", "memorial"}, {"memorial", "bust"}}}},  // Bust-14
+  {amenity_category::kBust14, 2U, {{{"tourism", "artwork"}, {"artwork_type", "bust"}}}},  // Bust-14
+  {amenity_category::kCityGate14, 1U, {{{"historic", "city_gate"}}}},  // City-gate-14
+  {amenity_category::kManor14, 1U, {{{"historic", "manor"}}}},  // Manor-14
+  {amenity_category::kManor14, 2U, {{{"historic", "castle"}, {"castle_type", "manor"}}}},  // Manor-14
+  {amenity_category::kObelisk14, 1U, {{{"man_made", "obelisk"}}}},  // Obelisk-14
+  {amenity_category::kPlayground16, 1U, {{{"leisure", "playground"}}}},  // Playground-16
+  {amenity_category::kFitness, 1U, {{{"leisure", "fitness_centre"}}}},  // Fitness
+  {amenity_category::kFitness, 1U, {{{"leisure", "fitness_station"}}}},  // Fitness
+  {amenity_category::kGolfIcon, 1U, {{{"leisure", "golf_course"}}}},  // Golf-icon
+  {amenity_category::kSwimming16, 1U, {{{"leisure", "water_park"}}}},  // Swimming-16
+  {amenity_category::kSwimming16, 1U, {{{"leisure", "swimming_area"}}}},  // Swimming-16
+  {amenity_category::kSwimming16, 2U, {{{"leisure", "sports_centre"}, {"sport", "swimming"}}}},  // Swimming-16
+  {amenity_category::kMassage14, 1U, {{{"shop", "massage"}}}},  // Massage-14
+  {amenity_category::kSauna14, 1U, {{{"leisure", "sauna"}}}},  // Sauna-14
+  {amenity_category::kPublicBath, 1U, {{{"amenity", "public_bath"}}}},  // Public_bath
+  {amenity_category::kMiniatureGolf, 1U, {{{"leisure", "miniature_golf"}}}},  // Miniature_golf
+  {amenity_category::kBeachResort14, 1U, {{{"leisure", "beach_resort"}}}},  // Beach_resort-14
+  {amenity_category::kFishing14, 1U, {{{"leisure", "fishing"}}}},  // Fishing-14
+  {amenity_category::kBowlingAlley14, 1U, {{{"leisure", "bowling_alley"}}}},  // Bowling_alley-14
+  {amenity_category::kDogPark, 1U, {{{"leisure", "dog_park"}}}},  // Dog_park
+  {amenity_category::kLeisureDance, 1U, {{{"leisure", "dance"}}}},  // Leisure-dance
+  {amenity_category::kLeisureGolfPin, 1U, {{{"golf", "pin"}}}},  // Leisure-golf-pin
+  {amenity_category::kToilets16, 1U, {{{"amenity", "toilets"}}}},  // Toilets-16
+  {amenity_category::kRecycling16, 1U, {{{"amenity", "recycling"}}}},  // Recycling-16
+  {amenity_category::kWasteBasket12, 1U, {{{"amenity", "waste_basket"}}}},  // Waste-basket-12
+  {amenity_category::kWasteDisposal14, 1U, {{{"amenity", "waste_disposal"}}}},  // Waste_disposal-14
+  {amenity_category::kExcrementBags14, 2U, {{{"amenity", "vending_machine"}, {"vending", "excrement_bags"}}}},  // Excrement_bags-14
+  {amenity_category::kBench16, 1U, {{{"amenity", "bench"}}}},  // Bench-16
+  {amenity_category::kShelter14, 1U, {{{"amenity", "shelter"}}}},  // Shelter-14
+  {amenity_category::kDrinkingWater16, 1U, {{{"amenity", "drinking_water"}}}},  // Drinking-water-16
+  {amenity_category::kPicnicSite, 1U, {{{"tourism", "picnic_site"}}}},  // Picnic_site
+  {amenity_category::kFountain14, 1U, {{{"amenity", "fountain"}}}},  // Fountain-14
+  {amenity_category::kCamping16, 1U, {{{"tourism", "camp_site"}}}},  // Camping-16
+  {amenity_category::kTable16, 1U, {{{"leisure", "picnic_table"}}}},  // Table-16
+  {amenity_category::kCaravan16, 1U, {{{"tourism", "caravan_site"}}}},  // Caravan-16
+  {amenity_category::kBbq14, 1U, {{{"amenity", "bbq"}}}},  // Bbq-14
+  {amenity_category::kShower14, 1U, {{{"amenity", "shower"}}}},  // Shower-14
+  {amenity_category::kFirepit, 1U, {{{"leisure", "firepit"}}}},  // Firepit
+  {amenity_category::kBirdHide14, 1U, {{{"leisure", "bird_hide"}}}},  // Bird_hide-14
+  {amenity_category::kGuidepost14, 2U, {{{"tourism", "information"}, {"information", "guidepost"}}}},  // Guidepost-14
+  {amenity_category::kBoard14, 2U, {{{"tourism", "information"}, {"information", "board"}}}},  // Board-14
+  {amenity_category::kMap14, 2U, {{{"tourism", "information"}, {"information", "map"}}}},  // Map-14
+  {amenity_category::kMap14, 2U, {{{"tourism", "information"}, {"information", "tactile_map"}}}},  // Map-14
+  {amenity_category::kOffice14, 2U, {{{"tourism", "information"}, {"information", "office"}}}},  // Office-14
+  {amenity_category::kTerminal14, 2U, {{{"tourism", "information"}, {"information", "terminal"}}}},  // Terminal-14
+  {amenity_category::kAudioguide14, 2U, {{{"tourism", "information"}, {"information", "audioguide"}}}},  // Audioguide-14
+  {amenity_category::kViewpoint16, 1U, {{{"tourism", "viewpoint"}}}},  // Viewpoint-16
+  {amenity_category::kHotel16, 1U, {{{"tourism", "hotel"}}}},  // Hotel-16
+  {amenity_category::kTourismGuestHouse, 1U, {{{"tourism", "guest_house"}}}},  // Tourism_guest_house
+  {amenity_category::kHostel16, 1U, {{{"tourism", "hostel"}}}},  // Hostel-16
+  {amenity_category::kChalet, 1U, {{{"tourism", "chalet"}}}},  // Chalet
+  {amenity_category::kMotel16, 1U, {{{"tourism", "motel"}}}},  // Motel-16
+  {amenity_category::kApartment, 1U, {{{"tourism", "apartment"}}}},  // Apartment
+  {amenity_category::kAlpinehut, 1U, {{{"tourism", "alpine_hut"}}}},  // Alpinehut
+  {amenity_category::kWildernessHut, 1U, {{{"tourism", "wilderness_hut"}}}},  // Wilderness_hut
+  {amenity_category::kBank16, 1U, {{{"amenity", "bank"}}}},  // Bank-16
+  {amenity_category::kAtm14, 1U, {{{"amenity", "atm"}}}},  // Atm-14
+  {amenity_category::kBureauDeChange14, 1U, {{{"amenity", "bureau_de_change"}}}},  // Bureau_de_change-14
+  {amenity_category::kPharmacy14, 1U, {{{"amenity", "pharmacy"}}}},  // Pharmacy-14
+  {amenity_category::kHospital14, 1U, {{{"amenity", "hospital"}}}},  // Hospital-14
+  {amenity_category::kDoctors14, 1U, {{{"amenity", "clinic"}}}},  // Doctors-14
+  {amenity_category::kDoctors14, 1U, {{{"amenity", "doctors"}}}},  // Doctors-14
+  {amenity_category::kDentist14, 1U, {{{"amenity", "dentist"}}}},  // Dentist-14
+  {amenity_category::kVeterinary14, 1U, {{{"amenity", "veterinary"}}}},  // Veterinary-14
+  {amenity_category::kPostBox12, 1U, {{{"amenity", "post_box"}}}},  // Post_box-12
+  {amenity_category::kPostOffice14, 1U, {{{"amenity", "post_office"}}}},  // Post_office-14
+  {amenity_category::kParcelLocker, 1U, {{{"amenity", "parcel_locker"}}}},  // Parcel_locker
+  {amenity_category::kTelephone16, 1U, {{{"amenity", "telephone"}}}},  // Telephone-16
+  {amenity_category::kEmergencyPhone16, 1U, {{{"emergency", "phone"}}}},  // Emergency-phone-16
+  {amenity_category::kParking16, 1U, {{{"amenity", "parking"}}}},  // Parking-16
+  {amenity_category::kParkingSubtle, 2U, {{{"amenity", "parking"}, {"parking", "lane"}}}},  // Parking-subtle
+  {amenity_category::kParkingSubtle, 2U, {{{"amenity", "parking"}, {"parking", "street_side"}}}},  // Parking-subtle
+  {amenity_category::kBusStop12, 1U, {{{"highway", "bus_stop"}}}},  // Bus-stop-12
+  {amenity_category::kFuel16, 1U, {{{"amenity", "fuel"}}}},  // Fuel-16
+  {amenity_category::kParkingBicycle16, 1U, {{{"amenity", "bicycle_parking"}}}},  // Parking-bicycle-16
+  {amenity_category::kRenderingRailwayTramStopMapnik, 1U, {{{"railway", "station"}}}},  // Rendering-railway-tram_stop-mapnik
+  {amenity_category::kRenderingRailwayTramStopMapnik, 1U, {{{"railway", "halt"}}}},  // Rendering-railway-tram_stop-mapnik
+  {amenity_category::kRenderingRailwayTramStopMapnik, 1U, {{{"railway", "tram_stop"}}}},  // Rendering-railway-tram_stop-mapnik
+  {amenity_category::kRenderingRailwayTramStopMapnik, 1U, {{{"aerialway", "station"}}}},  // Rendering-railway-tram_stop-mapnik
+  {amenity_category::kAmenityBusStation, 1U, {{{"amenity", "bus_station"}}}},  // Amenity_bus_station
+  {amenity_category::kHelipad16, 1U, {{{"aeroway", "helipad"}}}},  // Helipad-16
+  {amenity_category::kAerodrome, 1U, {{{"aeroway", "aerodrome"}}}},  // Aerodrome
+  {amenity_category::kRentalBicycle16, 1U, {{{"amenity", "bicycle_rental"}}}},  // Rental-bicycle-16
+  {amenity_category::kTransportSlipway, 1U, {{{"leisure", "slipway"}}}},  // Transport_slipway
+  {amenity_category::kTaxi16, 1U, {{{"amenity", "taxi"}}}},  // Taxi-16
+  {amenity_category::kParkingTickets14, 2U, {{{"amenity", "vending_machine"}, {"vending", "parking_tickets"}}}},  // Parking_tickets-14
+  {amenity_category::kSubwayEntrance12, 1U, {{{"railway", "subway_entrance"}}}},  // Subway-entrance-12
+  {amenity_category::kChargingStation16, 1U, {{{"amenity", "charging_station"}}}},  // Charging_station-16
+  {amenity_category::kElevator12, 1U, {{{"highway", "elevator"}}}},  // Elevator-12
+  {amenity_category::kRentalCar16, 1U, {{{"amenity", "car_rental"}}}},  // Rental-car-16
+  {amenity_category::kParkingEntrance14, 2U, {{{"amenity", "parking_entrance"}, {"parking", "underground"}}}},  // Parking_entrance-14
+  {amenity_category::kPublicTransportTickets14, 2U, {{{"amenity", "vending_machine"}, {"vending", "public_transport_tickets"}}}},  // Public_transport_tickets-14
+  {amenity_category::kFerryIcon, 1U, {{{"amenity", "ferry_terminal"}}}},  // Ferry-icon
+  {amenity_category::kParkingMotorcycle16, 1U, {{{"amenity", "motorcycle_parking"}}}},  // Parking-motorcycle-16
+  {amenity_category::kBicycleRepairStation14, 1U, {{{"amenity", "bicycle_repair_station"}}}},  // Bicycle_repair_station-14
+  {amenity_category::kBoatRental14, 1U, {{{"amenity", "boat_rental"}}}},  // Boat_rental-14
+  {amenity_category::kParkingEntranceMultiStorey14, 2U, {{{"amenity", "parking_entrance"}, {"parking", "multi-storey"}}}},  // Parking_entrance_multi-storey-14
+  {amenity_category::kOneway, 1U, {{{"oneway", "yes"}}}},  // Oneway
+  {amenity_category::kBarrierGate, 1U, {{{"barrier", "gate"}}}},  // Barrier_gate
+  {amenity_category::kTrafficLight16, 1U, {{{"highway", "traffic_signals"}}}},  // Traffic_light-16
+  {amenity_category::kLevelCrossing2, 1U, {{{"railway", "level_crossing"}}}},  // Level_crossing2
+  {amenity_category::kLevelCrossing2, 1U, {{{"railway", "crossing"}}}},  // Level_crossing2
+  {amenity_category::kLevelCrossing, 1U, {{{"railway", "level_crossing"}}}},  // Level_crossing
+  {amenity_category::kLevelCrossing, 1U, {{{"railway", "crossing"}}}},  // Level_crossing
+  {amenity_category::kBarrier, 1U, {{{"barrier", "bollard"}}}},  // Barrier
+  {amenity_category::kBarrier, 1U, {{{"barrier", "block"}}}},  // Barrier
+  {amenity_category::kBarrier, 1U, {{{"barrier", "turnstile"}}}},  // Barrier
+  {amenity_category::kBarrier, 1U, {{{"barrier", "log"}}}},  // Barrier
+  {amenity_category::kLiftgate7, 1U, {{{"barrier", "lift_gate"}}}},  // Liftgate-7
+  {amenity_category::kLiftgate7, 1U, {{{"barrier", "swing_gate"}}}},  // Liftgate-7
+  {amenity_category::kCycleBarrier14, 1U, {{{"barrier", "cycle_barrier"}}}},  // Cycle_barrier-14
+  {amenity_category::kBarrierStile14, 1U, {{{"barrier", "stile"}}}},  // Barrier_stile-14
+  {amenity_category::kHighwayMiniRoundabout, 1U, {{{"highway", "mini_roundabout"}}}},  // Highway_mini_roundabout
+  {amenity_category::kTollBooth, 1U, {{{"barrier", "toll_booth"}}}},  // Toll_booth
+  {amenity_category::kBarrierCattleGrid14, 1U, {{{"barrier", "cattle_grid"}}}},  // Barrier_cattle_grid-14
+  {amenity_category::kKissingGate14, 1U, {{{"barrier", "kissing_gate"}}}},  // Kissing_gate-14
+  {amenity_category::kFullHeightTurnstile14, 1U, {{{"barrier", "full-height_turnstile"}}}},  // Full-height_turnstile-14
+  {amenity_category::kMotorcycleBarrier14, 1U, {{{"barrier", "motorcycle_barrier"}}}},  // Motorcycle_barrier-14
+  {amenity_category::kFord16, 1U, {{{"ford", "yes"}}}},  // Ford-16
+  {amenity_category::kFord16, 1U, {{{"ford", "stepping_stones"}}}},  // Ford-16
+  {amenity_category::kMountainPass8, 1U, {{{"mountain_pass", "yes"}}}},  // Mountain_pass-8
+  {amenity_category::kDamNode, 1U, {{{"waterway", "dam"}}}},  // Dam_node
+  {amenity_category::kWeirNode, 1U, {{{"waterway", "weir"}}}},  // Weir_node
+  {amenity_category::kLockGateNode, 1U, {{{"waterway", "lock_gate"}}}},  // Lock_gate_node
+  {amenity_category::kTurningCircleOnHighwayTrack16, 2U, {{{"highway", "turning_circle"}, {"highway", "track"}}}},  // Turning_circle_on_highway_track-16
+  {amenity_category::kTree16, 1U, {{{"natural", "tree"}}}},  // Tree-16
+  {amenity_category::kPeak8, 1U, {{{"natural", "peak"}}}},  // Peak-8
+  {amenity_category::kSpring14, 1U, {{{"natural", "spring"}}}},  // Spring-14
+  {amenity_category::kCave14, 1U, {{{"natural", "cave_entrance"}}}},  // Cave-14
+  {amenity_category::kWaterfall14, 1U, {{{"waterway", "waterfall"}}}},  // Waterfall-14
+  {amenity_category::kSaddle8, 1U, {{{"natural", "saddle"}}}},  // Saddle-8
+  {amenity_category::kVolcano8, 1U, {{{"natural", "volcano"}}}},  // Volcano-8
+  {amenity_category::kPolice16, 1U, {{{"amenity", "police"}}}},  // Police-16
+  {amenity_category::kTownHall16, 1U, {{{"amenity", "townhall"}}}},  // Town-hall-16
+  {amenity_category::kFireStation16, 1U, {{{"amenity", "fire_station"}}}},  // Fire-station-16
+  {amenity_category::kSocialFacility14, 1U, {{{"amenity", "social_facility"}}}},  // Social_facility-14
+  {amenity_category::kCourthouse16, 1U, {{{"amenity", "courthouse"}}}},  // Courthouse-16
+  {amenity_category::kDiplomatic, 2U, {{{"office", "diplomatic"}, {"diplomatic", "embassy"}}}},  // Diplomatic
+  {amenity_category::kOfficeDiplomaticConsulate, 2U, {{{"office", "diplomatic"}, {"diplomatic", "consulate"}}}},  // Office-diplomatic-consulate
+  {amenity_category::kPrison16, 1U, {{{"amenity", "prison"}}}},  // Prison-16
+  {amenity_category::kChristian16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "christian"}}}},  // Christian-16
+  {amenity_category::kJewish16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "jewish"}}}},  // Jewish-16
+  {amenity_category::kMuslim16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "muslim"}}}},  // Muslim-16
+  {amenity_category::kTaoist16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "taoist"}}}},  // Taoist-16
+  {amenity_category::kHinduist16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "hindu"}}}},  // Hinduist-16
+  {amenity_category::kBuddhist16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "buddhist"}}}},  // Buddhist-16
+  {amenity_category::kShintoist16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "shinto"}}}},  // Shintoist-16
+  {amenity_category::kSikhist16, 2U, {{{"amenity", "place_of_worship"}, {"religion", "sikh"}}}},  // Sikhist-16
+  {amenity_category::kPlaceOfWorship16, 2U, {{{"amenity", "place_of_worship"}, {"religion", ""}}}},  // Place-of-worship-16
+  {amenity_category::kMarketplace14, 1U, {{{"amenity", "marketplace"}}}},  // Marketplace-14
+  {amenity_category::kConvenience14, 1U, {{{"shop", "convenience"}}}},  // Convenience-14
+  {amenity_category::kSupermarket14, 1U, {{{"shop", "supermarket"}}}},  // Supermarket-14
+  {amenity_category::kClothes16, 1U, {{{"shop", "clothes"}}}},  // Clothes-16
+  {amenity_category::kClothes16, 1U, {{{"shop", "fashion"}}}},  // Clothes-16
+  {amenity_category::kHairdresser16, 1U, {{{"shop", "hairdresser"}}}},  // Hairdresser-16
+  {amenity_category::kBakery16, 1U, {{{"shop", "bakery"}}}},  // Bakery-16
+  {amenity_category::kCarRepair14, 1U, {{{"shop", "car_repair"}}}},  // Car_repair-14
+  {amenity_category::kDoityourself16, 1U, {{{"shop", "doityourself"}}}},  // Doityourself-16
+  {amenity_category::kDoityourself16, 1U, {{{"shop", "hardware"}}}},  // Doityourself-16
+  {amenity_category::kPurpleCar, 1U, {{{"shop", "car"}}}},  // Purple-car
+  {amenity_category::kNewsagent14, 1U, {{{"shop", "kiosk"}}}},  // Newsagent-14
+  {amenity_category::kNewsagent14, 1U, {{{"shop", "newsagent"}}}},  // Newsagent-14
+  {amenity_category::kBeauty14, 1U, {{{"shop", "beauty"}}}},  // Beauty-14
+  {amenity_category::kCarWash14, 1U, {{{"amenity", "car_wash"}}}},  // Car_wash-14
+  {amenity_category::kButcher, 1U, {{{"shop", "butcher"}}}},  // Butcher
+  {amenity_category::kAlcohol16, 1U, {{{"shop", "alcohol"}}}},  // Alcohol-16
+  {amenity_category::kAlcohol16, 1U, {{{"shop", "wine"}}}},  // Alcohol-16
+  {amenity_category::kFurniture16, 1U, {{{"shop", "furniture"}}}},  // Furniture-16
+  {amenity_category::kFlorist16, 1U, {{{"shop", "florist"}}}},  // Florist-16
+  {amenity_category::kMobilePhone16, 1U, {{{"shop", "mobile_phone"}}}},  // Mobile-phone-16
+  {amenity_category::kElectronics16, 1U, {{{"shop", "electronics"}}}},  // Electronics-16
+  {amenity_category::kShoes16, 1U, {{{"shop", "shoes"}}}},  // Shoes-16
+  {amenity_category::kCarParts14, 1U, {{{"shop", "car_parts"}}}},  // Car_parts-14
+  {amenity_category::kGreengrocer14, 1U, {{{"shop", "greengrocer"}}}},  // Greengrocer-14
+  {amenity_category::kGreengrocer14, 1U, {{{"shop", "farm"}}}},  // Greengrocer-14
+  {amenity_category::kLaundry14, 1U, {{{"shop", "laundry"}}}},  // Laundry-14
+  {amenity_category::kLaundry14, 1U, {{{"shop", "dry_cleaning"}}}},  // Laundry-14
+  {amenity_category::kOptician16, 1U, {{{"shop", "optician"}}}},  // Optician-16
+  {amenity_category::kJewellery16, 1U, {{{"shop", "jewelry"}}}},  // Jewellery-16
+  {amenity_category::kBooks16, 1U, {{{"shop", "books"}}}},  // Books-16
+  {amenity_category::kGift16, 1U, {{{"shop", "gift"}}}},  // Gift-16
+  {amenity_category::kDepartmentStore16, 1U, {{{"shop", "department_store"}}}},  // Department_store-16
+  {amenity_category::kBicycle16, 1U, {{{"shop", "bicycle"}}}},  // Bicycle-16
+  {amenity_category::kConfectionery14, 1U, {{{"shop", "confectionery"}}}},  // Confectionery-14
+  {amenity_category::kConfectionery14, 1U, {{{"shop", "chocolate"}}}},  // Confectionery-14
+  {amenity_category::kConfectionery14, 1U, {{{"shop", "pastry"}}}},  // Confectionery-14
+  {amenity_category::kVarietyStore14, 1U, {{{"shop", "variety_store"}}}},  // Variety_store-14
+  {amenity_category::kTravelAgency14, 1U, {{{"shop", "travel_agency"}}}},  // Travel_agency-14
+  {amenity_category::kSports14, 1U, {{{"shop", "sports"}}}},  // Sports-14
+  {amenity_category::kChemist14, 1U, {{{"shop", "chemist"}}}},  // Chemist-14
+  {amenity_category::kComputer14, 1U, {{{"shop", "computer"}}}},  // Computer-14
+  {amenity_category::kStationery14, 1U, {{{"shop", "stationery"}}}},  // Stationery-14
+  {amenity_category::kPet16, 1U, {{{"shop", "pet"}}}},  // Pet-16
+  {amenity_category::kBeverages14, 1U, {{{"shop", "beverages"}}}},  // Beverages-14
+  {amenity_category::kPerfumery14, 1U, {{{"shop", "cosmetics"}}}},  // Perfumery-14
+  {amenity_category::kPerfumery14, 1U, {{{"shop", "perfumery"}}}},  // Perfumery-14
+  {amenity_category::kTyres, 1U, {{{"shop", "tyres"}}}},  // Tyres
+  {amenity_category::kShopMotorcycle, 1U, {{{"shop", "motorcycle"}}}},  // Shop_motorcycle
+  {amenity_category::kGardenCentre14, 1U, {{{"shop", "garden_centre"}}}},  // Garden_centre-14
+  {amenity_category::kCopyshop14, 1U, {{{"shop", "copyshop"}}}},  // Copyshop-14
+  {amenity_category::kToys14, 1U, {{{"shop", "toys"}}}},  // Toys-14
+  {amenity_category::kDeli14, 1U, {{{"shop", "deli"}}}},  // Deli-14
+  {amenity_category::kTobacco14, 1U, {{{"shop", "tobacco"}}}},  // Tobacco-14
+  {amenity_category::kSeafood14, 2U, {{{"shop", "seafood"}, {"shop", "fishmonger"}}}},  // Seafood-14
+  {amenity_category::kInteriorDecoration14, 1U, {{{"shop", "interior_decoration"}}}},  // Interior_decoration-14
+  {amenity_category::kTicket14, 1U, {{{"shop", "ticket"}}}},  // Ticket-14
+  {amenity_category::kPhoto14, 1U, {{{"shop", "photo"}}}},  // Photo-14
+  {amenity_category::kPhoto14, 1U, {{{"shop", "photo_studio"}}}},  // Photo-14
+  {amenity_category::kPhoto14, 1U, {{{"shop", "photography"}}}},  // Photo-14
+  {amenity_category::kTrade14, 1U, {{{"shop", "trade"}}}},  // Trade-14
+  {amenity_category::kTrade14, 1U, {{{"shop", "wholesale"}}}},  // Trade-14
+  {amenity_category::kOutdoor14, 1U, {{{"shop", "outdoor"}}}},  // Outdoor-14
+  {amenity_category::kHouseware14, 1U, {{{"shop", "houseware"}}}},  // Houseware-14
+  {amenity_category::kArt14, 1U, {{{"shop", "art"}}}},  // Art-14
+  {amenity_category::kPaint14, 1U, {{{"shop", "paint"}}}},  // Paint-14
+  {amenity_category::kFabric14, 1U, {{{"shop", "fabric"}}}},  // Fabric-14
+  {amenity_category::kBookmaker14, 1U, {{{"shop", "bookmaker"}}}},  // Bookmaker-14
+  {amenity_category::kSecondHand14, 1U, {{{"shop", "second_hand"}}}},  // Second_hand-14
+  {amenity_category::kCharity14, 1U, {{{"shop", "charity"}}}},  // Charity-14
+  {amenity_category::kBed14, 1U, {{{"shop", "bed"}}}},  // Bed-14
+  {amenity_category::kMedicalSupply, 1U, {{{"shop", "medical_supply"}}}},  // Medical_supply
+  {amenity_category::kHifi14, 1U, {{{"shop", "hifi"}}}},  // Hifi-14
+  {amenity_category::kShopMusic, 1U, {{{"shop", "music"}}}},  // Shop_music
+  {amenity_category::kCoffee14, 1U, {{{"shop", "coffee"}}}},  // Coffee-14
+  {amenity_category::kHearingAids, 1U, {{{"shop", "hearing_aids"}}}},  // Hearing-aids
+  {amenity_category::kMusicalInstrument14, 1U, {{{"shop", "musical_instrument"}}}},  // Musical_instrument-14
+  {amenity_category::kTea14, 1U, {{{"shop", "tea"}}}},  // Tea-14
+  {amenity_category::kVideo14, 1U, {{{"shop", "video"}}}},  // Video-14
+  {amenity_category::kBag14, 1U, {{{"shop", "bag"}}}},  // Bag-14
+  {amenity_category::kCarpet14, 1U, {{{"shop", "carpet"}}}},  // Carpet-14
+  {amenity_category::kVideoGames14, 1U, {{{"shop", "video_games"}}}},  // Video_games-14
+  {amenity_category::kVehicleInspection14, 1U, {{{"amenity", "vehicle_inspection"}}}},  // Vehicle_inspection-14
+  {amenity_category::kDairy, 1U, {{{"shop", "dairy"}}}},  // Dairy
+  {amenity_category::kShopOther16, 1U, {{{"shop", ""}}}},  // Shop-other-16
+  {amenity_category::kShopOther16, 1U, {{{"amenity", "driving_school"}}}},  // Shop-other-16
+  {amenity_category::kOffice16, 1U, {{{"office", ""}}}},  // Office-16
+  {amenity_category::kSocialAmenityDarken16, 1U, {{{"amenity", "nursing_home"}}}},  // Social_amenity_darken-16
+  {amenity_category::kSocialAmenityDarken16, 1U, {{{"amenity", "childcare"}}}},  // Social_amenity_darken-16
+  {amenity_category::kStorageTank14, 1U, {{{"man_made", "storage_tank"}}}},  // Storage_tank-14
+  {amenity_category::kStorageTank14, 1U, {{{"man_made", "silo"}}}},  // Storage_tank-14
+  {amenity_category::kTowerFreestanding, 1U, {{{"man_made", "tower"}}}},  // Tower_freestanding
+  {amenity_category::kTowerCantileverCommunication, 2U, {{{"man_made", "tower"}, {"tower:type", "communication"}}}},  // Tower_cantilever_communication
+  {amenity_category::kGeneratorWind14, 3U, {{{"power", "generator"}, {"generator:source", "wind"}, {"generator:method", "wind_turbine"}}}},  // Generator_wind-14
+  {amenity_category::kHuntingStand16, 1U, {{{"amenity", "hunting_stand"}}}},  // Hunting-stand-16
+  {amenity_category::kChristian9, 1U, {{{"historic", "wayside_cross"}}}},  // Christian-9
+  {amenity_category::kChristian9, 1U, {{{"man_made", "cross"}}}},  // Christian-9
+  {amenity_category::kWaterTower16, 1U, {{{"man_made", "water_tower"}}}},  // Water-tower-16
+  {amenity_category::kMastGeneral, 1U, {{{"man_made", "mast"}}}},  // Mast_general
+  {amenity_category::kBunkerOsmcarto, 1U, {{{"military", "bunker"}}}},  // Bunker-osmcarto
+  {amenity_category::kChimney14, 1U, {{{"man_made", "chimney"}}}},  // Chimney-14
+  {amenity_category::kTowerObservation, 2U, {{{"man_made", "tower"}, {"tower:type", "observation"}}}},  // Tower_observation
+  {amenity_category::kTowerObservation, 2U, {{{"man_made", "tower"}, {"tower:type", "watchtower"}}}},  // Tower_observation
+  {amenity_category::kTowerBellTower, 2U, {{{"man_made", "tower"}, {"tower:type", "bell_tower"}}}},  // Tower_bell_tower
+  {amenity_category::kTowerLighting, 2U, {{{"man_made", "tower"}, {"tower:type", "lighting"}}}},  // Tower_lighting
+  {amenity_category::kLighthouse16, 1U, {{{"man_made", "lighthouse"}}}},  // Lighthouse-16
+  {amenity_category::kColumn14, 1U, {{{"advertising", "column"}}}},  // Column-14
+  {amenity_category::kCrane14, 1U, {{{"man_made", "crane"}}}},  // Crane-14
+  {amenity_category::kWindmill16, 1U, {{{"man_made", "windmill"}}}},  // Windmill-16
+  {amenity_category::kTowerLatticeCommunication, 3U, {{{"man_made", "tower"}, {"tower:type", "communication"}, {"tower:construction", "lattice"}}}},  // Tower_lattice_communication
+  {amenity_category::kMastLighting, 2U, {{{"man_made", "mast"}, {"tower:type", "lighting"}}}},  // Mast_lighting
+  {amenity_category::kMastCommunications, 2U, {{{"man_made", "mast"}, {"tower:type", "communication"}}}},  // Mast_communications
+  {amenity_category::kCommunicationTower14, 1U, {{{"man_made", "communications_tower"}}}},  // Communication_tower-14
+  {amenity_category::kTowerDefensive, 2U, {{{"man_made", "tower"}, {"tower:type", "defensive"}}}},  // Tower_defensive
+  {amenity_category::kTowerCooling, 2U, {{{"man_made", "tower"}, {"tower:type", "cooling"}}}},  // Tower_cooling
+  {amenity_category::kTowerLattice, 2U, {{{"man_made", "tower"}, {"tower:construction", "lattice"}}}},  // Tower_lattice
+  {amenity_category::kTowerLatticeLighting, 3U, {{{"man_made", "tower"}, {"tower:type", "lighting"}, {"tower:construction", "lattice"}}}},  // Tower_lattice_lighting
+  {amenity_category::kTowerDish, 2U, {{{"man_made", "tower"}, {"tower:construction", "dish"}}}},  // Tower_dish
+  {amenity_category::kTowerDome, 2U, {{{"man_made", "tower"}, {"tower:construction", "dome"}}}},  // Tower_dome
+  {amenity_category::kTelescopeDish14, 2U, {{{"man_made", "telescope"}, {"telescope:type", "radio"}}}},  // Telescope_dish-14
+  {amenity_category::kTelescopeDome14, 2U, {{{"man_made", "telescope"}, {"telescope:type", "optical"}}}},  // Telescope_dome-14
+  {amenity_category::kPowerTower, 1U, {{{"power", "tower"}}}},  // Power_tower
+  {amenity_category::kPowerPole, 1U, {{{"power", "pole"}}}},  // Power_pole
+  {amenity_category::kPlace6, 1U, {{{"place", "city"}}}},  // Place-6
+  {amenity_category::kPlaceCapital8, 1U, {{{"capital", ""}}}},  // Place-capital-8
+  {amenity_category::kRect, 1U, {{{"entrance", "yes"}}}},  // Rect
+  {amenity_category::kEntranceMain, 1U, {{{"entrance", "main"}}}},  // Entrance_main
+  {amenity_category::kEntrance, 1U, {{{"entrance", "service"}}}},  // Entrance
+  {amenity_category::kRectdiag, 2U, {{{"entrance", ""}, {"access", "no"}}}},  // Rectdiag
+  {amenity_category::kCountry, 1U, {{{"place", "country"}}}},  // country
+  {amenity_category::kState, 1U, {{{"place", "state"}}}},  // state
+  {amenity_category::kRegion, 1U, {{{"place", "region"}}}},  // region
+  {amenity_category::kProvince, 1U, {{{"place", "province"}}}},  // province
+  {amenity_category::kDistrict, 1U, {{{"place", "district"}}}},  // district
+  {amenity_category::kCounty, 1U, {{{"place", "county"}}}},  // county
+  {amenity_category::kSubdistrict, 1U, {{{"place", "subdistrict"}}}},  // subdistrict
+  {amenity_category::kMunicipality, 1U, {{{"place", "municipality"}}}},  // municipality
+  {amenity_category::kCity, 1U, {{{"place", "city"}}}},  // city
+  {amenity_category::kBorough, 1U, {{{"place", "borough"}}}},  // borough
+  {amenity_category::kSuburb, 1U, {{{"place", "suburb"}}}},  // suburb
+  {amenity_category::kQuarter, 1U, {{{"place", "quarter"}}}},  // quarter
+  {amenity_category::kNeighbourhood, 1U, {{{"place", "neighbourhood"}}}},  // neighbourhood
+  {amenity_category::kCityBlock, 1U, {{{"place", "city_block"}}}},  // city_block
+  {amenity_category::kPlot, 1U, {{{"place", "plot"}}}},  // plot
+  {amenity_category::kTown, 1U, {{{"place", "town"}}}},  // town
+  {amenity_category::kVillage, 1U, {{{"place", "village"}}}},  // village
+  {amenity_category::kHamlet, 1U, {{{"place", "hamlet"}}}},  // hamlet
+  {amenity_category::kIsolatedDwelling, 1U, {{{"place", "isolated_dwelling"}}}},  // isolated_dwelling
+  {amenity_category::kFarm, 1U, {{{"place", "farm"}}}},  // farm
+  {amenity_category::kAllotments, 1U, {{{"place", "allotments"}}}},  // allotments
+  {amenity_category::kContinent, 1U, {{{"place", "continent"}}}},  // continent
+  {amenity_category::kArchipelago, 1U, {{{"place", "archipelago"}}}},  // archipelago
+  {amenity_category::kIsland, 1U, {{{"place", "island"}}}},  // island
+  {amenity_category::kIslet, 1U, {{{"place", "islet"}}}},  // islet
+  {amenity_category::kSquare, 1U, {{{"place", "square"}}}},  // square
+  {amenity_category::kLocality, 1U, {{{"place", "locality"}}}},  // locality
+  {amenity_category::kPolder, 1U, {{{"place", "polder"}}}},  // polder
+  {amenity_category::kSea, 1U, {{{"place", "sea"}}}},  // sea
+  {amenity_category::kOcean, 1U, {{{"place", "ocean"}}}},  // ocean
+}};
+
+constexpr auto const kNoAmenityRule = static_cast<std::uint16_t>(345U);
+
+// True if the key (its cista::hash) is used by the classification rules.
+// Objects without any of these keys are always amenity_category::kNone.
+constexpr bool is_amenity_key(std::uint64_t const key_hash) {
+  switch (key_hash) {
+    case cista::hash("access"):
+    case cista::hash("advertising"):
+    case cista::hash("aerialway"):
+    case cista::hash("aeroway"):
+    case cista::hash("amenity"):
+    case cista::hash("artwork_type"):
+    case cista::hash("barrier"):
+    case cista::hash("capital"):
+    case cista::hash("castle_type"):
+    case cista::hash("diplomatic"):
+    case cista::hash("emergency"):
+    case cista::hash("entrance"):
+    case cista::hash("ford"):
+    case cista::hash("generator:method"):
+    case cista::hash("generator:source"):
+    case cista::hash("golf"):
+    case cista::hash("highway"):
+    case cista::hash("historic"):
+    case cista::hash("information"):
+    case cista::hash("leisure"):
+    case cista::hash("man_made"):
+    case cista::hash("memorial"):
+    case cista::hash("military"):
+    case cista::hash("mountain_pass"):
+    case cista::hash("natural"):
+    case cista::hash("office"):
+    case cista::hash("oneway"):
+    case cista::hash("parking"):
+    case cista::hash("place"):
+    case cista::hash("power"):
+    case cista::hash("railway"):
+    case cista::hash("religion"):
+    case cista::hash("shop"):
+    case cista::hash("sport"):
+    case cista::hash("telescope:type"):
+    case cista::hash("tourism"):
+    case cista::hash("tower:construction"):
+    case cista::hash("tower:type"):
+    case cista::hash("vending"):
+    case cista::hash("waterway"):
+      return true;
+    default: return false;
+  }
+}
+
 struct amenity_tags {
   explicit amenity_tags(osmium::TagList const& tags) {
     using namespace std::string_view_literals;
@@ -688,660 +1099,1077 @@ struct amenity_tags {
     }
   }
 
+  // Equivalent to checking amenity_rules in order. Each rule is only
+  // checked if the value of its first (key=value) condition matches:
+  // two-level switch on the key (present tags) and the value hash.
   amenity_category get_category() const {
     using namespace std::string_view_literals;
-    // Restaurant-14
-    if (amenity_ == "restaurant"sv) return amenity_category::kRestaurant14;
-    if (amenity_ == "food_court"sv) return amenity_category::kRestaurant14;
-    // Cafe-16
-    if (amenity_ == "cafe"sv) return amenity_category::kCafe16;
-    // Fast-food-16
-    if (amenity_ == "fast_food"sv) return amenity_category::kFastFood16;
-    // Bar-16
-    if (amenity_ == "bar"sv) return amenity_category::kBar16;
-    // Pub-16
-    if (amenity_ == "pub"sv) return amenity_category::kPub16;
-    // Ice-cream-14
-    if (amenity_ == "ice_cream"sv) return amenity_category::kIceCream14;
-    // Biergarten-16
-    if (amenity_ == "biergarten"sv) return amenity_category::kBiergarten16;
-    // Outdoor_seating-14
-    if (leisure_ == "outdoor_seating"sv) return amenity_category::kOutdoorSeating14;
-    // Artwork-14
-    if (tourism_ == "artwork"sv) return amenity_category::kArtwork14;
-    // Community_centre-14
-    if (amenity_ == "community_centre"sv) return amenity_category::kCommunityCentre14;
-    // Library-16
-    if (amenity_ == "library"sv) return amenity_category::kLibrary16;
-    // Museum-16
-    if (tourism_ == "museum"sv) return amenity_category::kMuseum16;
-    // Theatre-16
-    if (amenity_ == "theatre"sv) return amenity_category::kTheatre16;
-    // Cinema-16
-    if (amenity_ == "cinema"sv) return amenity_category::kCinema16;
-    // Nightclub-16
-    if (amenity_ == "nightclub"sv) return amenity_category::kNightclub16;
-    // Arts_centre
-    if (amenity_ == "arts_centre"sv) return amenity_category::kArtsCentre;
-    // Gallery-14
-    if (tourism_ == "gallery"sv) return amenity_category::kGallery14;
-    // Internet_cafe-14
-    if (amenity_ == "internet_cafe"sv) return amenity_category::kInternetCafe14;
-    // Casino-14
-    if (amenity_ == "casino"sv) return amenity_category::kCasino14;
-    // Public_bookcase-14
-    if (amenity_ == "public_bookcase"sv) return amenity_category::kPublicBookcase14;
-    // Amusement_arcade-14
-    if (leisure_ == "amusement_arcade"sv) return amenity_category::kAmusementArcade14;
-    // Memorial-16
-    if (historic_ == "memorial"sv) return amenity_category::kMemorial16;
-    // Archaeological-site-16
-    if (historic_ == "archaeological_site"sv) return amenity_category::kArchaeologicalSite16;
-    // Carto_shrine
-    if (historic_ == "wayside_shrine"sv) return amenity_category::kCartoShrine;
-    // Monument-16
-    if (historic_ == "monument"sv) return amenity_category::kMonument16;
-    // Castle-14
-    if (historic_ == "castle"sv) return amenity_category::kCastle14;
-    // Plaque
-    if (historic_ == "memorial"sv && memorial_ == "plaque"sv) return amenity_category::kPlaque;
-    if (historic_ == "memorial"sv && memorial_ == "blue_plaque"sv) return amenity_category::kPlaque;
-    // Statue-14
-    if (historic_ == "memorial"sv && memorial_ == "statue"sv) return amenity_category::kStatue14;
-    if (tourism_ == "artwork"sv && artwork_type_ == "statue"sv) return amenity_category::kStatue14;
-    // Stone-14
-    if (historic_ == "memorial"sv && memorial_ == "stone"sv) return amenity_category::kStone14;
-    // Palace-14
-    if (historic_ == "castle"sv && castle_type_ == "palace"sv) return amenity_category::kPalace14;
-    if (historic_ == "castle"sv && castle_type_ == "stately"sv) return amenity_category::kPalace14;
-    // Fortress-14
-    if (historic_ == "castle"sv && !castle_type_.empty()) return amenity_category::kFortress14;
-    // Historic-fort
-    if (historic_ == "fort"sv) return amenity_category::kHistoricFort;
-    // Bust-14
-    if (historic_ == "memorial"sv && memorial_ == "bust"sv) return amenity_category::kBust14;
-    if (tourism_ == "artwork"sv && artwork_type_ == "bust"sv) return amenity_category::kBust14;
-    // City-gate-14
-    if (historic_ == "city_gate"sv) return amenity_category::kCityGate14;
-    // Manor-14
-    if (historic_ == "manor"sv) return amenity_category::kManor14;
-    if (historic_ == "castle"sv && castle_type_ == "manor"sv) return amenity_category::kManor14;
-    // Obelisk-14
-    if (man_made_ == "obelisk"sv) return amenity_category::kObelisk14;
-    // Playground-16
-    if (leisure_ == "playground"sv) return amenity_category::kPlayground16;
-    // Fitness
-    if (leisure_ == "fitness_centre"sv) return amenity_category::kFitness;
-    if (leisure_ == "fitness_station"sv) return amenity_category::kFitness;
-    // Golf-icon
-    if (leisure_ == "golf_course"sv) return amenity_category::kGolfIcon;
-    // Swimming-16
-    if (leisure_ == "water_park"sv) return amenity_category::kSwimming16;
-    if (leisure_ == "swimming_area"sv) return amenity_category::kSwimming16;
-    if (leisure_ == "sports_centre"sv && sport_ == "swimming"sv) return amenity_category::kSwimming16;
-    // Massage-14
-    if (shop_ == "massage"sv) return amenity_category::kMassage14;
-    // Sauna-14
-    if (leisure_ == "sauna"sv) return amenity_category::kSauna14;
-    // Public_bath
-    if (amenity_ == "public_bath"sv) return amenity_category::kPublicBath;
-    // Miniature_golf
-    if (leisure_ == "miniature_golf"sv) return amenity_category::kMiniatureGolf;
-    // Beach_resort-14
-    if (leisure_ == "beach_resort"sv) return amenity_category::kBeachResort14;
-    // Fishing-14
-    if (leisure_ == "fishing"sv) return amenity_category::kFishing14;
-    // Bowling_alley-14
-    if (leisure_ == "bowling_alley"sv) return amenity_category::kBowlingAlley14;
-    // Dog_park
-    if (leisure_ == "dog_park"sv) return amenity_category::kDogPark;
-    // Leisure-dance
-    if (leisure_ == "dance"sv) return amenity_category::kLeisureDance;
-    // Leisure-golf-pin
-    if (golf_ == "pin"sv) return amenity_category::kLeisureGolfPin;
-    // Toilets-16
-    if (amenity_ == "toilets"sv) return amenity_category::kToilets16;
-    // Recycling-16
-    if (amenity_ == "recycling"sv) return amenity_category::kRecycling16;
-    // Waste-basket-12
-    if (amenity_ == "waste_basket"sv) return amenity_category::kWasteBasket12;
-    // Waste_disposal-14
-    if (amenity_ == "waste_disposal"sv) return amenity_category::kWasteDisposal14;
-    // Excrement_bags-14
-    if (amenity_ == "vending_machine"sv && vending_ == "excrement_bags"sv) return amenity_category::kExcrementBags14;
-    // Bench-16
-    if (amenity_ == "bench"sv) return amenity_category::kBench16;
-    // Shelter-14
-    if (amenity_ == "shelter"sv) return amenity_category::kShelter14;
-    // Drinking-water-16
-    if (amenity_ == "drinking_water"sv) return amenity_category::kDrinkingWater16;
-    // Picnic_site
-    if (tourism_ == "picnic_site"sv) return amenity_category::kPicnicSite;
-    // Fountain-14
-    if (amenity_ == "fountain"sv) return amenity_category::kFountain14;
-    // Camping-16
-    if (tourism_ == "camp_site"sv) return amenity_category::kCamping16;
-    // Table-16
-    if (leisure_ == "picnic_table"sv) return amenity_category::kTable16;
-    // Caravan-16
-    if (tourism_ == "caravan_site"sv) return amenity_category::kCaravan16;
-    // Bbq-14
-    if (amenity_ == "bbq"sv) return amenity_category::kBbq14;
-    // Shower-14
-    if (amenity_ == "shower"sv) return amenity_category::kShower14;
-    // Firepit
-    if (leisure_ == "firepit"sv) return amenity_category::kFirepit;
-    // Bird_hide-14
-    if (leisure_ == "bird_hide"sv) return amenity_category::kBirdHide14;
-    // Guidepost-14
-    if (tourism_ == "information"sv && information_ == "guidepost"sv) return amenity_category::kGuidepost14;
-    // Board-14
-    if (tourism_ == "information"sv && information_ == "board"sv) return amenity_category::kBoard14;
-    // Map-14
-    if (tourism_ == "information"sv && information_ == "map"sv) return amenity_category::kMap14;
-    if (tourism_ == "information"sv && information_ == "tactile_map"sv) return amenity_category::kMap14;
-    // Office-14
-    if (tourism_ == "information"sv && information_ == "office"sv) return amenity_category::kOffice14;
-    // Terminal-14
-    if (tourism_ == "information"sv && information_ == "terminal"sv) return amenity_category::kTerminal14;
-    // Audioguide-14
-    if (tourism_ == "information"sv && information_ == "audioguide"sv) return amenity_category::kAudioguide14;
-    // Viewpoint-16
-    if (tourism_ == "viewpoint"sv) return amenity_category::kViewpoint16;
-    // Hotel-16
-    if (tourism_ == "hotel"sv) return amenity_category::kHotel16;
-    // Tourism_guest_house
-    if (tourism_ == "guest_house"sv) return amenity_category::kTourismGuestHouse;
-    // Hostel-16
-    if (tourism_ == "hostel"sv) return amenity_category::kHostel16;
-    // Chalet
-    if (tourism_ == "chalet"sv) return amenity_category::kChalet;
-    // Motel-16
-    if (tourism_ == "motel"sv) return amenity_category::kMotel16;
-    // Apartment
-    if (tourism_ == "apartment"sv) return amenity_category::kApartment;
-    // Alpinehut
-    if (tourism_ == "alpine_hut"sv) return amenity_category::kAlpinehut;
-    // Wilderness_hut
-    if (tourism_ == "wilderness_hut"sv) return amenity_category::kWildernessHut;
-    // Bank-16
-    if (amenity_ == "bank"sv) return amenity_category::kBank16;
-    // Atm-14
-    if (amenity_ == "atm"sv) return amenity_category::kAtm14;
-    // Bureau_de_change-14
-    if (amenity_ == "bureau_de_change"sv) return amenity_category::kBureauDeChange14;
-    // Pharmacy-14
-    if (amenity_ == "pharmacy"sv) return amenity_category::kPharmacy14;
-    // Hospital-14
-    if (amenity_ == "hospital"sv) return amenity_category::kHospital14;
-    // Doctors-14
-    if (amenity_ == "clinic"sv) return amenity_category::kDoctors14;
-    if (amenity_ == "doctors"sv) return amenity_category::kDoctors14;
-    // Dentist-14
-    if (amenity_ == "dentist"sv) return amenity_category::kDentist14;
-    // Veterinary-14
-    if (amenity_ == "veterinary"sv) return amenity_category::kVeterinary14;
-    // Post_box-12
-    if (amenity_ == "post_box"sv) return amenity_category::kPostBox12;
-    // Post_office-14
-    if (amenity_ == "post_office"sv) return amenity_category::kPostOffice14;
-    // Parcel_locker
-    if (amenity_ == "parcel_locker"sv) return amenity_category::kParcelLocker;
-    // Telephone-16
-    if (amenity_ == "telephone"sv) return amenity_category::kTelephone16;
-    // Emergency-phone-16
-    if (emergency_ == "phone"sv) return amenity_category::kEmergencyPhone16;
-    // Parking-16
-    if (amenity_ == "parking"sv) return amenity_category::kParking16;
-    // Parking-subtle
-    if (amenity_ == "parking"sv && parking_ == "lane"sv) return amenity_category::kParkingSubtle;
-    if (amenity_ == "parking"sv && parking_ == "street_side"sv) return amenity_category::kParkingSubtle;
-    // Bus-stop-12
-    if (highway_ == "bus_stop"sv) return amenity_category::kBusStop12;
-    // Fuel-16
-    if (amenity_ == "fuel"sv) return amenity_category::kFuel16;
-    // Parking-bicycle-16
-    if (amenity_ == "bicycle_parking"sv) return amenity_category::kParkingBicycle16;
-    // Rendering-railway-tram_stop-mapnik
-    if (railway_ == "station"sv) return amenity_category::kRenderingRailwayTramStopMapnik;
-    if (railway_ == "halt"sv) return amenity_category::kRenderingRailwayTramStopMapnik;
-    if (railway_ == "tram_stop"sv) return amenity_category::kRenderingRailwayTramStopMapnik;
-    if (aerialway_ == "station"sv) return amenity_category::kRenderingRailwayTramStopMapnik;
-    // Amenity_bus_station
-    if (amenity_ == "bus_station"sv) return amenity_category::kAmenityBusStation;
-    // Helipad-16
-    if (aeroway_ == "helipad"sv) return amenity_category::kHelipad16;
-    // Aerodrome
-    if (aeroway_ == "aerodrome"sv) return amenity_category::kAerodrome;
-    // Rental-bicycle-16
-    if (amenity_ == "bicycle_rental"sv) return amenity_category::kRentalBicycle16;
-    // Transport_slipway
-    if (leisure_ == "slipway"sv) return amenity_category::kTransportSlipway;
-    // Taxi-16
-    if (amenity_ == "taxi"sv) return amenity_category::kTaxi16;
-    // Parking_tickets-14
-    if (amenity_ == "vending_machine"sv && vending_ == "parking_tickets"sv) return amenity_category::kParkingTickets14;
-    // Subway-entrance-12
-    if (railway_ == "subway_entrance"sv) return amenity_category::kSubwayEntrance12;
-    // Charging_station-16
-    if (amenity_ == "charging_station"sv) return amenity_category::kChargingStation16;
-    // Elevator-12
-    if (highway_ == "elevator"sv) return amenity_category::kElevator12;
-    // Rental-car-16
-    if (amenity_ == "car_rental"sv) return amenity_category::kRentalCar16;
-    // Parking_entrance-14
-    if (amenity_ == "parking_entrance"sv && parking_ == "underground"sv) return amenity_category::kParkingEntrance14;
-    // Public_transport_tickets-14
-    if (amenity_ == "vending_machine"sv && vending_ == "public_transport_tickets"sv) return amenity_category::kPublicTransportTickets14;
-    // Ferry-icon
-    if (amenity_ == "ferry_terminal"sv) return amenity_category::kFerryIcon;
-    // Parking-motorcycle-16
-    if (amenity_ == "motorcycle_parking"sv) return amenity_category::kParkingMotorcycle16;
-    // Bicycle_repair_station-14
-    if (amenity_ == "bicycle_repair_station"sv) return amenity_category::kBicycleRepairStation14;
-    // Boat_rental-14
-    if (amenity_ == "boat_rental"sv) return amenity_category::kBoatRental14;
-    // Parking_entrance_multi-storey-14
-    if (amenity_ == "parking_entrance"sv && parking_ == "multi-storey"sv) return amenity_category::kParkingEntranceMultiStorey14;
-    // Oneway
-    if (oneway_ == "yes"sv) return amenity_category::kOneway;
-    // Barrier_gate
-    if (barrier_ == "gate"sv) return amenity_category::kBarrierGate;
-    // Traffic_light-16
-    if (highway_ == "traffic_signals"sv) return amenity_category::kTrafficLight16;
-    // Level_crossing2
-    if (railway_ == "level_crossing"sv) return amenity_category::kLevelCrossing2;
-    if (railway_ == "crossing"sv) return amenity_category::kLevelCrossing2;
-    // Level_crossing
-    if (railway_ == "level_crossing"sv) return amenity_category::kLevelCrossing;
-    if (railway_ == "crossing"sv) return amenity_category::kLevelCrossing;
-    // Barrier
-    if (barrier_ == "bollard"sv) return amenity_category::kBarrier;
-    if (barrier_ == "block"sv) return amenity_category::kBarrier;
-    if (barrier_ == "turnstile"sv) return amenity_category::kBarrier;
-    if (barrier_ == "log"sv) return amenity_category::kBarrier;
-    // Liftgate-7
-    if (barrier_ == "lift_gate"sv) return amenity_category::kLiftgate7;
-    if (barrier_ == "swing_gate"sv) return amenity_category::kLiftgate7;
-    // Cycle_barrier-14
-    if (barrier_ == "cycle_barrier"sv) return amenity_category::kCycleBarrier14;
-    // Barrier_stile-14
-    if (barrier_ == "stile"sv) return amenity_category::kBarrierStile14;
-    // Highway_mini_roundabout
-    if (highway_ == "mini_roundabout"sv) return amenity_category::kHighwayMiniRoundabout;
-    // Toll_booth
-    if (barrier_ == "toll_booth"sv) return amenity_category::kTollBooth;
-    // Barrier_cattle_grid-14
-    if (barrier_ == "cattle_grid"sv) return amenity_category::kBarrierCattleGrid14;
-    // Kissing_gate-14
-    if (barrier_ == "kissing_gate"sv) return amenity_category::kKissingGate14;
-    // Full-height_turnstile-14
-    if (barrier_ == "full-height_turnstile"sv) return amenity_category::kFullHeightTurnstile14;
-    // Motorcycle_barrier-14
-    if (barrier_ == "motorcycle_barrier"sv) return amenity_category::kMotorcycleBarrier14;
-    // Ford-16
-    if (ford_ == "yes"sv) return amenity_category::kFord16;
-    if (ford_ == "stepping_stones"sv) return amenity_category::kFord16;
-    // Mountain_pass-8
-    if (mountain_pass_ == "yes"sv) return amenity_category::kMountainPass8;
-    // Dam_node
-    if (waterway_ == "dam"sv) return amenity_category::kDamNode;
-    // Weir_node
-    if (waterway_ == "weir"sv) return amenity_category::kWeirNode;
-    // Lock_gate_node
-    if (waterway_ == "lock_gate"sv) return amenity_category::kLockGateNode;
-    // Turning_circle_on_highway_track-16
-    if (highway_ == "turning_circle"sv && highway_ == "track"sv) return amenity_category::kTurningCircleOnHighwayTrack16;
-    // Tree-16
-    if (natural_ == "tree"sv) return amenity_category::kTree16;
-    // Peak-8
-    if (natural_ == "peak"sv) return amenity_category::kPeak8;
-    // Spring-14
-    if (natural_ == "spring"sv) return amenity_category::kSpring14;
-    // Cave-14
-    if (natural_ == "cave_entrance"sv) return amenity_category::kCave14;
-    // Waterfall-14
-    if (waterway_ == "waterfall"sv) return amenity_category::kWaterfall14;
-    // Saddle-8
-    if (natural_ == "saddle"sv) return amenity_category::kSaddle8;
-    // Volcano-8
-    if (natural_ == "volcano"sv) return amenity_category::kVolcano8;
-    // Police-16
-    if (amenity_ == "police"sv) return amenity_category::kPolice16;
-    // Town-hall-16
-    if (amenity_ == "townhall"sv) return amenity_category::kTownHall16;
-    // Fire-station-16
-    if (amenity_ == "fire_station"sv) return amenity_category::kFireStation16;
-    // Social_facility-14
-    if (amenity_ == "social_facility"sv) return amenity_category::kSocialFacility14;
-    // Courthouse-16
-    if (amenity_ == "courthouse"sv) return amenity_category::kCourthouse16;
-    // Diplomatic
-    if (office_ == "diplomatic"sv && diplomatic_ == "embassy"sv) return amenity_category::kDiplomatic;
-    // Office-diplomatic-consulate
-    if (office_ == "diplomatic"sv && diplomatic_ == "consulate"sv) return amenity_category::kOfficeDiplomaticConsulate;
-    // Prison-16
-    if (amenity_ == "prison"sv) return amenity_category::kPrison16;
-    // Christian-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "christian"sv) return amenity_category::kChristian16;
-    // Jewish-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "jewish"sv) return amenity_category::kJewish16;
-    // Muslim-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "muslim"sv) return amenity_category::kMuslim16;
-    // Taoist-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "taoist"sv) return amenity_category::kTaoist16;
-    // Hinduist-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "hindu"sv) return amenity_category::kHinduist16;
-    // Buddhist-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "buddhist"sv) return amenity_category::kBuddhist16;
-    // Shintoist-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "shinto"sv) return amenity_category::kShintoist16;
-    // Sikhist-16
-    if (amenity_ == "place_of_worship"sv && religion_ == "sikh"sv) return amenity_category::kSikhist16;
-    // Place-of-worship-16
-    if (amenity_ == "place_of_worship"sv && !religion_.empty()) return amenity_category::kPlaceOfWorship16;
-    // Marketplace-14
-    if (amenity_ == "marketplace"sv) return amenity_category::kMarketplace14;
-    // Convenience-14
-    if (shop_ == "convenience"sv) return amenity_category::kConvenience14;
-    // Supermarket-14
-    if (shop_ == "supermarket"sv) return amenity_category::kSupermarket14;
-    // Clothes-16
-    if (shop_ == "clothes"sv) return amenity_category::kClothes16;
-    if (shop_ == "fashion"sv) return amenity_category::kClothes16;
-    // Hairdresser-16
-    if (shop_ == "hairdresser"sv) return amenity_category::kHairdresser16;
-    // Bakery-16
-    if (shop_ == "bakery"sv) return amenity_category::kBakery16;
-    // Car_repair-14
-    if (shop_ == "car_repair"sv) return amenity_category::kCarRepair14;
-    // Doityourself-16
-    if (shop_ == "doityourself"sv) return amenity_category::kDoityourself16;
-    if (shop_ == "hardware"sv) return amenity_category::kDoityourself16;
-    // Purple-car
-    if (shop_ == "car"sv) return amenity_category::kPurpleCar;
-    // Newsagent-14
-    if (shop_ == "kiosk"sv) return amenity_category::kNewsagent14;
-    if (shop_ == "newsagent"sv) return amenity_category::kNewsagent14;
-    // Beauty-14
-    if (shop_ == "beauty"sv) return amenity_category::kBeauty14;
-    // Car_wash-14
-    if (amenity_ == "car_wash"sv) return amenity_category::kCarWash14;
-    // Butcher
-    if (shop_ == "butcher"sv) return amenity_category::kButcher;
-    // Alcohol-16
-    if (shop_ == "alcohol"sv) return amenity_category::kAlcohol16;
-    if (shop_ == "wine"sv) return amenity_category::kAlcohol16;
-    // Furniture-16
-    if (shop_ == "furniture"sv) return amenity_category::kFurniture16;
-    // Florist-16
-    if (shop_ == "florist"sv) return amenity_category::kFlorist16;
-    // Mobile-phone-16
-    if (shop_ == "mobile_phone"sv) return amenity_category::kMobilePhone16;
-    // Electronics-16
-    if (shop_ == "electronics"sv) return amenity_category::kElectronics16;
-    // Shoes-16
-    if (shop_ == "shoes"sv) return amenity_category::kShoes16;
-    // Car_parts-14
-    if (shop_ == "car_parts"sv) return amenity_category::kCarParts14;
-    // Greengrocer-14
-    if (shop_ == "greengrocer"sv) return amenity_category::kGreengrocer14;
-    if (shop_ == "farm"sv) return amenity_category::kGreengrocer14;
-    // Laundry-14
-    if (shop_ == "laundry"sv) return amenity_category::kLaundry14;
-    if (shop_ == "dry_cleaning"sv) return amenity_category::kLaundry14;
-    // Optician-16
-    if (shop_ == "optician"sv) return amenity_category::kOptician16;
-    // Jewellery-16
-    if (shop_ == "jewelry"sv) return amenity_category::kJewellery16;
-    // Books-16
-    if (shop_ == "books"sv) return amenity_category::kBooks16;
-    // Gift-16
-    if (shop_ == "gift"sv) return amenity_category::kGift16;
-    // Department_store-16
-    if (shop_ == "department_store"sv) return amenity_category::kDepartmentStore16;
-    // Bicycle-16
-    if (shop_ == "bicycle"sv) return amenity_category::kBicycle16;
-    // Confectionery-14
-    if (shop_ == "confectionery"sv) return amenity_category::kConfectionery14;
-    if (shop_ == "chocolate"sv) return amenity_category::kConfectionery14;
-    if (shop_ == "pastry"sv) return amenity_category::kConfectionery14;
-    // Variety_store-14
-    if (shop_ == "variety_store"sv) return amenity_category::kVarietyStore14;
-    // Travel_agency-14
-    if (shop_ == "travel_agency"sv) return amenity_category::kTravelAgency14;
-    // Sports-14
-    if (shop_ == "sports"sv) return amenity_category::kSports14;
-    // Chemist-14
-    if (shop_ == "chemist"sv) return amenity_category::kChemist14;
-    // Computer-14
-    if (shop_ == "computer"sv) return amenity_category::kComputer14;
-    // Stationery-14
-    if (shop_ == "stationery"sv) return amenity_category::kStationery14;
-    // Pet-16
-    if (shop_ == "pet"sv) return amenity_category::kPet16;
-    // Beverages-14
-    if (shop_ == "beverages"sv) return amenity_category::kBeverages14;
-    // Perfumery-14
-    if (shop_ == "cosmetics"sv) return amenity_category::kPerfumery14;
-    if (shop_ == "perfumery"sv) return amenity_category::kPerfumery14;
-    // Tyres
-    if (shop_ == "tyres"sv) return amenity_category::kTyres;
-    // Shop_motorcycle
-    if (shop_ == "motorcycle"sv) return amenity_category::kShopMotorcycle;
-    // Garden_centre-14
-    if (shop_ == "garden_centre"sv) return amenity_category::kGardenCentre14;
-    // Copyshop-14
-    if (shop_ == "copyshop"sv) return amenity_category::kCopyshop14;
-    // Toys-14
-    if (shop_ == "toys"sv) return amenity_category::kToys14;
-    // Deli-14
-    if (shop_ == "deli"sv) return amenity_category::kDeli14;
-    // Tobacco-14
-    if (shop_ == "tobacco"sv) return amenity_category::kTobacco14;
-    // Seafood-14
-    if (shop_ == "seafood"sv && shop_ == "fishmonger"sv) return amenity_category::kSeafood14;
-    // Interior_decoration-14
-    if (shop_ == "interior_decoration"sv) return amenity_category::kInteriorDecoration14;
-    // Ticket-14
-    if (shop_ == "ticket"sv) return amenity_category::kTicket14;
-    // Photo-14
-    if (shop_ == "photo"sv) return amenity_category::kPhoto14;
-    if (shop_ == "photo_studio"sv) return amenity_category::kPhoto14;
-    if (shop_ == "photography"sv) return amenity_category::kPhoto14;
-    // Trade-14
-    if (shop_ == "trade"sv) return amenity_category::kTrade14;
-    if (shop_ == "wholesale"sv) return amenity_category::kTrade14;
-    // Outdoor-14
-    if (shop_ == "outdoor"sv) return amenity_category::kOutdoor14;
-    // Houseware-14
-    if (shop_ == "houseware"sv) return amenity_category::kHouseware14;
-    // Art-14
-    if (shop_ == "art"sv) return amenity_category::kArt14;
-    // Paint-14
-    if (shop_ == "paint"sv) return amenity_category::kPaint14;
-    // Fabric-14
-    if (shop_ == "fabric"sv) return amenity_category::kFabric14;
-    // Bookmaker-14
-    if (shop_ == "bookmaker"sv) return amenity_category::kBookmaker14;
-    // Second_hand-14
-    if (shop_ == "second_hand"sv) return amenity_category::kSecondHand14;
-    // Charity-14
-    if (shop_ == "charity"sv) return amenity_category::kCharity14;
-    // Bed-14
-    if (shop_ == "bed"sv) return amenity_category::kBed14;
-    // Medical_supply
-    if (shop_ == "medical_supply"sv) return amenity_category::kMedicalSupply;
-    // Hifi-14
-    if (shop_ == "hifi"sv) return amenity_category::kHifi14;
-    // Shop_music
-    if (shop_ == "music"sv) return amenity_category::kShopMusic;
-    // Coffee-14
-    if (shop_ == "coffee"sv) return amenity_category::kCoffee14;
-    // Hearing-aids
-    if (shop_ == "hearing_aids"sv) return amenity_category::kHearingAids;
-    // Musical_instrument-14
-    if (shop_ == "musical_instrument"sv) return amenity_category::kMusicalInstrument14;
-    // Tea-14
-    if (shop_ == "tea"sv) return amenity_category::kTea14;
-    // Video-14
-    if (shop_ == "video"sv) return amenity_category::kVideo14;
-    // Bag-14
-    if (shop_ == "bag"sv) return amenity_category::kBag14;
-    // Carpet-14
-    if (shop_ == "carpet"sv) return amenity_category::kCarpet14;
-    // Video_games-14
-    if (shop_ == "video_games"sv) return amenity_category::kVideoGames14;
-    // Vehicle_inspection-14
-    if (amenity_ == "vehicle_inspection"sv) return amenity_category::kVehicleInspection14;
-    // Dairy
-    if (shop_ == "dairy"sv) return amenity_category::kDairy;
-    // Shop-other-16
-    if (!shop_.empty()) return amenity_category::kShopOther16;
-    if (amenity_ == "driving_school"sv) return amenity_category::kShopOther16;
-    // Office-16
-    if (!office_.empty()) return amenity_category::kOffice16;
-    // Social_amenity_darken-16
-    if (amenity_ == "nursing_home"sv) return amenity_category::kSocialAmenityDarken16;
-    if (amenity_ == "childcare"sv) return amenity_category::kSocialAmenityDarken16;
-    // Storage_tank-14
-    if (man_made_ == "storage_tank"sv) return amenity_category::kStorageTank14;
-    if (man_made_ == "silo"sv) return amenity_category::kStorageTank14;
-    // Tower_freestanding
-    if (man_made_ == "tower"sv) return amenity_category::kTowerFreestanding;
-    // Tower_cantilever_communication
-    if (man_made_ == "tower"sv && tower_type_ == "communication"sv) return amenity_category::kTowerCantileverCommunication;
-    // Generator_wind-14
-    if (power_ == "generator"sv && generator_source_ == "wind"sv && generator_method_ == "wind_turbine"sv) return amenity_category::kGeneratorWind14;
-    // Hunting-stand-16
-    if (amenity_ == "hunting_stand"sv) return amenity_category::kHuntingStand16;
-    // Christian-9
-    if (historic_ == "wayside_cross"sv) return amenity_category::kChristian9;
-    if (man_made_ == "cross"sv) return amenity_category::kChristian9;
-    // Water-tower-16
-    if (man_made_ == "water_tower"sv) return amenity_category::kWaterTower16;
-    // Mast_general
-    if (man_made_ == "mast"sv) return amenity_category::kMastGeneral;
-    // Bunker-osmcarto
-    if (military_ == "bunker"sv) return amenity_category::kBunkerOsmcarto;
-    // Chimney-14
-    if (man_made_ == "chimney"sv) return amenity_category::kChimney14;
-    // Tower_observation
-    if (man_made_ == "tower"sv && tower_type_ == "observation"sv) return amenity_category::kTowerObservation;
-    if (man_made_ == "tower"sv && tower_type_ == "watchtower"sv) return amenity_category::kTowerObservation;
-    // Tower_bell_tower
-    if (man_made_ == "tower"sv && tower_type_ == "bell_tower"sv) return amenity_category::kTowerBellTower;
-    // Tower_lighting
-    if (man_made_ == "tower"sv && tower_type_ == "lighting"sv) return amenity_category::kTowerLighting;
-    // Lighthouse-16
-    if (man_made_ == "lighthouse"sv) return amenity_category::kLighthouse16;
-    // Column-14
-    if (advertising_ == "column"sv) return amenity_category::kColumn14;
-    // Crane-14
-    if (man_made_ == "crane"sv) return amenity_category::kCrane14;
-    // Windmill-16
-    if (man_made_ == "windmill"sv) return amenity_category::kWindmill16;
-    // Tower_lattice_communication
-    if (man_made_ == "tower"sv && tower_type_ == "communication"sv && tower_construction_ == "lattice"sv) return amenity_category::kTowerLatticeCommunication;
-    // Mast_lighting
-    if (man_made_ == "mast"sv && tower_type_ == "lighting"sv) return amenity_category::kMastLighting;
-    // Mast_communications
-    if (man_made_ == "mast"sv && tower_type_ == "communication"sv) return amenity_category::kMastCommunications;
-    // Communication_tower-14
-    if (man_made_ == "communications_tower"sv) return amenity_category::kCommunicationTower14;
-    // Tower_defensive
-    if (man_made_ == "tower"sv && tower_type_ == "defensive"sv) return amenity_category::kTowerDefensive;
-    // Tower_cooling
-    if (man_made_ == "tower"sv && tower_type_ == "cooling"sv) return amenity_category::kTowerCooling;
-    // Tower_lattice
-    if (man_made_ == "tower"sv && tower_construction_ == "lattice"sv) return amenity_category::kTowerLattice;
-    // Tower_lattice_lighting
-    if (man_made_ == "tower"sv && tower_type_ == "lighting"sv && tower_construction_ == "lattice"sv) return amenity_category::kTowerLatticeLighting;
-    // Tower_dish
-    if (man_made_ == "tower"sv && tower_construction_ == "dish"sv) return amenity_category::kTowerDish;
-    // Tower_dome
-    if (man_made_ == "tower"sv && tower_construction_ == "dome"sv) return amenity_category::kTowerDome;
-    // Telescope_dish-14
-    if (man_made_ == "telescope"sv && telescope_type_ == "radio"sv) return amenity_category::kTelescopeDish14;
-    // Telescope_dome-14
-    if (man_made_ == "telescope"sv && telescope_type_ == "optical"sv) return amenity_category::kTelescopeDome14;
-    // Power_tower
-    if (power_ == "tower"sv) return amenity_category::kPowerTower;
-    // Power_pole
-    if (power_ == "pole"sv) return amenity_category::kPowerPole;
-    // Place-6
-    if (place_ == "city"sv) return amenity_category::kPlace6;
-    // Place-capital-8
-    if (!capital_.empty()) return amenity_category::kPlaceCapital8;
-    // Rect
-    if (entrance_ == "yes"sv) return amenity_category::kRect;
-    // Entrance_main
-    if (entrance_ == "main"sv) return amenity_category::kEntranceMain;
-    // Entrance
-    if (entrance_ == "service"sv) return amenity_category::kEntrance;
-    // Rectdiag
-    if (!entrance_.empty() && access_ == "no"sv) return amenity_category::kRectdiag;
-    // country
-    if (place_ == "country"sv) return amenity_category::kCountry;
-    // state
-    if (place_ == "state"sv) return amenity_category::kState;
-    // region
-    if (place_ == "region"sv) return amenity_category::kRegion;
-    // province
-    if (place_ == "province"sv) return amenity_category::kProvince;
-    // district
-    if (place_ == "district"sv) return amenity_category::kDistrict;
-    // county
-    if (place_ == "county"sv) return amenity_category::kCounty;
-    // subdistrict
-    if (place_ == "subdistrict"sv) return amenity_category::kSubdistrict;
-    // municipality
-    if (place_ == "municipality"sv) return amenity_category::kMunicipality;
-    // city
-    if (place_ == "city"sv) return amenity_category::kCity;
-    // borough
-    if (place_ == "borough"sv) return amenity_category::kBorough;
-    // suburb
-    if (place_ == "suburb"sv) return amenity_category::kSuburb;
-    // quarter
-    if (place_ == "quarter"sv) return amenity_category::kQuarter;
-    // neighbourhood
-    if (place_ == "neighbourhood"sv) return amenity_category::kNeighbourhood;
-    // city_block
-    if (place_ == "city_block"sv) return amenity_category::kCityBlock;
-    // plot
-    if (place_ == "plot"sv) return amenity_category::kPlot;
-    // town
-    if (place_ == "town"sv) return amenity_category::kTown;
-    // village
-    if (place_ == "village"sv) return amenity_category::kVillage;
-    // hamlet
-    if (place_ == "hamlet"sv) return amenity_category::kHamlet;
-    // isolated_dwelling
-    if (place_ == "isolated_dwelling"sv) return amenity_category::kIsolatedDwelling;
-    // farm
-    if (place_ == "farm"sv) return amenity_category::kFarm;
-    // allotments
-    if (place_ == "allotments"sv) return amenity_category::kAllotments;
-    // continent
-    if (place_ == "continent"sv) return amenity_category::kContinent;
-    // archipelago
-    if (place_ == "archipelago"sv) return amenity_category::kArchipelago;
-    // island
-    if (place_ == "island"sv) return amenity_category::kIsland;
-    // islet
-    if (place_ == "islet"sv) return amenity_category::kIslet;
-    // square
-    if (place_ == "square"sv) return amenity_category::kSquare;
-    // locality
-    if (place_ == "locality"sv) return amenity_category::kLocality;
-    // polder
-    if (place_ == "polder"sv) return amenity_category::kPolder;
-    // sea
-    if (place_ == "sea"sv) return amenity_category::kSea;
-    // ocean
-    if (place_ == "ocean"sv) return amenity_category::kOcean;
-    return amenity_category::kNone;
+    auto rule = kNoAmenityRule;
+    auto const match = [&](std::uint16_t const r, bool const cond) {
+      if (r < rule && cond) {
+        rule = r;
+      }
+    };
+    if (!access_.empty()) {
+      switch (cista::hash(access_)) {
+        case cista::hash("no"):
+          match(314U, !entrance_.empty() && access_ == "no"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!advertising_.empty()) {
+      switch (cista::hash(advertising_)) {
+        case cista::hash("column"):
+          match(292U, advertising_ == "column"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!aerialway_.empty()) {
+      switch (cista::hash(aerialway_)) {
+        case cista::hash("station"):
+          match(115U, aerialway_ == "station"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!aeroway_.empty()) {
+      switch (cista::hash(aeroway_)) {
+        case cista::hash("helipad"):
+          match(117U, aeroway_ == "helipad"sv);
+          break;
+        case cista::hash("aerodrome"):
+          match(118U, aeroway_ == "aerodrome"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!amenity_.empty()) {
+      switch (cista::hash(amenity_)) {
+        case cista::hash("restaurant"):
+          match(0U, amenity_ == "restaurant"sv);
+          break;
+        case cista::hash("food_court"):
+          match(1U, amenity_ == "food_court"sv);
+          break;
+        case cista::hash("cafe"):
+          match(2U, amenity_ == "cafe"sv);
+          break;
+        case cista::hash("fast_food"):
+          match(3U, amenity_ == "fast_food"sv);
+          break;
+        case cista::hash("bar"):
+          match(4U, amenity_ == "bar"sv);
+          break;
+        case cista::hash("pub"):
+          match(5U, amenity_ == "pub"sv);
+          break;
+        case cista::hash("ice_cream"):
+          match(6U, amenity_ == "ice_cream"sv);
+          break;
+        case cista::hash("biergarten"):
+          match(7U, amenity_ == "biergarten"sv);
+          break;
+        case cista::hash("community_centre"):
+          match(10U, amenity_ == "community_centre"sv);
+          break;
+        case cista::hash("library"):
+          match(11U, amenity_ == "library"sv);
+          break;
+        case cista::hash("theatre"):
+          match(13U, amenity_ == "theatre"sv);
+          break;
+        case cista::hash("cinema"):
+          match(14U, amenity_ == "cinema"sv);
+          break;
+        case cista::hash("nightclub"):
+          match(15U, amenity_ == "nightclub"sv);
+          break;
+        case cista::hash("arts_centre"):
+          match(16U, amenity_ == "arts_centre"sv);
+          break;
+        case cista::hash("internet_cafe"):
+          match(18U, amenity_ == "internet_cafe"sv);
+          break;
+        case cista::hash("casino"):
+          match(19U, amenity_ == "casino"sv);
+          break;
+        case cista::hash("public_bookcase"):
+          match(20U, amenity_ == "public_bookcase"sv);
+          break;
+        case cista::hash("public_bath"):
+          match(51U, amenity_ == "public_bath"sv);
+          break;
+        case cista::hash("toilets"):
+          match(59U, amenity_ == "toilets"sv);
+          break;
+        case cista::hash("recycling"):
+          match(60U, amenity_ == "recycling"sv);
+          break;
+        case cista::hash("waste_basket"):
+          match(61U, amenity_ == "waste_basket"sv);
+          break;
+        case cista::hash("waste_disposal"):
+          match(62U, amenity_ == "waste_disposal"sv);
+          break;
+        case cista::hash("vending_machine"):
+          match(63U, amenity_ == "vending_machine"sv && vending_ == "excrement_bags"sv);
+          match(122U, amenity_ == "vending_machine"sv && vending_ == "parking_tickets"sv);
+          match(128U, amenity_ == "vending_machine"sv && vending_ == "public_transport_tickets"sv);
+          break;
+        case cista::hash("bench"):
+          match(64U, amenity_ == "bench"sv);
+          break;
+        case cista::hash("shelter"):
+          match(65U, amenity_ == "shelter"sv);
+          break;
+        case cista::hash("drinking_water"):
+          match(66U, amenity_ == "drinking_water"sv);
+          break;
+        case cista::hash("fountain"):
+          match(68U, amenity_ == "fountain"sv);
+          break;
+        case cista::hash("bbq"):
+          match(72U, amenity_ == "bbq"sv);
+          break;
+        case cista::hash("shower"):
+          match(73U, amenity_ == "shower"sv);
+          break;
+        case cista::hash("bank"):
+          match(92U, amenity_ == "bank"sv);
+          break;
+        case cista::hash("atm"):
+          match(93U, amenity_ == "atm"sv);
+          break;
+        case cista::hash("bureau_de_change"):
+          match(94U, amenity_ == "bureau_de_change"sv);
+          break;
+        case cista::hash("pharmacy"):
+          match(95U, amenity_ == "pharmacy"sv);
+          break;
+        case cista::hash("hospital"):
+          match(96U, amenity_ == "hospital"sv);
+          break;
+        case cista::hash("clinic"):
+          match(97U, amenity_ == "clinic"sv);
+          break;
+        case cista::hash("doctors"):
+          match(98U, amenity_ == "doctors"sv);
+          break;
+        case cista::hash("dentist"):
+          match(99U, amenity_ == "dentist"sv);
+          break;
+        case cista::hash("veterinary"):
+          match(100U, amenity_ == "veterinary"sv);
+          break;
+        case cista::hash("post_box"):
+          match(101U, amenity_ == "post_box"sv);
+          break;
+        case cista::hash("post_office"):
+          match(102U, amenity_ == "post_office"sv);
+          break;
+        case cista::hash("parcel_locker"):
+          match(103U, amenity_ == "parcel_locker"sv);
+          break;
+        case cista::hash("telephone"):
+          match(104U, amenity_ == "telephone"sv);
+          break;
+        case cista::hash("parking"):
+          match(106U, amenity_ == "parking"sv);
+          match(107U, amenity_ == "parking"sv && parking_ == "lane"sv);
+          match(108U, amenity_ == "parking"sv && parking_ == "street_side"sv);
+          break;
+        case cista::hash("fuel"):
+          match(110U, amenity_ == "fuel"sv);
+          break;
+        case cista::hash("bicycle_parking"):
+          match(111U, amenity_ == "bicycle_parking"sv);
+          break;
+        case cista::hash("bus_station"):
+          match(116U, amenity_ == "bus_station"sv);
+          break;
+        case cista::hash("bicycle_rental"):
+          match(119U, amenity_ == "bicycle_rental"sv);
+          break;
+        case cista::hash("taxi"):
+          match(121U, amenity_ == "taxi"sv);
+          break;
+        case cista::hash("charging_station"):
+          match(124U, amenity_ == "charging_station"sv);
+          break;
+        case cista::hash("car_rental"):
+          match(126U, amenity_ == "car_rental"sv);
+          break;
+        case cista::hash("parking_entrance"):
+          match(127U, amenity_ == "parking_entrance"sv && parking_ == "underground"sv);
+          match(133U, amenity_ == "parking_entrance"sv && parking_ == "multi-storey"sv);
+          break;
+        case cista::hash("ferry_terminal"):
+          match(129U, amenity_ == "ferry_terminal"sv);
+          break;
+        case cista::hash("motorcycle_parking"):
+          match(130U, amenity_ == "motorcycle_parking"sv);
+          break;
+        case cista::hash("bicycle_repair_station"):
+          match(131U, amenity_ == "bicycle_repair_station"sv);
+          break;
+        case cista::hash("boat_rental"):
+          match(132U, amenity_ == "boat_rental"sv);
+          break;
+        case cista::hash("police"):
+          match(169U, amenity_ == "police"sv);
+          break;
+        case cista::hash("townhall"):
+          match(170U, amenity_ == "townhall"sv);
+          break;
+        case cista::hash("fire_station"):
+          match(171U, amenity_ == "fire_station"sv);
+          break;
+        case cista::hash("social_facility"):
+          match(172U, amenity_ == "social_facility"sv);
+          break;
+        case cista::hash("courthouse"):
+          match(173U, amenity_ == "courthouse"sv);
+          break;
+        case cista::hash("prison"):
+          match(176U, amenity_ == "prison"sv);
+          break;
+        case cista::hash("place_of_worship"):
+          match(177U, amenity_ == "place_of_worship"sv && religion_ == "christian"sv);
+          match(178U, amenity_ == "place_of_worship"sv && religion_ == "jewish"sv);
+          match(179U, amenity_ == "place_of_worship"sv && religion_ == "muslim"sv);
+          match(180U, amenity_ == "place_of_worship"sv && religion_ == "taoist"sv);
+          match(181U, amenity_ == "place_of_worship"sv && religion_ == "hindu"sv);
+          match(182U, amenity_ == "place_of_worship"sv && religion_ == "buddhist"sv);
+          match(183U, amenity_ == "place_of_worship"sv && religion_ == "shinto"sv);
+          match(184U, amenity_ == "place_of_worship"sv && religion_ == "sikh"sv);
+          match(185U, amenity_ == "place_of_worship"sv && !religion_.empty());
+          break;
+        case cista::hash("marketplace"):
+          match(186U, amenity_ == "marketplace"sv);
+          break;
+        case cista::hash("car_wash"):
+          match(200U, amenity_ == "car_wash"sv);
+          break;
+        case cista::hash("vehicle_inspection"):
+          match(268U, amenity_ == "vehicle_inspection"sv);
+          break;
+        case cista::hash("driving_school"):
+          match(271U, amenity_ == "driving_school"sv);
+          break;
+        case cista::hash("nursing_home"):
+          match(273U, amenity_ == "nursing_home"sv);
+          break;
+        case cista::hash("childcare"):
+          match(274U, amenity_ == "childcare"sv);
+          break;
+        case cista::hash("hunting_stand"):
+          match(280U, amenity_ == "hunting_stand"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!barrier_.empty()) {
+      switch (cista::hash(barrier_)) {
+        case cista::hash("gate"):
+          match(135U, barrier_ == "gate"sv);
+          break;
+        case cista::hash("bollard"):
+          match(141U, barrier_ == "bollard"sv);
+          break;
+        case cista::hash("block"):
+          match(142U, barrier_ == "block"sv);
+          break;
+        case cista::hash("turnstile"):
+          match(143U, barrier_ == "turnstile"sv);
+          break;
+        case cista::hash("log"):
+          match(144U, barrier_ == "log"sv);
+          break;
+        case cista::hash("lift_gate"):
+          match(145U, barrier_ == "lift_gate"sv);
+          break;
+        case cista::hash("swing_gate"):
+          match(146U, barrier_ == "swing_gate"sv);
+          break;
+        case cista::hash("cycle_barrier"):
+          match(147U, barrier_ == "cycle_barrier"sv);
+          break;
+        case cista::hash("stile"):
+          match(148U, barrier_ == "stile"sv);
+          break;
+        case cista::hash("toll_booth"):
+          match(150U, barrier_ == "toll_booth"sv);
+          break;
+        case cista::hash("cattle_grid"):
+          match(151U, barrier_ == "cattle_grid"sv);
+          break;
+        case cista::hash("kissing_gate"):
+          match(152U, barrier_ == "kissing_gate"sv);
+          break;
+        case cista::hash("full-height_turnstile"):
+          match(153U, barrier_ == "full-height_turnstile"sv);
+          break;
+        case cista::hash("motorcycle_barrier"):
+          match(154U, barrier_ == "motorcycle_barrier"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!capital_.empty()) {
+      match(310U, !capital_.empty());
+    }
+    if (!emergency_.empty()) {
+      switch (cista::hash(emergency_)) {
+        case cista::hash("phone"):
+          match(105U, emergency_ == "phone"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!entrance_.empty()) {
+      switch (cista::hash(entrance_)) {
+        case cista::hash("yes"):
+          match(311U, entrance_ == "yes"sv);
+          break;
+        case cista::hash("main"):
+          match(312U, entrance_ == "main"sv);
+          break;
+        case cista::hash("service"):
+          match(313U, entrance_ == "service"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!ford_.empty()) {
+      switch (cista::hash(ford_)) {
+        case cista::hash("yes"):
+          match(155U, ford_ == "yes"sv);
+          break;
+        case cista::hash("stepping_stones"):
+          match(156U, ford_ == "stepping_stones"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!golf_.empty()) {
+      switch (cista::hash(golf_)) {
+        case cista::hash("pin"):
+          match(58U, golf_ == "pin"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!highway_.empty()) {
+      switch (cista::hash(highway_)) {
+        case cista::hash("bus_stop"):
+          match(109U, highway_ == "bus_stop"sv);
+          break;
+        case cista::hash("elevator"):
+          match(125U, highway_ == "elevator"sv);
+          break;
+        case cista::hash("traffic_signals"):
+          match(136U, highway_ == "traffic_signals"sv);
+          break;
+        case cista::hash("mini_roundabout"):
+          match(149U, highway_ == "mini_roundabout"sv);
+          break;
+        case cista::hash("turning_circle"):
+          match(161U, highway_ == "turning_circle"sv && highway_ == "track"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!historic_.empty()) {
+      switch (cista::hash(historic_)) {
+        case cista::hash("memorial"):
+          match(22U, historic_ == "memorial"sv);
+          match(27U, historic_ == "memorial"sv && memorial_ == "plaque"sv);
+          match(28U, historic_ == "memorial"sv && memorial_ == "blue_plaque"sv);
+          match(29U, historic_ == "memorial"sv && memorial_ == "statue"sv);
+          match(31U, historic_ == "memorial"sv && memorial_ == "stone"sv);
+          match(36U, historic_ == "memorial"sv && memorial_ == "bust"sv);
+          break;
+        case cista::hash("archaeological_site"):
+          match(23U, historic_ == "archaeological_site"sv);
+          break;
+        case cista::hash("wayside_shrine"):
+          match(24U, historic_ == "wayside_shrine"sv);
+          break;
+        case cista::hash("monument"):
+          match(25U, historic_ == "monument"sv);
+          break;
+        case cista::hash("castle"):
+          match(26U, historic_ == "castle"sv);
+          match(32U, historic_ == "castle"sv && castle_type_ == "palace"sv);
+          match(33U, historic_ == "castle"sv && castle_type_ == "stately"sv);
+          match(34U, historic_ == "castle"sv && !castle_type_.empty());
+          match(40U, historic_ == "castle"sv && castle_type_ == "manor"sv);
+          break;
+        case cista::hash("fort"):
+          match(35U, historic_ == "fort"sv);
+          break;
+        case cista::hash("city_gate"):
+          match(38U, historic_ == "city_gate"sv);
+          break;
+        case cista::hash("manor"):
+          match(39U, historic_ == "manor"sv);
+          break;
+        case cista::hash("wayside_cross"):
+          match(281U, historic_ == "wayside_cross"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!leisure_.empty()) {
+      switch (cista::hash(leisure_)) {
+        case cista::hash("outdoor_seating"):
+          match(8U, leisure_ == "outdoor_seating"sv);
+          break;
+        case cista::hash("amusement_arcade"):
+          match(21U, leisure_ == "amusement_arcade"sv);
+          break;
+        case cista::hash("playground"):
+          match(42U, leisure_ == "playground"sv);
+          break;
+        case cista::hash("fitness_centre"):
+          match(43U, leisure_ == "fitness_centre"sv);
+          break;
+        case cista::hash("fitness_station"):
+          match(44U, leisure_ == "fitness_station"sv);
+          break;
+        case cista::hash("golf_course"):
+          match(45U, leisure_ == "golf_course"sv);
+          break;
+        case cista::hash("water_park"):
+          match(46U, leisure_ == "water_park"sv);
+          break;
+        case cista::hash("swimming_area"):
+          match(47U, leisure_ == "swimming_area"sv);
+          break;
+        case cista::hash("sports_centre"):
+          match(48U, leisure_ == "sports_centre"sv && sport_ == "swimming"sv);
+          break;
+        case cista::hash("sauna"):
+          match(50U, leisure_ == "sauna"sv);
+          break;
+        case cista::hash("miniature_golf"):
+          match(52U, leisure_ == "miniature_golf"sv);
+          break;
+        case cista::hash("beach_resort"):
+          match(53U, leisure_ == "beach_resort"sv);
+          break;
+        case cista::hash("fishing"):
+          match(54U, leisure_ == "fishing"sv);
+          break;
+        case cista::hash("bowling_alley"):
+          match(55U, leisure_ == "bowling_alley"sv);
+          break;
+        case cista::hash("dog_park"):
+          match(56U, leisure_ == "dog_park"sv);
+          break;
+        case cista::hash("dance"):
+          match(57U, leisure_ == "dance"sv);
+          break;
+        case cista::hash("picnic_table"):
+          match(70U, leisure_ == "picnic_table"sv);
+          break;
+        case cista::hash("firepit"):
+          match(74U, leisure_ == "firepit"sv);
+          break;
+        case cista::hash("bird_hide"):
+          match(75U, leisure_ == "bird_hide"sv);
+          break;
+        case cista::hash("slipway"):
+          match(120U, leisure_ == "slipway"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!man_made_.empty()) {
+      switch (cista::hash(man_made_)) {
+        case cista::hash("obelisk"):
+          match(41U, man_made_ == "obelisk"sv);
+          break;
+        case cista::hash("storage_tank"):
+          match(275U, man_made_ == "storage_tank"sv);
+          break;
+        case cista::hash("silo"):
+          match(276U, man_made_ == "silo"sv);
+          break;
+        case cista::hash("tower"):
+          match(277U, man_made_ == "tower"sv);
+          match(278U, man_made_ == "tower"sv && tower_type_ == "communication"sv);
+          match(287U, man_made_ == "tower"sv && tower_type_ == "observation"sv);
+          match(288U, man_made_ == "tower"sv && tower_type_ == "watchtower"sv);
+          match(289U, man_made_ == "tower"sv && tower_type_ == "bell_tower"sv);
+          match(290U, man_made_ == "tower"sv && tower_type_ == "lighting"sv);
+          match(295U, man_made_ == "tower"sv && tower_type_ == "communication"sv && tower_construction_ == "lattice"sv);
+          match(299U, man_made_ == "tower"sv && tower_type_ == "defensive"sv);
+          match(300U, man_made_ == "tower"sv && tower_type_ == "cooling"sv);
+          match(301U, man_made_ == "tower"sv && tower_construction_ == "lattice"sv);
+          match(302U, man_made_ == "tower"sv && tower_type_ == "lighting"sv && tower_construction_ == "lattice"sv);
+          match(303U, man_made_ == "tower"sv && tower_construction_ == "dish"sv);
+          match(304U, man_made_ == "tower"sv && tower_construction_ == "dome"sv);
+          break;
+        case cista::hash("cross"):
+          match(282U, man_made_ == "cross"sv);
+          break;
+        case cista::hash("water_tower"):
+          match(283U, man_made_ == "water_tower"sv);
+          break;
+        case cista::hash("mast"):
+          match(284U, man_made_ == "mast"sv);
+          match(296U, man_made_ == "mast"sv && tower_type_ == "lighting"sv);
+          match(297U, man_made_ == "mast"sv && tower_type_ == "communication"sv);
+          break;
+        case cista::hash("chimney"):
+          match(286U, man_made_ == "chimney"sv);
+          break;
+        case cista::hash("lighthouse"):
+          match(291U, man_made_ == "lighthouse"sv);
+          break;
+        case cista::hash("crane"):
+          match(293U, man_made_ == "crane"sv);
+          break;
+        case cista::hash("windmill"):
+          match(294U, man_made_ == "windmill"sv);
+          break;
+        case cista::hash("communications_tower"):
+          match(298U, man_made_ == "communications_tower"sv);
+          break;
+        case cista::hash("telescope"):
+          match(305U, man_made_ == "telescope"sv && telescope_type_ == "radio"sv);
+          match(306U, man_made_ == "telescope"sv && telescope_type_ == "optical"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!military_.empty()) {
+      switch (cista::hash(military_)) {
+        case cista::hash("bunker"):
+          match(285U, military_ == "bunker"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!mountain_pass_.empty()) {
+      switch (cista::hash(mountain_pass_)) {
+        case cista::hash("yes"):
+          match(157U, mountain_pass_ == "yes"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!natural_.empty()) {
+      switch (cista::hash(natural_)) {
+        case cista::hash("tree"):
+          match(162U, natural_ == "tree"sv);
+          break;
+        case cista::hash("peak"):
+          match(163U, natural_ == "peak"sv);
+          break;
+        case cista::hash("spring"):
+          match(164U, natural_ == "spring"sv);
+          break;
+        case cista::hash("cave_entrance"):
+          match(165U, natural_ == "cave_entrance"sv);
+          break;
+        case cista::hash("saddle"):
+          match(167U, natural_ == "saddle"sv);
+          break;
+        case cista::hash("volcano"):
+          match(168U, natural_ == "volcano"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!office_.empty()) {
+      match(272U, !office_.empty());
+      switch (cista::hash(office_)) {
+        case cista::hash("diplomatic"):
+          match(174U, office_ == "diplomatic"sv && diplomatic_ == "embassy"sv);
+          match(175U, office_ == "diplomatic"sv && diplomatic_ == "consulate"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!oneway_.empty()) {
+      switch (cista::hash(oneway_)) {
+        case cista::hash("yes"):
+          match(134U, oneway_ == "yes"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!place_.empty()) {
+      switch (cista::hash(place_)) {
+        case cista::hash("city"):
+          match(309U, place_ == "city"sv);
+          match(323U, place_ == "city"sv);
+          break;
+        case cista::hash("country"):
+          match(315U, place_ == "country"sv);
+          break;
+        case cista::hash("state"):
+          match(316U, place_ == "state"sv);
+          break;
+        case cista::hash("region"):
+          match(317U, place_ == "region"sv);
+          break;
+        case cista::hash("province"):
+          match(318U, place_ == "province"sv);
+          break;
+        case cista::hash("district"):
+          match(319U, place_ == "district"sv);
+          break;
+        case cista::hash("county"):
+          match(320U, place_ == "county"sv);
+          break;
+        case cista::hash("subdistrict"):
+          match(321U, place_ == "subdistrict"sv);
+          break;
+        case cista::hash("municipality"):
+          match(322U, place_ == "municipality"sv);
+          break;
+        case cista::hash("borough"):
+          match(324U, place_ == "borough"sv);
+          break;
+        case cista::hash("suburb"):
+          match(325U, place_ == "suburb"sv);
+          break;
+        case cista::hash("quarter"):
+          match(326U, place_ == "quarter"sv);
+          break;
+        case cista::hash("neighbourhood"):
+          match(327U, place_ == "neighbourhood"sv);
+          break;
+        case cista::hash("city_block"):
+          match(328U, place_ == "city_block"sv);
+          break;
+        case cista::hash("plot"):
+          match(329U, place_ == "plot"sv);
+          break;
+        case cista::hash("town"):
+          match(330U, place_ == "town"sv);
+          break;
+        case cista::hash("village"):
+          match(331U, place_ == "village"sv);
+          break;
+        case cista::hash("hamlet"):
+          match(332U, place_ == "hamlet"sv);
+          break;
+        case cista::hash("isolated_dwelling"):
+          match(333U, place_ == "isolated_dwelling"sv);
+          break;
+        case cista::hash("farm"):
+          match(334U, place_ == "farm"sv);
+          break;
+        case cista::hash("allotments"):
+          match(335U, place_ == "allotments"sv);
+          break;
+        case cista::hash("continent"):
+          match(336U, place_ == "continent"sv);
+          break;
+        case cista::hash("archipelago"):
+          match(337U, place_ == "archipelago"sv);
+          break;
+        case cista::hash("island"):
+          match(338U, place_ == "island"sv);
+          break;
+        case cista::hash("islet"):
+          match(339U, place_ == "islet"sv);
+          break;
+        case cista::hash("square"):
+          match(340U, place_ == "square"sv);
+          break;
+        case cista::hash("locality"):
+          match(341U, place_ == "locality"sv);
+          break;
+        case cista::hash("polder"):
+          match(342U, place_ == "polder"sv);
+          break;
+        case cista::hash("sea"):
+          match(343U, place_ == "sea"sv);
+          break;
+        case cista::hash("ocean"):
+          match(344U, place_ == "ocean"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!power_.empty()) {
+      switch (cista::hash(power_)) {
+        case cista::hash("generator"):
+          match(279U, power_ == "generator"sv && generator_source_ == "wind"sv && generator_method_ == "wind_turbine"sv);
+          break;
+        case cista::hash("tower"):
+          match(307U, power_ == "tower"sv);
+          break;
+        case cista::hash("pole"):
+          match(308U, power_ == "pole"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!railway_.empty()) {
+      switch (cista::hash(railway_)) {
+        case cista::hash("station"):
+          match(112U, railway_ == "station"sv);
+          break;
+        case cista::hash("halt"):
+          match(113U, railway_ == "halt"sv);
+          break;
+        case cista::hash("tram_stop"):
+          match(114U, railway_ == "tram_stop"sv);
+          break;
+        case cista::hash("subway_entrance"):
+          match(123U, railway_ == "subway_entrance"sv);
+          break;
+        case cista::hash("level_crossing"):
+          match(137U, railway_ == "level_crossing"sv);
+          match(139U, railway_ == "level_crossing"sv);
+          break;
+        case cista::hash("crossing"):
+          match(138U, railway_ == "crossing"sv);
+          match(140U, railway_ == "crossing"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!shop_.empty()) {
+      match(270U, !shop_.empty());
+      switch (cista::hash(shop_)) {
+        case cista::hash("massage"):
+          match(49U, shop_ == "massage"sv);
+          break;
+        case cista::hash("convenience"):
+          match(187U, shop_ == "convenience"sv);
+          break;
+        case cista::hash("supermarket"):
+          match(188U, shop_ == "supermarket"sv);
+          break;
+        case cista::hash("clothes"):
+          match(189U, shop_ == "clothes"sv);
+          break;
+        case cista::hash("fashion"):
+          match(190U, shop_ == "fashion"sv);
+          break;
+        case cista::hash("hairdresser"):
+          match(191U, shop_ == "hairdresser"sv);
+          break;
+        case cista::hash("bakery"):
+          match(192U, shop_ == "bakery"sv);
+          break;
+        case cista::hash("car_repair"):
+          match(193U, shop_ == "car_repair"sv);
+          break;
+        case cista::hash("doityourself"):
+          match(194U, shop_ == "doityourself"sv);
+          break;
+        case cista::hash("hardware"):
+          match(195U, shop_ == "hardware"sv);
+          break;
+        case cista::hash("car"):
+          match(196U, shop_ == "car"sv);
+          break;
+        case cista::hash("kiosk"):
+          match(197U, shop_ == "kiosk"sv);
+          break;
+        case cista::hash("newsagent"):
+          match(198U, shop_ == "newsagent"sv);
+          break;
+        case cista::hash("beauty"):
+          match(199U, shop_ == "beauty"sv);
+          break;
+        case cista::hash("butcher"):
+          match(201U, shop_ == "butcher"sv);
+          break;
+        case cista::hash("alcohol"):
+          match(202U, shop_ == "alcohol"sv);
+          break;
+        case cista::hash("wine"):
+          match(203U, shop_ == "wine"sv);
+          break;
+        case cista::hash("furniture"):
+          match(204U, shop_ == "furniture"sv);
+          break;
+        case cista::hash("florist"):
+          match(205U, shop_ == "florist"sv);
+          break;
+        case cista::hash("mobile_phone"):
+          match(206U, shop_ == "mobile_phone"sv);
+          break;
+        case cista::hash("electronics"):
+          match(207U, shop_ == "electronics"sv);
+          break;
+        case cista::hash("shoes"):
+          match(208U, shop_ == "shoes"sv);
+          break;
+        case cista::hash("car_parts"):
+          match(209U, shop_ == "car_parts"sv);
+          break;
+        case cista::hash("greengrocer"):
+          match(210U, shop_ == "greengrocer"sv);
+          break;
+        case cista::hash("farm"):
+          match(211U, shop_ == "farm"sv);
+          break;
+        case cista::hash("laundry"):
+          match(212U, shop_ == "laundry"sv);
+          break;
+        case cista::hash("dry_cleaning"):
+          match(213U, shop_ == "dry_cleaning"sv);
+          break;
+        case cista::hash("optician"):
+          match(214U, shop_ == "optician"sv);
+          break;
+        case cista::hash("jewelry"):
+          match(215U, shop_ == "jewelry"sv);
+          break;
+        case cista::hash("books"):
+          match(216U, shop_ == "books"sv);
+          break;
+        case cista::hash("gift"):
+          match(217U, shop_ == "gift"sv);
+          break;
+        case cista::hash("department_store"):
+          match(218U, shop_ == "department_store"sv);
+          break;
+        case cista::hash("bicycle"):
+          match(219U, shop_ == "bicycle"sv);
+          break;
+        case cista::hash("confectionery"):
+          match(220U, shop_ == "confectionery"sv);
+          break;
+        case cista::hash("chocolate"):
+          match(221U, shop_ == "chocolate"sv);
+          break;
+        case cista::hash("pastry"):
+          match(222U, shop_ == "pastry"sv);
+          break;
+        case cista::hash("variety_store"):
+          match(223U, shop_ == "variety_store"sv);
+          break;
+        case cista::hash("travel_agency"):
+          match(224U, shop_ == "travel_agency"sv);
+          break;
+        case cista::hash("sports"):
+          match(225U, shop_ == "sports"sv);
+          break;
+        case cista::hash("chemist"):
+          match(226U, shop_ == "chemist"sv);
+          break;
+        case cista::hash("computer"):
+          match(227U, shop_ == "computer"sv);
+          break;
+        case cista::hash("stationery"):
+          match(228U, shop_ == "stationery"sv);
+          break;
+        case cista::hash("pet"):
+          match(229U, shop_ == "pet"sv);
+          break;
+        case cista::hash("beverages"):
+          match(230U, shop_ == "beverages"sv);
+          break;
+        case cista::hash("cosmetics"):
+          match(231U, shop_ == "cosmetics"sv);
+          break;
+        case cista::hash("perfumery"):
+          match(232U, shop_ == "perfumery"sv);
+          break;
+        case cista::hash("tyres"):
+          match(233U, shop_ == "tyres"sv);
+          break;
+        case cista::hash("motorcycle"):
+          match(234U, shop_ == "motorcycle"sv);
+          break;
+        case cista::hash("garden_centre"):
+          match(235U, shop_ == "garden_centre"sv);
+          break;
+        case cista::hash("copyshop"):
+          match(236U, shop_ == "copyshop"sv);
+          break;
+        case cista::hash("toys"):
+          match(237U, shop_ == "toys"sv);
+          break;
+        case cista::hash("deli"):
+          match(238U, shop_ == "deli"sv);
+          break;
+        case cista::hash("tobacco"):
+          match(239U, shop_ == "tobacco"sv);
+          break;
+        case cista::hash("seafood"):
+          match(240U, shop_ == "seafood"sv && shop_ == "fishmonger"sv);
+          break;
+        case cista::hash("interior_decoration"):
+          match(241U, shop_ == "interior_decoration"sv);
+          break;
+        case cista::hash("ticket"):
+          match(242U, shop_ == "ticket"sv);
+          break;
+        case cista::hash("photo"):
+          match(243U, shop_ == "photo"sv);
+          break;
+        case cista::hash("photo_studio"):
+          match(244U, shop_ == "photo_studio"sv);
+          break;
+        case cista::hash("photography"):
+          match(245U, shop_ == "photography"sv);
+          break;
+        case cista::hash("trade"):
+          match(246U, shop_ == "trade"sv);
+          break;
+        case cista::hash("wholesale"):
+          match(247U, shop_ == "wholesale"sv);
+          break;
+        case cista::hash("outdoor"):
+          match(248U, shop_ == "outdoor"sv);
+          break;
+        case cista::hash("houseware"):
+          match(249U, shop_ == "houseware"sv);
+          break;
+        case cista::hash("art"):
+          match(250U, shop_ == "art"sv);
+          break;
+        case cista::hash("paint"):
+          match(251U, shop_ == "paint"sv);
+          break;
+        case cista::hash("fabric"):
+          match(252U, shop_ == "fabric"sv);
+          break;
+        case cista::hash("bookmaker"):
+          match(253U, shop_ == "bookmaker"sv);
+          break;
+        case cista::hash("second_hand"):
+          match(254U, shop_ == "second_hand"sv);
+          break;
+        case cista::hash("charity"):
+          match(255U, shop_ == "charity"sv);
+          break;
+        case cista::hash("bed"):
+          match(256U, shop_ == "bed"sv);
+          break;
+        case cista::hash("medical_supply"):
+          match(257U, shop_ == "medical_supply"sv);
+          break;
+        case cista::hash("hifi"):
+          match(258U, shop_ == "hifi"sv);
+          break;
+        case cista::hash("music"):
+          match(259U, shop_ == "music"sv);
+          break;
+        case cista::hash("coffee"):
+          match(260U, shop_ == "coffee"sv);
+          break;
+        case cista::hash("hearing_aids"):
+          match(261U, shop_ == "hearing_aids"sv);
+          break;
+        case cista::hash("musical_instrument"):
+          match(262U, shop_ == "musical_instrument"sv);
+          break;
+        case cista::hash("tea"):
+          match(263U, shop_ == "tea"sv);
+          break;
+        case cista::hash("video"):
+          match(264U, shop_ == "video"sv);
+          break;
+        case cista::hash("bag"):
+          match(265U, shop_ == "bag"sv);
+          break;
+        case cista::hash("carpet"):
+          match(266U, shop_ == "carpet"sv);
+          break;
+        case cista::hash("video_games"):
+          match(267U, shop_ == "video_games"sv);
+          break;
+        case cista::hash("dairy"):
+          match(269U, shop_ == "dairy"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!tourism_.empty()) {
+      switch (cista::hash(tourism_)) {
+        case cista::hash("artwork"):
+          match(9U, tourism_ == "artwork"sv);
+          match(30U, tourism_ == "artwork"sv && artwork_type_ == "statue"sv);
+          match(37U, tourism_ == "artwork"sv && artwork_type_ == "bust"sv);
+          break;
+        case cista::hash("museum"):
+          match(12U, tourism_ == "museum"sv);
+          break;
+        case cista::hash("gallery"):
+          match(17U, tourism_ == "gallery"sv);
+          break;
+        case cista::hash("picnic_site"):
+          match(67U, tourism_ == "picnic_site"sv);
+          break;
+        case cista::hash("camp_site"):
+          match(69U, tourism_ == "camp_site"sv);
+          break;
+        case cista::hash("caravan_site"):
+          match(71U, tourism_ == "caravan_site"sv);
+          break;
+        case cista::hash("information"):
+          match(76U, tourism_ == "information"sv && information_ == "guidepost"sv);
+          match(77U, tourism_ == "information"sv && information_ == "board"sv);
+          match(78U, tourism_ == "information"sv && information_ == "map"sv);
+          match(79U, tourism_ == "information"sv && information_ == "tactile_map"sv);
+          match(80U, tourism_ == "information"sv && information_ == "office"sv);
+          match(81U, tourism_ == "information"sv && information_ == "terminal"sv);
+          match(82U, tourism_ == "information"sv && information_ == "audioguide"sv);
+          break;
+        case cista::hash("viewpoint"):
+          match(83U, tourism_ == "viewpoint"sv);
+          break;
+        case cista::hash("hotel"):
+          match(84U, tourism_ == "hotel"sv);
+          break;
+        case cista::hash("guest_house"):
+          match(85U, tourism_ == "guest_house"sv);
+          break;
+        case cista::hash("hostel"):
+          match(86U, tourism_ == "hostel"sv);
+          break;
+        case cista::hash("chalet"):
+          match(87U, tourism_ == "chalet"sv);
+          break;
+        case cista::hash("motel"):
+          match(88U, tourism_ == "motel"sv);
+          break;
+        case cista::hash("apartment"):
+          match(89U, tourism_ == "apartment"sv);
+          break;
+        case cista::hash("alpine_hut"):
+          match(90U, tourism_ == "alpine_hut"sv);
+          break;
+        case cista::hash("wilderness_hut"):
+          match(91U, tourism_ == "wilderness_hut"sv);
+          break;
+        default: break;
+      }
+    }
+    if (!waterway_.empty()) {
+      switch (cista::hash(waterway_)) {
+        case cista::hash("dam"):
+          match(158U, waterway_ == "dam"sv);
+          break;
+        case cista::hash("weir"):
+          match(159U, waterway_ == "weir"sv);
+          break;
+        case cista::hash("lock_gate"):
+          match(160U, waterway_ == "lock_gate"sv);
+          break;
+        case cista::hash("waterfall"):
+          match(166U, waterway_ == "waterfall"sv);
+          break;
+        default: break;
+      }
+    }
+    return rule == kNoAmenityRule ? amenity_category::kNone
+                                  : amenity_rules[rule].category_;
   }
 
 private:
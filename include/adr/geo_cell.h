@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+
+#include "geo/latlng.h"
+
+namespace adr {
+
+using geo_cell_t = std::uint32_t;
+
+// Coarse regular lat/lng grid used to partition posting lists by region.
+constexpr auto const kGeoCellDegrees = 0.5;
+constexpr auto const kGeoCellRows =
+    static_cast<std::int32_t>(180.0 / kGeoCellDegrees);
+constexpr auto const kGeoCellCols =
+    static_cast<std::int32_t>(360.0 / kGeoCellDegrees);
+
+// Strings of globally relevant locations (countries, cities, ...) are indexed
+// in this cell. It is searched regardless of the query location.
+constexpr auto const kGlobalGeoCell = std::numeric_limits<geo_cell_t>::max();
+
+inline std::int32_t geo_cell_row(double const lat) {
+  return std::clamp(
+      static_cast<std::int32_t>(std::floor((lat + 90.0) / kGeoCellDegrees)), 0,
+      kGeoCellRows - 1);
+}
+
+inline std::int32_t geo_cell_col(double const lng) {
+  return std::clamp(
+      static_cast<std::int32_t>(std::floor((lng + 180.0) / kGeoCellDegrees)),
+      0, kGeoCellCols - 1);
+}
+
+inline geo_cell_t to_geo_cell(std::int32_t const row, std::int32_t const col) {
+  auto const wrapped_col = ((col % kGeoCellCols) + kGeoCellCols) % kGeoCellCols;
+  return static_cast<geo_cell_t>(row * kGeoCellCols + wrapped_col);
+}
+
+inline geo_cell_t to_geo_cell(geo::latlng const& x) {
+  return to_geo_cell(geo_cell_row(x.lat()), geo_cell_col(x.lng()));
+}
+
+// Calls fn for every cell within the given Chebyshev cell distance of the cell
+// containing `center` (longitudes wrap around, latitudes are clamped).
+template <typename Fn>
+void for_each_geo_cell(geo::latlng const& center,
+                       std::int32_t const radius,
+                       Fn&& fn) {
+  auto const row = geo_cell_row(center.lat());
+  auto const col = geo_cell_col(center.lng());
+  auto const col_radius = std::min(radius, (kGeoCellCols - 1) / 2);
+  for (auto r = std::max(0, row - radius);
+       r <= std::min(kGeoCellRows - 1, row + radius); ++r) {
+    for (auto c = col - col_radius; c <= col + col_radius; ++c) {
+      fn(to_geo_cell(r, c));
+    }
+  }
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <iosfwd>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <variant>
 #include <vector>
@@ -13,6 +16,9 @@
 #include "adr/cache.h"
 #include "adr/ngram.h"
 #include "adr/normalize.h"
+#include "adr/query_arena.h"
+#include "adr/query_budget.h"
+#include "adr/query_profile.h"
 #include "adr/sift4.h"
 #include "adr/types.h"
 
@@ -20,6 +26,7 @@ namespace adr {
 
 struct typeahead;
 struct guess_context;
+struct result_cache;
 struct formatter;
 
 constexpr auto const kNoMatchScores = []() {
@@ -96,6 +103,55 @@ struct scored_match {
   T idx_;
 };
 
+// Number of candidates kept by the cosine similarity stage (guess) and the
+// phrase scoring stage (per type: streets, places). The max_* values are
+// the work budget. With cos_sim_ratio_ / score_gap_ set, the cutoff adapts to
+// the score distribution of the query: candidates far behind the best one
+// are dropped (but at least min_* are kept). Unique queries with one clear
+// winner then skip most of the work, ambiguous queries keep the full budget.
+// Contexts sharing a result cache have to use the same limits.
+struct candidate_limits {
+  // The fixed limits used before adaptive cutoffs existed (default).
+  static candidate_limits fixed() { return {}; }
+
+  // Adaptive cutoffs (see adr-bench --tune for the recall/latency tradeoff).
+  static candidate_limits adaptive() {
+    return {.cos_sim_ratio_ = 0.6F, .score_gap_ = 4.0F};
+  }
+
+  // Number of cos sim candidates to keep (cos sim: higher = better).
+  std::size_t get_cos_sim_limit(std::vector<cos_sim_match> const&) const;
+
+  // Number of scored matches to keep (sorted, score: lower = better).
+  template <typename T>
+  std::size_t get_score_limit(std::vector<scored_match<T>> const& v) const {
+    if (score_gap_ <= 0.0F || v.empty()) {
+      return std::min(v.size(), max_scored_matches_);
+    }
+    auto const threshold = v.front().score_ + score_gap_;
+    auto const n = static_cast<std::size_t>(std::distance(
+        begin(v),
+        std::upper_bound(begin(v), end(v), threshold,
+                         [](score_t const x, scored_match<T> const& m) {
+                           return x < m.score_;
+                         })));
+    return std::min(std::clamp(n, min_scored_matches_, max_scored_matches_),
+                    v.size());
+  }
+
+  // Keep candidates with cos_sim >= cos_sim_ratio_ * best cos_sim
+  // (0 = disabled).
+  float cos_sim_ratio_{0.0F};
+
+  // Keep scored matches with score <= best score + score_gap_ (0 = disabled).
+  float score_gap_{0.0F};
+
+  std::size_t min_matches_{200U};
+  std::size_t max_matches_{6000U};
+  std::size_t min_scored_matches_{100U};
+  std::size_t max_scored_matches_{10000U};
+};
+
 struct match_item {
   enum class type { kStreet, kHouseNumber, kPlace } type_;
   score_t score_;
@@ -104,24 +160,73 @@ struct match_item {
   std::uint8_t matched_mask_;
 };
 
+struct geo_match_count {
+  std::uint8_t count_;
+  std::uint8_t last_ngram_;
+};
+
 struct guess_context {
-  explicit guess_context(cache& cache) : cache_{cache} {}
+  explicit guess_context(cache& cache) : cache_{&cache} {}
 
   void resize(typeahead const&);
 
+  // Releases the per-query temporaries of the previous query (O(1)).
+  void reset_arena();
+
+  // Approximate heap memory held by this context (reused buffers + arena).
+  std::size_t memory_usage() const;
+
+  // Generate candidates from the region around the query coordinate first
+  // (requires typeahead::geo_bigrams_ from extract with geo_index, ignored
+  // otherwise). Only expands to a full scan if the region does not yield
+  // enough candidates.
+  bool geo_candidates_{false};
+
+  // Generate candidates with dynamic pruning (MaxScore) over the bigram
+  // postings instead of counting all postings, if the query bigrams make it
+  // worthwhile (long queries with frequent bigrams). Bypasses the ngram
+  // cache. Same candidates up to ties at the max_matches_ boundary.
+  bool prune_candidates_{false};
+
+  // Optional cache for complete results (may be shared between contexts).
+  result_cache* result_cache_{nullptr};
+
+  // Optional process-wide aggregation of the query profiles (may be shared
+  // between contexts).
+  query_metrics* query_metrics_{nullptr};
+
+  // Time / work limit of each query (unlimited by default).
+  query_budget budget_;
+
+  // Candidate cutoffs of each query (fixed by default).
+  candidate_limits limits_;
+
+  // Stage timings and counters of the last query.
+  query_profile profile_;
+
+  // Per-query temporaries. Heap allocated: its address must not change
+  // when the context is moved (phrases_ refers to it).
+  std::unique_ptr<query_arena> arena_{std::make_unique<query_arena>()};
+
   utf8_normalize_buf_t normalize_buf_;
   std::string phrase_mem_;
   std::vector<sift_offset> sift4_offset_arr_;
   std::vector<std::string_view> s_tokens_mem_;
 
-  std::vector<phrase> phrases_;
+  std::pmr::vector<query_phrase> phrases_{arena_.get()};
   std::vector<suggestion> suggestions_;
 
   //  cista::raw::vector_map<string_idx_t, std::uint8_t> string_match_counts_;
 
-  adr::cache& cache_;
+  adr::cache* cache_;
 
   std::vector<cos_sim_match> string_matches_;
+  cista::raw::ankerl_map<string_idx_t, geo_match_count> geo_match_counts_;
+
+  // Dynamic pruning: match counts of the current string index window and
+  // the window offsets of the strings counted.
+  std::vector<std::uint8_t> window_counts_;
+  std::vector<std::uint32_t> window_strings_;
 
   std::vector<bool> area_active_;
 
@@ -130,6 +235,11 @@ struct guess_context {
       area_phrase_match_scores_;
   cista::raw::vector_map<area_idx_t, phrase_lang_t> area_phrase_lang_;
 
+  // Scores of numeric strings (house numbers, postal codes) against the
+  // numeric phrases. Computed once per string and query.
+  cista::raw::ankerl_map<string_idx_t, phrase_match_scores_t>
+      numeric_phrase_match_scores_;
+
   cista::raw::ankerl_map<area_set_idx_t, std::vector<match_item>>
       area_match_items_;
   cista::raw::ankerl_set<std::uint8_t> item_matched_masks_;
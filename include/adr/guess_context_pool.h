@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <cinttypes>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "adr/guess_context.h"
+#include "adr/index_handle.h"
+
+namespace adr {
+
+// Bounded pool of guess contexts for servers without a fixed set of query
+// threads (e.g. thread per connection). acquire() blocks while max_size_
+// contexts are in use. Contexts are bound to the current index generation
+// lazily: a context acquired after a reload is rebound (see
+// index_generation::bind) instead of recreated, so its buffers are kept.
+// Idle contexts don't pin a generation.
+struct guess_context_pool {
+  struct config {
+    std::size_t max_size_{16U};
+
+    // Contexts holding more memory than this when released are freed
+    // instead of returned to the pool (e.g. after an outlier query).
+    std::size_t max_context_bytes_{std::numeric_limits<std::size_t>::max()};
+  };
+
+  struct stats {
+    std::size_t size_;  // contexts alive (idle + in use)
+    std::size_t in_use_;
+    std::size_t max_in_use_;
+    std::size_t memory_bytes_;  // as of the last release of each context
+    std::size_t high_water_bytes_;  // maximum of memory_bytes_
+    std::uint64_t created_;
+    std::uint64_t rebinds_;
+    std::uint64_t dropped_;
+  };
+
+  struct entry {
+    std::uint64_t generation_id_;
+    guess_context ctx_;
+    std::size_t memory_bytes_{0U};
+  };
+
+  // Returns the context to the pool on destruction.
+  struct lease {
+    lease(guess_context_pool&,
+          std::shared_ptr<index_generation const>,
+          std::unique_ptr<entry>);
+    lease(lease&&) noexcept = default;
+    lease& operator=(lease&&) = delete;
+    lease(lease const&) = delete;
+    lease& operator=(lease const&) = delete;
+    ~lease();
+
+    guess_context& ctx() const { return entry_->ctx_; }
+    index_generation const& generation() const { return *generation_; }
+    typeahead const& t() const { return *generation_->t_; }
+
+  private:
+    guess_context_pool* pool_;
+    std::shared_ptr<index_generation const> generation_;
+    std::unique_ptr<entry> entry_;
+  };
+
+  explicit guess_context_pool(index_handle const&, config const& = {});
+
+  lease acquire();
+
+  stats get_stats() const;
+
+private:
+  void release(std::unique_ptr<entry>);
+
+  index_handle const& index_;
+  config config_;
+
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<std::unique_ptr<entry>> idle_;
+  std::size_t size_{0U};
+  std::size_t in_use_{0U};
+  std::size_t max_in_use_{0U};
+  std::size_t memory_bytes_{0U};
+  std::size_t high_water_bytes_{0U};
+  std::uint64_t created_{0U};
+  std::uint64_t rebinds_{0U};
+  std::uint64_t dropped_{0U};
+};
+
+}  // namespace adr
\ No newline at end of file
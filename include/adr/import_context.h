@@ -1,11 +1,82 @@
 #pragma once
 
+#include <string_view>
+
 #include "ankerl/cista_adapter.h"
+#include "ankerl/unordered_dense.h"
+
+#include "cista/containers/vecvec.h"
 
 #include "adr/types.h"
 
 namespace adr {
 
+// Interning table for typeahead::strings_. Stores only string indices:
+// hashing and comparison go through the strings themselves, lookups take a
+// std::string_view (no temporary std::string). Bound to one strings_
+// container on first use; strings already in there are indexed then.
+struct string_lookup {
+  using strings_t = data::vecvec<string_idx_t, char>;
+
+  struct hash {
+    using is_transparent = void;
+    using is_avalanching = void;
+
+    std::uint64_t operator()(std::string_view s) const {
+      return ankerl::unordered_dense::hash<std::string_view>{}(s);
+    }
+
+    std::uint64_t operator()(string_idx_t const i) const {
+      return (*this)((*strings_)[i].view());
+    }
+
+    strings_t const* strings_{nullptr};
+  };
+
+  struct equal {
+    using is_transparent = void;
+
+    bool operator()(string_idx_t const a, string_idx_t const b) const {
+      return a == b;
+    }
+
+    bool operator()(std::string_view a, string_idx_t const b) const {
+      return a == (*strings_)[b].view();
+    }
+
+    bool operator()(string_idx_t const a, std::string_view b) const {
+      return (*strings_)[a].view() == b;
+    }
+
+    strings_t const* strings_{nullptr};
+  };
+
+  string_idx_t get_or_create(strings_t& strings, std::string_view s) {
+    if (strings_ != &strings) {
+      strings_ = &strings;
+      set_ = set_t{0U, hash{&strings}, equal{&strings}};
+      set_.reserve(strings.size());
+      for (auto i = string_idx_t{0U}; i < strings.size(); ++i) {
+        set_.emplace(i);
+      }
+    }
+
+    auto const it = set_.find(s);
+    if (it != end(set_)) {
+      return *it;
+    }
+    strings.emplace_back(s);
+    auto const idx = string_idx_t{strings.size() - 1U};
+    set_.emplace(idx);
+    return idx;
+  }
+
+  using set_t = ankerl::unordered_dense::set<string_idx_t, hash, equal>;
+
+  strings_t const* strings_{nullptr};
+  set_t set_;
+};
+
 struct import_context {
   template <typename K, typename V>
   using raw_hash_map = cista::raw::ankerl_map<K, V>;
@@ -17,7 +88,7 @@ struct import_context {
   using raw_mutable_vecvec = cista::raw::mutable_fws_multimap<K, V>;
 
   raw_hash_map<basic_string<area_idx_t>, area_set_idx_t> area_set_lookup_;
-  raw_hash_map<std::string, string_idx_t> string_lookup_;
+  string_lookup string_lookup_;
   raw_hash_map<std::string, timezone_idx_t> tz_lookup_;
   raw_hash_map<string_idx_t, street_idx_t> street_lookup_;
   raw_vector_map<street_idx_t, string_idx_t> street_names_;
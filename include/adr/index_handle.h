@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <filesystem>
+#include <memory>
+
+#include "cista/memory_holder.h"
+
+#include "adr/adr.h"
+#include "adr/area_database.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/result_cache.h"
+#include "adr/reverse.h"
+#include "adr/typeahead.h"
+
+namespace adr {
+
+// Everything loaded from one extract directory (t.bin, reverse and area
+// files) together with the caches that are only valid for this data.
+struct index_generation {
+  struct config {
+    load_mode load_mode_{load_mode::kRead};
+    std::size_t cache_size_{100U};
+    std::size_t result_cache_size_{0U};
+  };
+
+  index_generation(std::filesystem::path const& dir, config const&);
+
+  // Context bound to this generation's typeahead and caches.
+  guess_context make_context() const;
+
+  // Rebinds an existing context (e.g. after a reload) to this generation.
+  // Keeps the context's buffers, area vectors are resized.
+  void bind(guess_context&) const;
+
+  std::uint64_t id_;
+  cista::wrapped<typeahead> t_;
+  reverse r_;
+  area_database area_db_;
+  mutable cache cache_;
+  std::unique_ptr<result_cache> result_cache_;
+};
+
+// Reloadable index: queries pin the current generation with get() and keep
+// using it until they are done. swap()/reload() publish a new generation
+// without blocking readers. The old generation is released as soon as the
+// last query holding it finishes.
+struct index_handle {
+  explicit index_handle(std::shared_ptr<index_generation const>);
+  index_handle(std::filesystem::path const& dir,
+               index_generation::config const& = {});
+
+  std::shared_ptr<index_generation const> get() const;
+
+  // Returns the previous generation.
+  std::shared_ptr<index_generation const> swap(
+      std::shared_ptr<index_generation const>);
+
+  // Loads the directory (off the query path) and publishes it.
+  std::shared_ptr<index_generation const> reload(
+      std::filesystem::path const& dir, index_generation::config const& = {});
+
+private:
+  std::atomic<std::shared_ptr<index_generation const>> current_;
+};
+
+}  // namespace adr
\ No newline at end of file
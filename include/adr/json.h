@@ -0,0 +1,34 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "adr/types.h"
+
+namespace adr {
+
+struct suggestion;
+struct typeahead;
+
+// Minimal JSON output for the server. Appends to the given buffer (reuse it
+// across requests to avoid allocations), strings are written directly from
+// the typeahead string views.
+
+void append_json_string(std::string& out, std::string_view);
+
+void append_json_number(std::string& out, double);
+
+void append_json_number(std::string& out, std::uint64_t);
+
+// JSON array of suggestions:
+//   [{"type": "place" | "address", "name": ..., "house_number": ...,
+//     "category": ..., "lat": ..., "lng": ..., "score": ..., "tz": ...,
+//     "areas": [{"name": ..., "admin_level": ..., "matched": ...}, ...]}]
+// Areas need populate_areas() (done by get_suggestions() and lookup()).
+void append_suggestions_json(std::string& out,
+                             typeahead const&,
+                             language_list_t const&,
+                             std::span<suggestion const>);
+
+}  // namespace adr
\ No newline at end of file
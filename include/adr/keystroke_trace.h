@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cinttypes>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace adr {
+
+// One typeahead request of a user session: the input field content after a
+// keystroke, offset_ms_ after the start of the trace.
+//
+// Text format: one keystroke per line, tab separated
+//   <session>\t<offset_ms>\t<input>
+struct keystroke {
+  std::uint32_t session_;
+  std::uint64_t offset_ms_;
+  std::string input_;
+};
+
+struct keystroke_trace_config {
+  // Sessions start with exponentially distributed gaps (Poisson arrivals).
+  double mean_session_gap_ms_{50.0};
+
+  // Delays between keystrokes are log-normally distributed around this
+  // median. Delays after a space (next word) are twice as long.
+  double median_key_delay_ms_{150.0};
+  double key_delay_sigma_{0.5};
+
+  std::uint32_t seed_{42U};
+};
+
+// Expands each query into the prefixes a user types ("d", "da", "dar", ...;
+// split at UTF-8 code points, trailing spaces skipped). Session i types
+// queries[i % queries.size()]. Sorted by offset.
+std::vector<keystroke> generate_keystroke_trace(
+    std::vector<std::string> const& queries,
+    std::uint32_t n_sessions,
+    keystroke_trace_config const& = {});
+
+std::vector<keystroke> read_keystroke_trace(std::filesystem::path const&);
+
+void write_keystroke_trace(std::ostream&, std::vector<keystroke> const&);
+
+// Query corpus: one query per line, empty lines skipped.
+std::vector<std::string> read_queries(std::filesystem::path const&);
+
+// Nearest rank percentile (p in [0, 1]) of sorted values, 0 if empty.
+std::uint64_t percentile(std::vector<std::uint64_t> const& sorted, double p);
+
+}  // namespace adr
\ No newline at end of file
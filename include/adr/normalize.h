@@ -2,7 +2,16 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "utf8proc.h"
 
@@ -10,6 +19,7 @@
 #include "utl/enumerate.h"
 #include "utl/helpers/algorithm.h"
 
+#include "adr/ngram.h"
 #include "adr/types.h"
 
 namespace adr {
@@ -45,8 +55,60 @@ inline void erase_fillers(std::string& in) {
   }
 }
 
-inline std::string_view normalize(std::string_view v,
-                                  utf8_normalize_buf_t& decomposed) {
+// Writes the lower case version of `in` to `out` (at least `in.size()` bytes).
+// Returns false if `in` is not pure ASCII. The contents of `out` are undefined
+// in this case.
+inline bool ascii_to_lower(std::string_view in, char* out) {
+  auto i = std::size_t{0U};
+
+#if defined(__SSE2__)
+  auto non_ascii = _mm_setzero_si128();
+  for (; i + 16U <= in.size(); i += 16U) {
+    auto const x =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(in.data() + i));
+    non_ascii = _mm_or_si128(non_ascii, x);
+
+    // Signed comparison: bytes >= 0x80 are negative, i.e. never upper case.
+    auto const is_upper =
+        _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('A' - 1)),
+                      _mm_cmplt_epi8(x, _mm_set1_epi8('Z' + 1)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out + i),
+        _mm_or_si128(x, _mm_and_si128(is_upper, _mm_set1_epi8(0x20))));
+  }
+  if (_mm_movemask_epi8(non_ascii) != 0) {
+    return false;
+  }
+#elif defined(__aarch64__)
+  auto non_ascii = vdupq_n_u8(0U);
+  for (; i + 16U <= in.size(); i += 16U) {
+    auto const x =
+        vld1q_u8(reinterpret_cast<std::uint8_t const*>(in.data() + i));
+    non_ascii = vorrq_u8(non_ascii, x);
+
+    auto const is_upper =
+        vcltq_u8(vsubq_u8(x, vdupq_n_u8('A')), vdupq_n_u8('Z' - 'A' + 1));
+    vst1q_u8(reinterpret_cast<std::uint8_t*>(out + i),
+             vorrq_u8(x, vandq_u8(is_upper, vdupq_n_u8(0x20))));
+  }
+  if (vmaxvq_u8(non_ascii) >= 0x80) {
+    return false;
+  }
+#endif
+
+  auto tail_non_ascii = std::uint8_t{0U};
+  for (; i != in.size(); ++i) {
+    auto const c = static_cast<std::uint8_t>(in[i]);
+    tail_non_ascii |= c;
+    out[i] = static_cast<char>(is_upper_case(in[i]) ? c | 0x20U : c);
+  }
+  return (tail_non_ascii & 0x80U) == 0U;
+}
+
+// Reference implementation: full Unicode decomposition + mark stripping +
+// case folding via utf8proc.
+inline std::string_view normalize_utf8proc(std::string_view v,
+                                           utf8_normalize_buf_t& decomposed) {
   decomposed.resize(v.size());
   auto const decomposed_size = utf8proc_decompose(
       reinterpret_cast<std::uint8_t const*>(v.data()),
@@ -65,6 +127,18 @@ inline std::string_view normalize(std::string_view v,
           static_cast<std::size_t>(reencoded_size)};
 }
 
+inline std::string_view normalize(std::string_view v,
+                                  utf8_normalize_buf_t& decomposed) {
+  // For ASCII input, decomposition and mark stripping are a no-op and case
+  // folding maps A-Z to a-z. Skip the round trip through UTF-32 in this case.
+  decomposed.resize(v.size() / sizeof(utf8proc_int32_t) + 1U);
+  auto const out = reinterpret_cast<char*>(decomposed.data());
+  if (ascii_to_lower(v, out)) {
+    return {out, v.size()};
+  }
+  return normalize_utf8proc(v, decomposed);
+}
+
 inline std::string_view normalize(std::string_view in) {
   static auto decomposed_buf = utf8_normalize_buf_t{};
   return normalize(in, decomposed_buf);
@@ -79,6 +153,12 @@ struct phrase {
   std::string s_;
 };
 
+// Phrase of the current query, the string lives in the query arena.
+struct query_phrase {
+  token_bitmask_t token_bits_;
+  std::string_view s_;
+};
+
 inline std::string bit_mask_to_str(token_bitmask_t const b) {
   auto r = std::string{};
   for (auto i = 0U; i != sizeof(b) * 8U; ++i) {
@@ -133,8 +213,8 @@ inline bool append_alt_string(std::string_view s, std::string& out) {
   return false;
 }
 
-template <typename String, typename Fn>
-inline void for_each_phrase(std::vector<String> const& in_tokens,
+template <typename Tokens, typename Fn>
+inline void for_each_phrase(Tokens const& in_tokens,
                             std::string& mem,
                             Fn&& fn) {
   mem.clear();
@@ -189,16 +269,45 @@ inline std::vector<phrase> get_sorted_phrases(
   return r;
 }
 
+// Same as above for the query path: the phrases and their strings are
+// allocated from the memory resource of `out` (the query arena).
+inline void get_sorted_phrases(std::span<std::string_view const> in_tokens,
+                               std::string& mem,
+                               std::pmr::vector<query_phrase>& out) {
+  auto alloc = out.get_allocator();
+  out.clear();
+  for_each_phrase(
+      in_tokens, mem,
+      [&](token_bitmask_t const token_bits, std::string_view const s) {
+        auto const str = alloc.allocate_object<char>(s.size());
+        std::copy(begin(s), end(s), str);
+        out.push_back({token_bits, std::string_view{str, s.size()}});
+      });
+  utl::sort(out, [](auto&& a, auto&& b) { return a.s_.size() > b.s_.size(); });
+  out.resize(std::min(static_cast<std::size_t>(kMaxInputPhrases), out.size()));
+}
+
+inline bool is_utf8_continuation(char const c) {
+  return (static_cast<std::uint8_t>(c) & 0xC0U) == 0x80U;
+}
+
+inline std::size_t utf8_codepoint_count(std::string_view s) {
+  return static_cast<std::size_t>(std::count_if(
+      begin(s), end(s), [](char const c) { return !is_utf8_continuation(c); }));
+}
+
+// At least half of the characters are digits ("12", "12a", "1-3", "64283").
+inline bool is_numeric(std::string_view s) {
+  auto const digits = std::count_if(
+      begin(s), end(s), [](auto&& c) { return c >= '0' && c <= '9'; });
+  return digits != 0U && digits >= static_cast<unsigned>((s.size() + 1U) / 2U);
+}
+
 inline std::uint8_t get_numeric_tokens_mask(
-    std::vector<std::string> const& tokens) {
-  auto const number_count = [](std::string_view s) {
-    return std::count_if(begin(s), end(s),
-                         [](auto&& c) { return c >= '0' && c <= '9'; });
-  };
+    std::span<std::string_view const> tokens) {
   auto mask = std::uint8_t{0U};
   for (auto const [i, token] : utl::enumerate(tokens)) {
-    auto const c = number_count(token);
-    if (c != 0U && c >= static_cast<unsigned>((token.size() + 1U) / 2U)) {
+    if (is_numeric(token)) {
       mask |= 1U << i;
     }
   }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cinttypes>
+#include <string_view>
+
+#include "cista/hash.h"
+
+#include "osmium/osm/tag.hpp"
+
+#include "adr/categories.h"
+
+namespace adr {
+
+// Tag properties that decide how extract() handles an OSM object.
+// Computed by classify_tags() in one pass over the tag list (one switch on
+// the key hash per tag) instead of a linear tag list search per checked key.
+struct tag_class {
+  enum bit : std::uint32_t {
+    kExcludedNode = 1U << 0U,  // node can't become a place / address
+    kExcludedWay = 1U << 1U,  // way can't become a street / place / address
+    kName = 1U << 2U,
+    kHouseNumber = 1U << 3U,
+    kAddrStreet = 1U << 4U,  // addr:street or addr:place
+    kHighway = 1U << 5U,
+    kAmenity = 1U << 6U  // has a key used by the amenity category rules
+  };
+
+  bool has(bit const b) const { return (bits_ & b) != 0U; }
+  bool is_relevant_node() const { return !has(kExcludedNode); }
+  bool is_relevant_way() const { return !has(kExcludedWay); }
+  bool is_address() const { return has(kHouseNumber) && has(kAddrStreet); }
+
+  std::uint32_t bits_{0U};
+};
+
+inline tag_class classify_tags(osmium::TagList const& tags) {
+  using namespace std::string_view_literals;
+
+  constexpr auto const kNode = std::uint32_t{tag_class::kExcludedNode};
+  constexpr auto const kBoth =
+      std::uint32_t{tag_class::kExcludedNode | tag_class::kExcludedWay};
+
+  auto bits = std::uint32_t{0U};
+  for (auto const& t : tags) {
+    auto const key = cista::hash(std::string_view{t.key()});
+    auto const value = std::string_view{t.value()};
+    if (is_amenity_key(key)) {
+      bits |= tag_class::kAmenity;
+    }
+    switch (key) {
+      case cista::hash("name"): bits |= tag_class::kName; break;
+      case cista::hash("addr:housenumber"):
+        bits |= tag_class::kHouseNumber;
+        break;
+      case cista::hash("addr:street"): [[fallthrough]];
+      case cista::hash("addr:place"): bits |= tag_class::kAddrStreet; break;
+
+      // Named highway nodes are motorway junctions etc.
+      case cista::hash("highway"): bits |= tag_class::kHighway | kNode; break;
+      case cista::hash("traffic_sign"): bits |= kNode; break;
+
+      // public_transport: stops from timetables
+      case cista::hash("public_transport"): [[fallthrough]];
+      case cista::hash("electrified"): [[fallthrough]];
+      case cista::hash("railway"): [[fallthrough]];
+      case cista::hash("waterway"): [[fallthrough]];
+      case cista::hash("tunnel"): bits |= kBoth; break;
+
+      case cista::hash("natural"):
+        if (value == "tree"sv || value == "tree_stump"sv) {
+          bits |= kNode;
+        } else if (value == "wood"sv) {
+          bits |= kBoth;
+        }
+        break;
+      case cista::hash("amenity"):
+        if (value == "toilets"sv || value == "taxi"sv) {
+          bits |= kBoth;
+        } else if (value == "bicycle_rental"sv) {
+          bits |= kNode;
+        }
+        break;
+      case cista::hash("emergency"):
+        bits |= value == "fire_hydrant"sv ? kNode : 0U;
+        break;
+      case cista::hash("building"):
+        bits |= value == "industrial"sv ? kNode : 0U;
+        break;
+      case cista::hash("information"):
+        bits |= value == "board"sv ? kBoth : 0U;
+        break;
+      case cista::hash("leisure"):
+        bits |= value == "playground"sv ? kBoth : 0U;
+        break;
+      case cista::hash("access"):
+        bits |= value == "false"sv ? kBoth : 0U;
+        break;
+
+      default: break;
+    }
+  }
+  return tag_class{bits};
+}
+
+// Unique key of a place's OSM object. Places store node ids (is_way=false),
+// way ids or area ids (is_way=true).
+inline std::uint64_t osm_key(std::int64_t const id, bool const is_way) {
+  return (static_cast<std::uint64_t>(id) << 1U) | (is_way ? 1U : 0U);
+}
+
+}  // namespace adr
\ No newline at end of file
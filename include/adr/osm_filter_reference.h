@@ -0,0 +1,40 @@
+#pragma once
+
+#include "osmium/osm/tag.hpp"
+
+namespace adr {
+
+// Filters before classify_tags() (one tag list search per checked key).
+// Only kept as reference for tests and adr-bench: extract() doesn't use them.
+
+inline bool is_relevant_node_reference(osmium::TagList const& tags) {
+  return !tags.has_tag("natural", "tree") &&
+         !tags.has_tag("natural", "tree_stump") &&
+         !tags.has_tag("emergency", "fire_hydrant") &&
+         !tags.has_key("public_transport") && !tags.has_key("highway") &&
+         !tags.has_key("electrified") && !tags.has_key("railway") &&
+         !tags.has_tag("information", "board") && !tags.has_key("waterway") &&
+         !tags.has_key("tunnel") && !tags.has_tag("amenity", "toilets") &&
+         !tags.has_tag("natural", "wood") && !tags.has_key("traffic_sign") &&
+         !tags.has_tag("building", "industrial") &&
+         !tags.has_tag("amenity", "bicycle_rental") &&
+         !tags.has_tag("leisure", "playground") &&
+         !tags.has_tag("access", "false") && !tags.has_tag("amenity", "taxi");
+}
+
+inline bool is_relevant_way_reference(osmium::TagList const& tags) {
+  return !tags.has_key("public_transport") && !tags.has_key("electrified") &&
+         !tags.has_key("railway") && !tags.has_key("waterway") &&
+         !tags.has_tag("information", "board") && !tags.has_key("tunnel") &&
+         !tags.has_tag("amenity", "toilets") &&
+         !tags.has_tag("natural", "wood") &&
+         !tags.has_tag("leisure", "playground") &&
+         !tags.has_tag("access", "false") && !tags.has_tag("amenity", "taxi");
+}
+
+inline bool is_address_reference(osmium::TagList const& tags) {
+  return tags.has_key("addr:housenumber") &&
+         (tags.has_key("addr:street") || tags.has_key("addr:place"));
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cista/containers/bitvec.h"
+
+#include "adr/adr.h"
+#include "adr/guess_context.h"
+#include "adr/typeahead.h"
+
+namespace adr {
+
+struct area_database;
+
+// Updates from an OSM change file (.osc) on top of an immutable base index.
+//
+// - Base places whose node was modified or deleted are tombstoned.
+// - Created / modified nodes are added as places and house numbers (address
+//   nodes) to a small typeahead of their own (with copies of the base areas
+//   they are located in), so the regular pipeline can query it.
+// - Places of deleted ways / relations are tombstoned. Modified ways and
+//   relations keep their base version.
+//
+// Base house numbers don't store the OSM node they came from, so they are
+// never tombstoned: a modified address node is found with its old and its
+// new house number, a deleted one with its old house number until the next
+// full extract. Ways in a change file don't come with their node locations:
+// streets, house numbers of ways and way / area places are not updated.
+struct overlay {
+  overlay(typeahead const& base,
+          area_database const& base_areas,
+          std::filesystem::path const& osc);
+
+  bool is_deleted(place_idx_t) const;
+
+  typeahead const& t() const { return *t_; }
+
+  std::unique_ptr<typeahead> t_;
+
+  // Overlay area -> base area it was copied from.
+  std::vector<area_idx_t> base_area_;
+
+  // Base places replaced or deleted by the change file.
+  cista::raw::bitvec tombstones_;
+  std::size_t n_tombstones_{0U};
+};
+
+struct overlay_suggestion {
+  typeahead const& index(typeahead const& base, overlay const& o) const {
+    return from_overlay_ ? o.t() : base;
+  }
+
+  suggestion s_;
+  bool from_overlay_;
+};
+
+// Queries base (without tombstoned places) and overlay and merges the
+// results by score. ctx must belong to base, overlay_ctx to o.t().
+template <bool Debug>
+std::vector<overlay_suggestion> get_suggestions(
+    typeahead const& base,
+    overlay const& o,
+    std::string const& input,
+    unsigned n_suggestions,
+    language_list_t const&,
+    guess_context& ctx,
+    guess_context& overlay_ctx,
+    std::optional<geo::latlng> const& coord,
+    float bias,
+    filter_type filter = filter_type::kNone);
+
+// Merges the overlay into the base extract: drops tombstoned places,
+// appends the overlay places and house numbers and rebuilds all indices.
+// Writes a complete extract directory (t.bin, reverse and area files) to out.
+void compact(std::filesystem::path const& base_dir,
+             overlay const&,
+             std::filesystem::path const& out);
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cinttypes>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace adr {
+
+// Bump allocator for per-query temporaries (tokens, phrases, permutations).
+// reset() releases everything at once in O(1) by rewinding to the start of
+// the block. Allocations that don't fit into the block go to the heap; the
+// next reset() replaces the block with one that fits the largest query so
+// far (high-water mark), so steady state queries don't touch the heap.
+// Deallocation is a no-op.
+struct query_arena : public std::pmr::memory_resource {
+  static constexpr auto const kDefaultSize = std::size_t{16U * 1024U};
+
+  explicit query_arena(std::size_t size = kDefaultSize);
+  ~query_arena() override;
+
+  query_arena(query_arena const&) = delete;
+  query_arena& operator=(query_arena const&) = delete;
+  query_arena(query_arena&&) = delete;
+  query_arena& operator=(query_arena&&) = delete;
+
+  // Invalidates all memory handed out since the last reset().
+  void reset();
+
+  // Copies the string into the arena.
+  std::string_view copy(std::string_view);
+
+  std::size_t capacity() const { return block_size_; }
+  std::size_t used() const { return offset_ + overflow_bytes_; }
+  std::size_t high_water() const;
+
+private:
+  struct overflow {
+    void* ptr_;
+    std::size_t bytes_;
+    std::size_t alignment_;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  bool do_is_equal(std::pmr::memory_resource const&) const noexcept override;
+
+  void free_overflow();
+
+  std::unique_ptr<std::byte[]> block_;
+  std::size_t block_size_;
+  std::size_t offset_{0U};
+  std::size_t overflow_bytes_{0U};
+  std::vector<overflow> overflow_;
+  std::size_t high_water_{0U};
+};
+
+}  // namespace adr
\ No newline at end of file
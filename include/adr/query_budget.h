@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cinttypes>
+#include <limits>
+
+namespace adr {
+
+// Cooperative time / work budget of one get_suggestions() call. Stages
+// process their candidates best first and check the budget between
+// candidates. When it is exhausted, the remaining candidates are skipped and
+// the query returns the best suggestions found so far
+// (query_profile::truncated_ is set, truncated results are not cached).
+//
+// Work units: one per phrase score of a string candidate, one per street
+// and place candidate and one per phrase of each house number of a street.
+// The bigram counting stage is never interrupted.
+struct query_budget {
+  using clock = std::chrono::steady_clock;
+
+  static constexpr auto const kUnlimitedWork =
+      std::numeric_limits<std::uint64_t>::max();
+
+  // The clock is read at most every kClockCheckInterval work units.
+  static constexpr auto const kClockCheckInterval = std::uint64_t{8U};
+
+  // Longer time limits are treated as unlimited.
+  static constexpr auto const kMaxTimeLimitUs =
+      std::uint64_t{3'600'000'000U};  // 1 hour
+
+  bool is_limited() const {
+    return time_limit_ != clock::duration::max() ||
+           work_limit_ != kUnlimitedWork;
+  }
+
+  // Sets time_limit_ from a (client supplied) number of microseconds.
+  // 0 and values above kMaxTimeLimitUs mean unlimited (no overflow when
+  // converting to clock::duration).
+  void set_time_limit_us(std::uint64_t const us) {
+    time_limit_ = us == 0U || us > kMaxTimeLimitUs
+                      ? clock::duration::max()
+                      : std::chrono::duration_cast<clock::duration>(
+                            std::chrono::microseconds{
+                                static_cast<std::int64_t>(us)});
+  }
+
+  // Starts the budget of a new query.
+  void start() {
+    auto const now = clock::now();
+    deadline_ = time_limit_ >= clock::time_point::max() - now
+                    ? clock::time_point::max()
+                    : now + time_limit_;
+    work_ = 0U;
+    next_clock_check_ = 0U;
+    exhausted_ = false;
+    truncated_ = false;
+  }
+
+  // Charges work units, returns true if the budget is exhausted.
+  bool spend(std::uint64_t const units = 1U) {
+    if (exhausted_) {
+      return true;
+    }
+    work_ += units;
+    if (work_ > work_limit_) {
+      exhausted_ = true;
+    } else if (deadline_ != clock::time_point::max() &&
+               work_ >= next_clock_check_) {
+      next_clock_check_ = work_ + kClockCheckInterval;
+      exhausted_ = clock::now() >= deadline_;
+    }
+    return exhausted_;
+  }
+
+  // Called before candidate i (best first) of a stage. Returns true if the
+  // stage has to stop here. The first min_candidates_ candidates of each
+  // stage are always processed, so every stage contributes its best results.
+  bool stop_before(std::size_t const i, std::uint64_t const units = 1U) {
+    if (spend(units) && i >= min_candidates_) {
+      truncated_ = true;
+      return true;
+    }
+    return false;
+  }
+
+  // Called inside a candidate with a lot of work of its own (a street with
+  // many house numbers). Returns true if the rest of it has to be skipped.
+  // Also applies to the first min_candidates_ candidates.
+  bool stop_within(std::uint64_t const units) {
+    if (spend(units)) {
+      truncated_ = true;
+      return true;
+    }
+    return false;
+  }
+
+  bool truncated() const { return truncated_; }
+  std::uint64_t work() const { return work_; }
+
+  // Limits, measured from the start of the query.
+  clock::duration time_limit_{clock::duration::max()};
+  std::uint64_t work_limit_{kUnlimitedWork};
+  std::size_t min_candidates_{8U};
+
+private:
+  clock::time_point deadline_{clock::time_point::max()};
+  std::uint64_t work_{0U};
+  std::uint64_t next_clock_check_{0U};
+  bool exhausted_{false};
+  bool truncated_{false};
+};
+
+}  // namespace adr
\ No newline at end of file
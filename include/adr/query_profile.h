@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <iosfwd>
+#include <string_view>
+
+namespace adr {
+
+enum class query_stage : std::uint8_t {
+  kTokenize,  // normalization, tokens, result cache lookup, phrases
+  kCount,  // bigram match counting (incl. ngram cache)
+  kCosSim,  // cosine similarity + candidate selection
+  kPhraseScore,  // string/phrase match scores, scored streets and places
+  kStreetMatch,
+  kPlaceMatch,
+  kFinalize,  // bias, duplicates, sort, areas
+  kTotal
+};
+
+constexpr auto const kQueryStages =
+    static_cast<std::size_t>(query_stage::kTotal) + 1U;
+
+constexpr std::array<std::string_view, kQueryStages> kQueryStageNames = {
+    "tokenize",     "count",       "cos_sim",  "phrase_score",
+    "street_match", "place_match", "finalize", "total"};
+
+// Breakdown of one get_suggestions() call. Filled for every query (no
+// Debug build required) and available in guess_context::profile_ until the
+// next query with the same context.
+struct query_profile {
+  using clock = std::chrono::steady_clock;
+
+  // Times consecutive stages: lap(s) adds the time since the previous lap
+  // (or construction / restart()) to stage s.
+  struct stopwatch {
+    explicit stopwatch(query_profile& p) : p_{p}, start_{clock::now()} {}
+
+    void lap(query_stage const s) {
+      auto const now = clock::now();
+      p_.add(s, now - start_);
+      start_ = now;
+    }
+
+    void restart() { start_ = clock::now(); }
+
+    query_profile& p_;
+    clock::time_point start_;
+  };
+
+  void reset() { *this = query_profile{}; }
+
+  void add(query_stage const s, clock::duration const d) {
+    auto const i = static_cast<std::size_t>(s);
+    stage_ns_[i] += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    stages_run_ |= 1U << i;
+  }
+
+  bool has_run(query_stage const s) const {
+    return (stages_run_ & (1U << static_cast<std::size_t>(s))) != 0U;
+  }
+
+  std::uint64_t ns(query_stage const s) const {
+    return stage_ns_[static_cast<std::size_t>(s)];
+  }
+
+  void print(std::ostream&) const;
+
+  std::array<std::uint64_t, kQueryStages> stage_ns_{};
+  std::uint32_t stages_run_{0U};
+
+  std::uint32_t n_tokens_{0U};
+  std::uint32_t n_ngrams_{0U};
+  std::uint32_t n_cached_ngrams_{0U};  // counts taken from the ngram cache
+  std::uint32_t n_string_matches_{0U};  // cos sim candidates
+  std::uint32_t n_street_matches_{0U};  // scored streets
+  std::uint32_t n_place_matches_{0U};  // scored places
+  std::uint32_t n_suggestions_{0U};  // before truncation to n_suggestions
+  bool short_prefix_{false};
+  bool result_cache_hit_{false};
+  bool geo_candidates_{false};  // candidates from the region around coord
+  bool pruned_{false};  // candidates from dynamic pruning (no full count)
+  bool truncated_{false};  // budget exhausted, candidates were skipped
+};
+
+// Process-wide aggregation of query profiles. Lock-free: every counter is
+// an atomic updated with relaxed fetch_add, so add() can be called from all
+// query threads. Share one instance via guess_context::query_metrics_.
+struct query_metrics {
+  // Upper bounds of the latency histogram buckets (microseconds). The last
+  // bucket (+Inf) is implicit.
+  static constexpr auto const kLatencyBucketsUs =
+      std::array<std::uint64_t, 16U>{
+          10U,     25U,      50U,      100U,     250U,     500U,
+          1'000U,  2'500U,   5'000U,   10'000U,  25'000U,  50'000U,
+          100'000U, 250'000U, 500'000U, 1'000'000U};
+  static constexpr auto const kBuckets = kLatencyBucketsUs.size() + 1U;
+
+  struct histogram {
+    void observe(std::uint64_t ns);
+
+    std::array<std::atomic_uint64_t, kBuckets> buckets_{};
+    std::atomic_uint64_t sum_ns_{0U};
+    std::atomic_uint64_t count_{0U};
+  };
+
+  void add(query_profile const&);
+
+  // Prometheus text exposition format (version 0.0.4).
+  void print_prometheus(std::ostream&) const;
+
+  std::array<histogram, kQueryStages> stages_;
+
+  std::atomic_uint64_t queries_{0U};
+  std::atomic_uint64_t short_prefix_queries_{0U};
+  std::atomic_uint64_t result_cache_hits_{0U};
+  std::atomic_uint64_t geo_candidate_queries_{0U};
+  std::atomic_uint64_t pruned_queries_{0U};
+  std::atomic_uint64_t truncated_queries_{0U};
+  std::atomic_uint64_t ngrams_{0U};
+  std::atomic_uint64_t cached_ngrams_{0U};
+  std::atomic_uint64_t string_matches_{0U};
+  std::atomic_uint64_t street_matches_{0U};
+  std::atomic_uint64_t place_matches_{0U};
+  std::atomic_uint64_t suggestions_{0U};
+};
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ankerl/cista_adapter.h"
+
+#include "geo/box.h"
+#include "geo/latlng.h"
+
+#include "adr/guess_context.h"
+#include "adr/types.h"
+
+namespace adr {
+
+// Bias coordinates are snapped to a grid of this size (in degrees) so that
+// queries from close-by locations share cache entries.
+constexpr auto const kResultCacheCoordinatePrecision = 0.01;
+
+// Caches complete get_suggestions() results.
+//
+// Keyed by the guess() input string (full normalized input), the normalized
+// tokens, languages, filter, number of suggestions, bias and the quantized
+// bias coordinate. Queries with a place filter are not cached. Split into
+// independently locked shards (no global lock). Each shard evicts least
+// recently used entries. New entries are only admitted if they were
+// requested more often than the eviction victim (TinyLFU: frequencies are
+// estimated by a count-min sketch that is halved periodically).
+struct result_cache {
+  static constexpr auto const kShards = 64U;
+
+  struct entry {
+    std::string key_;
+    std::vector<suggestion> suggestions_;
+    std::atomic_uint32_t hits_{0U};
+  };
+
+  struct stats {
+    std::uint64_t hits_;
+    std::uint64_t misses_;
+    std::uint64_t inserts_;
+    std::uint64_t rejected_;
+    std::uint64_t evictions_;
+  };
+
+  explicit result_cache(std::size_t max_entries);
+
+  static std::string make_key(std::string_view guess_str,
+                              std::span<std::string_view const> tokens,
+                              language_list_t const& languages,
+                              filter_type,
+                              unsigned n_suggestions,
+                              std::optional<geo::latlng> const& coord,
+                              float bias,
+                              std::optional<geo::box> const& bbox);
+
+  static geo::latlng quantize(geo::latlng const&);
+
+  std::shared_ptr<entry const> get(std::string_view key);
+  void add(std::string key, std::vector<suggestion> suggestions);
+  void clear();
+
+  stats get_stats() const;
+
+  // Most frequently hit entries (key, hits), highest first.
+  std::vector<std::pair<std::string, std::uint32_t>> hot_keys(
+      std::size_t n) const;
+
+private:
+  struct sketch {
+    static constexpr auto const kDepth = 4U;
+
+    explicit sketch(std::size_t width);
+    void increment(std::uint64_t hash);
+    std::uint8_t estimate(std::uint64_t hash) const;
+
+    std::size_t width_;
+    std::size_t sample_size_;
+    std::size_t additions_{0U};
+    std::vector<std::uint8_t> counters_;
+  };
+
+  struct shard {
+    explicit shard(std::size_t max_entries);
+
+    mutable std::mutex mtx_;
+    std::size_t max_entries_;
+    std::list<std::shared_ptr<entry>> lru_;
+    cista::raw::ankerl_map<std::string_view,
+                           std::list<std::shared_ptr<entry>>::iterator>
+        index_;
+    sketch frequency_;
+  };
+
+  shard& get_shard(std::uint64_t hash);
+
+  std::vector<std::unique_ptr<shard>> shards_;
+
+  std::atomic_uint64_t hits_{0U};
+  std::atomic_uint64_t misses_{0U};
+  std::atomic_uint64_t inserts_{0U};
+  std::atomic_uint64_t rejected_{0U};
+  std::atomic_uint64_t evictions_{0U};
+};
+
+}  // namespace adr
\ No newline at end of file
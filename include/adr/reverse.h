@@ -52,6 +52,11 @@ struct reverse {
                                  filter_type filter = filter_type::kNone) const;
   void add_street(import_context&, street_idx_t, osmium::Way const&);
   void write(import_context&);
+  void add_street_segments(reverse const&);
+  void add_street_segments(import_context&,
+                           street_idx_t,
+                           reverse const&,
+                           street_idx_t other_street);
   void build_rtree(typeahead const&);
   void write();
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "adr/guess_context.h"
+#include "adr/index_handle.h"
+
+namespace adr {
+
+struct shard_suggestion {
+  std::size_t shard_;
+  suggestion s_;
+};
+
+// Scatter-gather over regional shards (separate extracts): a query runs on
+// all shards in parallel, the results are merged by score. Results found in
+// several shards (same place OSM id or same street, house number and
+// position) are only returned once. Each shard is an
+// index_handle, so shards can be reloaded independently.
+struct shard_router {
+  // Per-query state (one per thread): a context for each shard, rebound
+  // when the shard was reloaded. generations_[i] pins the generation that
+  // the results of shard i refer to.
+  struct context {
+    std::vector<std::shared_ptr<index_generation const>> generations_;
+    std::vector<std::unique_ptr<guess_context>> ctxs_;
+  };
+
+  explicit shard_router(std::vector<std::filesystem::path> const& dirs,
+                        index_generation::config const& = {});
+
+  // Language indices differ between shards: languages are given as IANA
+  // tags and resolved per shard (the default language is always included).
+  std::vector<shard_suggestion> get_suggestions(
+      context&,
+      std::string const& input,
+      unsigned n_suggestions,
+      std::vector<std::string> const& languages,
+      std::optional<geo::latlng> const& coord,
+      float bias,
+      filter_type filter = filter_type::kNone) const;
+
+  std::vector<std::unique_ptr<index_handle>> shards_;
+};
+
+}  // namespace adr
\ No newline at end of file
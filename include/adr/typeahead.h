@@ -13,6 +13,7 @@
 #include "cista/containers/vecvec.h"
 
 #include "adr/categories.h"
+#include "adr/geo_cell.h"
 #include "adr/ngram.h"
 #include "adr/types.h"
 
@@ -28,6 +29,26 @@ struct population {
 
 struct import_context;
 struct guess_context;
+struct tag_class;
+
+struct geo_posting {
+  geo_cell_t cell_;
+  string_idx_t str_;
+};
+
+// Queries up to this length (in codepoints) are answered from the short
+// prefix index instead of the bigram index.
+constexpr auto const kMaxShortPrefix = 3U;
+constexpr auto const kShortPrefixTopK = 16U;
+
+// Positions of streets with the same name closer than this (in meters) are
+// merged into one cluster (see typeahead::cluster_street_positions).
+constexpr auto const kStreetClusterRadius = 1500.0;
+
+struct short_prefix_match {
+  place_idx_t place_;
+  string_idx_t str_;
+};
 
 template <typename Langs>
 std::int16_t find_lang(Langs const& langs, language_idx_t const l) {
@@ -48,28 +69,49 @@ struct typeahead {
   area_idx_t add_timezone_area(import_context&, osmium::TagList const&);
   area_idx_t add_admin_area(import_context&, osmium::TagList const&);
 
+  // The tag_class has to be classify_tags() of the given tags.
   void add_address(import_context&,
                    osmium::TagList const&,
+                   tag_class,
                    osmium::Location const&);
 
   street_idx_t add_street(import_context&,
                           osmium::TagList const&,
+                          tag_class,
                           osmium::Location const&);
 
   void add_place(import_context&,
                  std::int64_t id,
                  bool is_way,
                  osmium::TagList const&,
+                 tag_class,
                  osmium::Location const&);
 
+  // Reduces the positions collected by add_street() to one per cluster
+  // (kStreetClusterRadius) and stores them in street_pos_. Runs in parallel
+  // over street names after all streets have been added.
+  void cluster_street_positions(import_context&);
+
   void build_ngram_index();
+  void build_geo_ngram_index();
+  void build_short_prefix_index();
   bool verify();
 
   area_set_idx_t get_or_create_area_set(import_context&,
                                         basic_string_view<area_idx_t>);
 
+  bool is_globally_relevant(place_idx_t) const;
+
+  // Index into short_prefixes_ / short_prefix_matches_ for the given
+  // normalized prefix (up to kMaxShortPrefix codepoints).
+  std::optional<std::uint32_t> find_short_prefix(
+      std::string_view normalized_prefix) const;
+
   template <bool Debug>
-  void guess(std::string_view normalized, guess_context&) const;
+  void guess(std::string_view normalized,
+             guess_context&,
+             std::optional<geo::latlng> const& near = std::nullopt,
+             filter_type filter = filter_type::kNone) const;
 
   language_idx_t resolve_language(std::string_view s) const {
     auto const it = lang_.find(s);
@@ -114,8 +156,28 @@ struct typeahead {
 
   data::vector_map<string_idx_t, std::uint8_t> n_bigrams_;
 
+  // Numeric strings (house numbers, postal codes, see is_numeric()).
+  // Those without locations can't be found through the bigram index and are
+  // matched against the numeric query phrases directly instead.
+  data::bitvec numeric_strings_;
+
+  // Location types referenced by each string (kAddress = street,
+  // kPlace = regular place, kExtra = extra place). kNone for strings without
+  // locations (area names, house numbers, ...).
+  data::vector_map<string_idx_t, filter_type> string_types_;
+
   data::vecvec<ngram_t, string_idx_t, std::uint32_t> bigrams_;
 
+  // Bigram posting lists partitioned by coarse region:
+  // sorted by (geo cell, string) to look up the postings of a cell.
+  // Empty unless extracted with geo_index (see extract()).
+  data::vecvec<ngram_t, geo_posting, std::uint64_t> geo_bigrams_;
+
+  // Sorted normalized name prefixes of 1 to kMaxShortPrefix codepoints and
+  // their top kShortPrefixTopK places ranked by population.
+  data::vecvec<std::uint32_t, char> short_prefixes_;
+  data::vecvec<std::uint32_t, short_prefix_match> short_prefix_matches_;
+
   data::vecvec<string_idx_t, std::uint32_t> string_to_location_;
   data::vecvec<string_idx_t, location_type_t> string_to_type_;
 
@@ -16,11 +16,13 @@
 #include "cista/mmap.h"
 #include "cista/strong.h"
 
-namespace cista::raw {}
+namespace cista::offset {}
 
 namespace adr {
 
-namespace data = cista::raw;
+// Offset based containers: t.bin can be used directly from a read-only
+// memory mapping (see adr::read / load_mode::kMmap).
+namespace data = cista::offset;
 
 template <typename T>
 using mm_vec = cista::basic_mmap_vec<T, std::uint64_t>;
@@ -118,6 +120,8 @@ struct coordinates {
   double lat() const { return as_location().lat(); }
   double lon() const { return as_location().lon(); }
 
+  bool operator==(coordinates const&) const = default;
+
   std::int32_t lat_, lng_;
 };
 
@@ -11,7 +11,9 @@
 #include "utl/helpers/algorithm.h"
 #include "utl/parallel_for.h"
 #include "utl/timer.h"
+#include "utl/to_vec.h"
 #include "utl/verify.h"
+#include "utl/zip.h"
 
 #include "geo/box.h"
 
@@ -200,6 +202,65 @@ struct area_database::impl {
     }
   }
 
+  void add_area(
+      area_idx_t const area_idx,
+      std::span<std::pair<area_database const*, area_idx_t> const> parts) {
+    using ring_t = std::vector<coordinates>;
+
+    auto outer = std::vector<ring_t>{};
+    auto inner = std::vector<std::vector<ring_t>>{};
+    for (auto const& [db, a] : parts) {
+      auto const& src = *db->impl_;
+      for (auto const [outer_idx, outer_ring] :
+           utl::enumerate(src.outer_rings_[a])) {
+        auto ring = ring_t{begin(outer_ring), end(outer_ring)};
+        if (utl::find(outer, ring) != end(outer)) {
+          continue;
+        }
+        outer.emplace_back(std::move(ring));
+        inner.emplace_back(
+            utl::to_vec(src.inner_rings_[a][static_cast<unsigned>(outer_idx)],
+                        [](auto&& r) { return ring_t{begin(r), end(r)}; }));
+      }
+    }
+
+    assert(area_idx == outer_rings_.size());
+    assert(area_idx == inner_rings_.size());
+    outer_rings_.emplace_back(outer);
+    inner_rings_.emplace_back(inner);
+
+    polys_tmp_.clear();
+    auto box = geo::box{};
+    for (auto const [outer_ring, inner_rings] : utl::zip(outer, inner)) {
+      inner_tmp_.clear();
+      for (auto const& inner_ring : inner_rings) {
+        inner_tmp_.emplace_back(convert_ring(ring_tmp_, inner_ring));
+      }
+      for (auto const& c : outer_ring) {
+        box.extend(c);
+      }
+      auto const o = convert_ring(ring_tmp_, outer_ring);
+      polys_tmp_.emplace_back(tg_poly_new(o, inner_tmp_.data(),
+                                          static_cast<int>(inner_tmp_.size())));
+      for (auto const r : inner_tmp_) {
+        tg_ring_free(r);
+      }
+      tg_ring_free(o);
+    }
+
+    idx_.emplace_back(tg_geom_new_multipolygon(
+        polys_tmp_.data(), static_cast<int>(polys_tmp_.size())));
+    for (auto const p : polys_tmp_) {
+      tg_poly_free(p);
+    }
+
+    auto const min_corner = box.min_.lnglat();
+    auto const max_corner = box.max_.lnglat();
+    rtree_insert(
+        rtree_, min_corner.data(), max_corner.data(),
+        reinterpret_cast<void*>(static_cast<std::size_t>(to_idx(area_idx))));
+  }
+
   bool is_within(coordinates const c, area_idx_t const area) const {
     auto const point = tg_geom_new_point(tg_point{c.lon(), c.lat()});
     auto const result = tg_geom_within(point, idx_[to_idx(area)]);
@@ -207,6 +268,16 @@ struct area_database::impl {
     return result;
   }
 
+  geo::box get_bounds(area_idx_t const area) const {
+    auto box = geo::box{};
+    for (auto const& outer_ring : outer_rings_[area]) {
+      for (auto const& c : outer_ring) {
+        box.extend(c);
+      }
+    }
+    return box;
+  }
+
   std::filesystem::path p_;
   cista::mmap::protection mode_;
 
@@ -242,8 +313,18 @@ void area_database::add_area(area_idx_t const area_idx, osm::Area const& area) {
   impl_->add_area(area_idx, area);
 }
 
+void area_database::add_area(
+    area_idx_t const area_idx,
+    std::span<std::pair<area_database const*, area_idx_t> const> parts) {
+  impl_->add_area(area_idx, parts);
+}
+
 bool area_database::is_within(coordinates const c, area_idx_t area) const {
   return impl_->is_within(c, area);
 }
 
+geo::box area_database::get_bounds(area_idx_t const area) const {
+  return impl_->get_bounds(area);
+}
+
 }  // namespace adr
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <cista/mmap.h>
 
+#include <atomic>
+#include <chrono>
+
 #include "fmt/std.h"
 
 #include "cista/io.h"
@@ -22,11 +25,15 @@
 #include "utl/to_vec.h"
 #include "utl/zip.h"
 
+#include "tiles/fixed/convert.h"
+#include "tiles/fixed/fixed_geometry.h"
 #include "tiles/osm/hybrid_node_idx.h"
 #include "tiles/util_parallel.h"
 
+#include "adr/adr.h"
 #include "adr/area_database.h"
 #include "adr/import_context.h"
+#include "adr/osm_filter.h"
 #include "adr/reverse.h"
 #include "adr/typeahead.h"
 
@@ -50,45 +57,28 @@ struct feature_handler : public osmium::handler::Handler {
   void way(osmium::Way const& w) {
     if (!w.nodes().empty()) {
       auto const& tags = w.tags();
-      if (!tags.has_key("public_transport") && !tags.has_key("electrified") &&
-          !tags.has_key("railway") && !tags.has_key("waterway") &&
-          !tags.has_tag("information", "board") && !tags.has_key("tunnel") &&
-          !tags.has_tag("amenity", "toilets") &&
-          !tags.has_tag("natural", "wood") &&
-          !tags.has_tag("leisure", "playground") &&
-          !tags.has_tag("access", "false") &&
-          !tags.has_tag("amenity", "taxi")) {
-        if (tags.has_key("highway")) {
-          auto const street =
-              t_.add_street(ctx_, tags, w.nodes().front().location());
+      auto const c = classify_tags(tags);
+      if (c.is_relevant_way()) {
+        auto const l = w.nodes().front().location();
+        if (c.has(tag_class::kHighway)) {
+          auto const street = t_.add_street(ctx_, tags, c, l);
           if (street != street_idx_t::invalid()) {
             r_.add_street(ctx_, street, w);
           }
         } else {
-          t_.add_place(ctx_, w.id(), true, tags, w.nodes().front().location());
+          t_.add_place(ctx_, w.id(), true, tags, c, l);
         }
-        t_.add_address(ctx_, tags, w.nodes().front().location());
+        t_.add_address(ctx_, tags, c, l);
       }
     }
   }
 
   void node(osmium::Node const& n) {
     auto const& tags = n.tags();
-    if (!tags.has_tag("natural", "tree") &&
-        !tags.has_tag("natural", "tree_stump") &&
-        !tags.has_tag("emergency", "fire_hydrant") &&
-        !tags.has_key("public_transport") && /* stops from timetable */
-        !tags.has_key("highway") && /* named motorway_junction */
-        !tags.has_key("electrified") && !tags.has_key("railway") &&
-        !tags.has_tag("information", "board") && !tags.has_key("waterway") &&
-        !tags.has_key("tunnel") && !tags.has_tag("amenity", "toilets") &&
-        !tags.has_tag("natural", "wood") && !tags.has_key("traffic_sign") &&
-        !tags.has_tag("building", "industrial") &&
-        !tags.has_tag("amenity", "bicycle_rental") &&
-        !tags.has_tag("leisure", "playground") &&
-        !tags.has_tag("access", "false") && !tags.has_tag("amenity", "taxi")) {
-      t_.add_address(ctx_, tags, n.location());
-      t_.add_place(ctx_, n.id(), false, tags, n.location());
+    auto const c = classify_tags(tags);
+    if (c.is_relevant_node()) {
+      t_.add_address(ctx_, tags, c, n.location());
+      t_.add_place(ctx_, n.id(), false, tags, c, n.location());
     }
   }
 
@@ -139,11 +129,9 @@ struct feature_handler : public osmium::handler::Handler {
     }
     auto const loc = ring_it->front().location();
 
-    t_.add_address(ctx_, tags, loc);
-
-    if (tags.has_key("name")) {
-      t_.add_place(ctx_, a.id(), true, tags, loc);
-    }
+    auto const c = classify_tags(tags);
+    t_.add_address(ctx_, tags, c, loc);
+    t_.add_place(ctx_, a.id(), true, tags, c, loc);
   }
 
   area_database& area_db_;
@@ -153,9 +141,45 @@ struct feature_handler : public osmium::handler::Handler {
   std::mutex& areas_mutex_;
 };
 
+// Busy time and processed items of one pipeline stage.
+struct stage_stats {
+  using clock = std::chrono::steady_clock;
+
+  void add(clock::time_point const start, std::uint64_t const items) {
+    ns_ += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             start)
+            .count());
+    items_ += items;
+  }
+
+  void print(std::string_view name,
+             std::string_view unit,
+             double const wall_seconds) const {
+    auto const busy_seconds = static_cast<double>(ns_) / 1E9;
+    auto const items = static_cast<double>(items_);
+    std::clog << fmt::format(
+        "  {:<8} {:>14} {:<9} busy {:>8.2f}s  {:>12.0f} {}/s busy  {:>12.0f} "
+        "{}/s wall\n",
+        name, items_.load(), unit, busy_seconds,
+        busy_seconds == 0.0 ? 0.0 : items / busy_seconds, unit,
+        wall_seconds == 0.0 ? 0.0 : items / wall_seconds, unit);
+  }
+
+  std::atomic_uint64_t ns_{0U};
+  std::atomic_uint64_t items_{0U};
+};
+
+// Pass 1 pipeline token: a decoded block and its node locations.
+struct node_block {
+  osm_mem::Buffer buf_;
+  std::vector<std::pair<osmium::object_id_type, tiles::fixed_xy>> nodes_;
+};
+
 void extract(std::filesystem::path const& in_path,
              std::filesystem::path const& out_path,
-             std::filesystem::path const& tmp_dname) {
+             std::filesystem::path const& tmp_dname,
+             bool const geo_index) {
   auto ec = std::error_code{};
   std::filesystem::create_directories(out_path, ec);
 
@@ -195,12 +219,75 @@ void extract(std::filesystem::path const& in_path,
 
     auto reader = osm_io::Reader{input_file, osm_eb::node | osm_eb::relation,
                                  osmium::io::read_meta::no};
-    while (auto buffer = reader.read()) {
-      pt->update(reader.offset());
-      osm::apply(buffer, node_idx_builder, mp_manager);
-    }
+
+    // read (serial) -> node locations (parallel) -> node index (serial,
+    // in order: the builder requires ascending node ids, so the per block
+    // runs are merged by concatenation) | relations (serial, in order).
+    auto read_stats = stage_stats{};
+    auto convert_stats = stage_stats{};
+    auto index_stats = stage_stats{};
+    auto relation_stats = stage_stats{};
+    auto const pass_start = stage_stats::clock::now();
+    oneapi::tbb::parallel_pipeline(
+        std::thread::hardware_concurrency() * 4U,
+        oneapi::tbb::make_filter<void, node_block>(
+            oneapi::tbb::filter_mode::serial_in_order,
+            [&](oneapi::tbb::flow_control& fc) {
+              auto const start = stage_stats::clock::now();
+              auto block = node_block{.buf_ = reader.read()};
+              pt->update(reader.offset());
+              if (!block.buf_) {
+                fc.stop();
+              }
+              read_stats.add(start, block.buf_ ? block.buf_.committed() : 0U);
+              return block;
+            }) &
+            oneapi::tbb::make_filter<node_block, node_block>(
+                oneapi::tbb::filter_mode::parallel,
+                [&](node_block&& block) {
+                  auto const start = stage_stats::clock::now();
+                  for (auto const& n : block.buf_.select<osmium::Node>()) {
+                    auto const l = n.location();
+                    block.nodes_.emplace_back(
+                        n.id(), tiles::latlng_to_fixed({l.lat(), l.lon()}));
+                  }
+                  convert_stats.add(start, block.nodes_.size());
+                  return std::move(block);
+                }) &
+            oneapi::tbb::make_filter<node_block, node_block>(
+                oneapi::tbb::filter_mode::serial_in_order,
+                [&](node_block&& block) {
+                  auto const start = stage_stats::clock::now();
+                  for (auto const& [id, xy] : block.nodes_) {
+                    node_idx_builder.push(id, xy);
+                  }
+                  index_stats.add(start, block.nodes_.size());
+                  block.nodes_ = {};
+                  return std::move(block);
+                }) &
+            oneapi::tbb::make_filter<node_block, void>(
+                oneapi::tbb::filter_mode::serial_in_order,
+                [&](node_block&& block) {
+                  auto const start = stage_stats::clock::now();
+                  auto n_relations = std::uint64_t{0U};
+                  for (auto const& r : block.buf_.select<osmium::Relation>()) {
+                    mp_manager.relation(r);
+                    ++n_relations;
+                  }
+                  relation_stats.add(start, n_relations);
+                }));
     reader.close();
 
+    auto const wall_seconds =
+        std::chrono::duration<double>{stage_stats::clock::now() - pass_start}
+            .count();
+    std::clog << fmt::format("Pass 1 throughput ({:.2f}s wall):\n",
+                             wall_seconds);
+    read_stats.print("read", "bytes", wall_seconds);
+    convert_stats.print("decode", "nodes", wall_seconds);
+    index_stats.print("index", "nodes", wall_seconds);
+    relation_stats.print("relation", "relations", wall_seconds);
+
     mp_manager.prepare_for_lookup();
     std::clog << "Multipolygon Manager Memory:\n";
     osm_rel::print_used_memory(std::clog, mp_manager.used_memory());
@@ -262,9 +349,7 @@ void extract(std::filesystem::path const& in_path,
   {  // Copy data from context to typeahead (not possible before, because vecvec
      // requires to build indices 0, ..., N in order).
     UTL_START_TIMING(copy_data);
-    for (auto const b : ctx.street_pos_) {
-      t.street_pos_.emplace_back(b);
-    }
+    t.cluster_street_positions(ctx);
     for (auto const b : ctx.house_numbers_) {
       t.house_numbers_.emplace_back(b);
     }
@@ -367,6 +452,10 @@ void extract(std::filesystem::path const& in_path,
     ctx.street_names_ = {};
 
     t.build_ngram_index();
+    if (geo_index) {
+      t.build_geo_ngram_index();
+    }
+    t.build_short_prefix_index();
 
     t.ext_start_ = t.place_names_.size();
 
@@ -377,7 +466,7 @@ void extract(std::filesystem::path const& in_path,
 
   {  // Write to disk.
     auto const timer = utl::scoped_timer{"write typeahead"};
-    cista::write(out_path / "t.bin", t);
+    write(out_path / "t.bin", t);
   }
 
   {
@@ -16,6 +16,8 @@
 #include "cista/containers/flat_matrix.h"
 
 #include "adr/bitmask.h"
+#include "adr/query_profile.h"
+#include "adr/result_cache.h"
 #include "adr/score.h"
 #include "adr/trace.h"
 #include "adr/typeahead.h"
@@ -24,8 +26,6 @@ namespace sv = std::views;
 
 namespace adr {
 
-constexpr auto const kMaxScoredMatches = std::size_t{10000};
-
 struct area {
   friend bool operator==(area const& a, area const& b) {
     return a.area_ == b.area_;
@@ -54,6 +54,33 @@ float get_category_score(amenity_category const x) {
   }
 }
 
+bool is_numeric_string(typeahead const& t, string_idx_t const str) {
+  return to_idx(str) < t.numeric_strings_.size() &&
+         t.numeric_strings_.test(to_idx(str));
+}
+
+// House numbers and postal codes repeat across many streets and areas:
+// score each numeric string only once per query.
+phrase_match_scores_t const& get_numeric_phrase_match_scores(
+    typeahead const& t,
+    guess_context& ctx,
+    token_bitmask_t const numeric_tokens_mask,
+    string_idx_t const str) {
+  auto const [it, inserted] = ctx.numeric_phrase_match_scores_.try_emplace(str);
+  auto& scores = it->second;
+  if (inserted) {
+    for (auto const [j, p] : utl::enumerate(ctx.phrases_)) {
+      scores[j] = (p.token_bits_ & numeric_tokens_mask) == p.token_bits_
+                      ? get_match_score(t.strings_[str].view(), p.s_,
+                                        ctx.sift4_offset_arr_,
+                                        ctx.normalize_buf_, ctx.phrase_mem_,
+                                        ctx.s_tokens_mem_)
+                      : kNoMatch;
+    }
+  }
+  return scores;
+}
+
 void activate_areas(typeahead const& t,
                     guess_context& ctx,
                     token_bitmask_t const numeric_tokens_mask,
@@ -91,12 +118,16 @@ void activate_areas(typeahead const& t,
           continue;
         }
 
-        auto const area_name =
-            t.strings_[t.area_names_[area][static_cast<std::uint8_t>(lang_idx)]]
-                .view();
-        auto const lang_match_score = get_match_score(
-            area_name, area_p.s_, ctx.sift4_offset_arr_, ctx.normalize_buf_,
-            ctx.phrase_mem_, ctx.s_tokens_mem_);
+        auto const area_name_idx =
+            t.area_names_[area][static_cast<std::uint8_t>(lang_idx)];
+        auto const lang_match_score =
+            t.area_admin_level_[area] == kPostalCodeAdminLevel &&
+                    is_numeric_string(t, area_name_idx)
+                ? get_numeric_phrase_match_scores(t, ctx, numeric_tokens_mask,
+                                                  area_name_idx)[j]
+                : get_match_score(t.strings_[area_name_idx].view(), area_p.s_,
+                                  ctx.sift4_offset_arr_, ctx.normalize_buf_,
+                                  ctx.phrase_mem_, ctx.s_tokens_mem_);
         if (lang_match_score < score) {
           score = lang_match_score;
           lang = static_cast<std::uint8_t>(lang_idx);
@@ -106,23 +137,36 @@ void activate_areas(typeahead const& t,
   }
 }
 
+bool is_within(std::optional<geo::box> const& bbox, coordinates const c) {
+  return !bbox.has_value() || bbox->contains(c.as_latlng());
+}
+
 template <bool Debug>
 void match_streets(token_bitmask_t const all_tokens_mask,
                    token_bitmask_t const numeric_tokens_mask,
                    typeahead const& t,
                    guess_context& ctx,
-                   std::vector<std::string> const& tokens,
-                   language_list_t const languages) {
+                   std::span<std::string_view const> tokens,
+                   language_list_t const languages,
+                   std::optional<geo::box> const& bbox) {
   UTL_START_TIMING(t);
 
   trace("NUMERIC_TOKENS={}", bitmask{numeric_tokens_mask});
 
-  for (auto const [street_edit_dist, street_p_idx, str_idx, street] :
-       ctx.scored_street_matches_) {
+  for (auto const [i, m] : utl::enumerate(ctx.scored_street_matches_)) {
+    if (ctx.budget_.stop_before(i)) {
+      trace("STREETS: budget exhausted after {} candidates", i);
+      break;
+    }
+
+    auto const [street_edit_dist, street_p_idx, str_idx, street] = m;
     ctx.area_match_items_.clear();
 
     for (auto const [index, area_set] :
          utl::enumerate(t.street_areas_[street])) {
+      if (!is_within(bbox, t.street_pos_[street][index])) {
+        continue;
+      }
       ctx.area_match_items_[area_set].emplace_back(match_item{
           .type_ = match_item::type::kStreet,
           .score_ = 0.0F,
@@ -132,8 +176,21 @@ void match_streets(token_bitmask_t const all_tokens_mask,
     }
 
     auto index = 0U;
-    for (auto const [hn, areas_idx] :
-         utl::zip(t.house_numbers_[street], t.house_areas_[street])) {
+    for (auto const [hn, areas_idx, hn_pos] :
+         utl::zip(t.house_numbers_[street], t.house_areas_[street],
+                  t.house_coordinates_[street])) {
+      if (ctx.budget_.stop_within(ctx.phrases_.size())) {
+        trace("STREETS: budget exhausted after {} house numbers", index);
+        break;
+      }
+      if (!is_within(bbox, hn_pos)) {
+        ++index;
+        continue;
+      }
+      auto const numeric_scores =
+          is_numeric_string(t, hn) ? &get_numeric_phrase_match_scores(
+                                         t, ctx, numeric_tokens_mask, hn)
+                                   : nullptr;
       for (auto const [hn_p_idx, p] : utl::enumerate(ctx.phrases_)) {
         if ((p.token_bits_ & numeric_tokens_mask) != p.token_bits_) {
           trace("[{}] {} HOUSENUMBER: {} is not numeric", street,
@@ -142,9 +199,12 @@ void match_streets(token_bitmask_t const all_tokens_mask,
           continue;
         }
 
-        auto const hn_score = get_match_score(
-            t.strings_[hn].view(), p.s_, ctx.sift4_offset_arr_,
-            ctx.normalize_buf_, ctx.phrase_mem_, ctx.s_tokens_mem_);
+        auto const hn_score =
+            numeric_scores != nullptr
+                ? (*numeric_scores)[hn_p_idx]
+                : get_match_score(t.strings_[hn].view(), p.s_,
+                                  ctx.sift4_offset_arr_, ctx.normalize_buf_,
+                                  ctx.phrase_mem_, ctx.s_tokens_mem_);
         if (hn_score == kNoMatch) {
           trace("[{}] {} HOUSENUMBER: {} vs {} no match", street,
                 t.strings_[t.street_names_[street][kDefaultLangIdx]].view(),
@@ -333,13 +393,18 @@ void match_places(token_bitmask_t const all_tokens_mask,
                   token_bitmask_t const numeric_tokens_mask,
                   typeahead const& t,
                   guess_context& ctx,
-                  std::vector<std::string> const& tokens,
+                  std::span<std::string_view const> tokens,
                   language_list_t const& languages) {
   UTL_START_TIMING(t);
 
   auto ii = 0U;
   for (auto const [place_edit_dist, place_p_idx, str_idx, place] :
        ctx.scored_place_matches_) {
+    if (ctx.budget_.stop_before(ii)) {
+      trace("PLACES: budget exhausted after {} candidates", ii);
+      break;
+    }
+
     auto const area_set_idx = t.place_areas_[place];
 
     trace("[{}] {}: edit_dist={}, phrase={}, type={}", ii,
@@ -497,6 +562,13 @@ void compute_string_phrase_match_scores(guess_context& ctx,
   UTL_START_TIMING(t);
   ctx.string_phrase_match_scores_.resize(ctx.string_matches_.size());
   for (auto const [i, m] : utl::enumerate(ctx.string_matches_)) {
+    if (ctx.budget_.stop_before(i, ctx.phrases_.size())) {
+      // Keep the best (by cos sim) candidates scored so far.
+      trace("match scores: budget exhausted after {} candidates", i);
+      ctx.string_matches_.resize(i);
+      ctx.string_phrase_match_scores_.resize(i);
+      break;
+    }
     for (auto const [j, p] : utl::enumerate(ctx.phrases_)) {
       ctx.string_phrase_match_scores_[i][j] = get_match_score(
           t.strings_[m.idx_].view(), p.s_, ctx.sift4_offset_arr_,
@@ -507,18 +579,19 @@ void compute_string_phrase_match_scores(guess_context& ctx,
   trace("match scores [{} ms]", UTL_TIMING_MS(t));
 }
 
-template <bool Debug>
-void get_scored_matches(
-    typeahead const& t,
-    guess_context& ctx,
-    language_list_t const&,
-    filter_type const filter,
-    std::function<bool(adr::place_idx_t)> const& place_filter) {
+template <bool Debug, typename PlaceFilter>
+void get_scored_matches(typeahead const& t,
+                        guess_context& ctx,
+                        language_list_t const&,
+                        filter_type const filter,
+                        std::optional<geo::box> const& bbox,
+                        PlaceFilter&& place_filter) {
   UTL_START_TIMING(t);
 
   ctx.scored_street_matches_.clear();
   ctx.scored_place_matches_.clear();
 
+  auto const max_scored_matches = ctx.limits_.max_scored_matches_;
   for (auto const [i, m] : utl::enumerate(ctx.string_matches_)) {
     for (auto p_idx = phrase_idx_t{0U}; p_idx != ctx.phrases_.size(); ++p_idx) {
       auto const p_match_score = ctx.string_phrase_match_scores_[i][p_idx];
@@ -542,7 +615,20 @@ void get_scored_matches(
                     street_idx, ctx.phrases_[p_idx].s_);
               continue;
             }
-            if (ctx.scored_street_matches_.size() != kMaxScoredMatches ||
+            auto const street_in_bbox = [&]() {
+              auto const in_bbox = [&](coordinates const c) {
+                return is_within(bbox, c);
+              };
+              return !bbox.has_value() ||
+                     utl::any_of(t.street_pos_[street_idx], in_bbox) ||
+                     utl::any_of(t.house_coordinates_[street_idx], in_bbox);
+            };
+            if (!street_in_bbox()) {
+              trace("  -> STREET {} [phrase={:?}]  => outside bbox",
+                    street_idx, ctx.phrases_[p_idx].s_);
+              continue;
+            }
+            if (ctx.scored_street_matches_.size() != max_scored_matches ||
                 ctx.scored_street_matches_.back().score_ > p_match_score) {
               utl::insert_sorted(ctx.scored_street_matches_,
                                  {.score_ = p_match_score,
@@ -550,7 +636,7 @@ void get_scored_matches(
                                   .string_idx_ = m.idx_,
                                   .idx_ = street_idx});
               ctx.scored_street_matches_.resize(std::min(
-                  kMaxScoredMatches, ctx.scored_street_matches_.size()));
+                  max_scored_matches, ctx.scored_street_matches_.size()));
               trace("  -> STREET {} [phrase={:?}]", street_idx,
                     ctx.phrases_[p_idx].s_);
             } else {
@@ -571,12 +657,17 @@ void get_scored_matches(
                     place_idx, ctx.phrases_[p_idx].s_);
               continue;
             }
-            if (place_filter && !place_filter(place_idx)) {
+            if (!is_within(bbox, t.place_coordinates_[place_idx])) {
+              trace("  -> PLACE {} [phrase={:?}]  => outside bbox", place_idx,
+                    ctx.phrases_[p_idx].s_);
+              continue;
+            }
+            if (!place_filter(place_idx)) {
               trace("  -> PLACE {} [phrase={:?}] => place filter function",
                     place_idx, ctx.phrases_[p_idx].s_);
               continue;
             }
-            if (ctx.scored_place_matches_.size() != kMaxScoredMatches ||
+            if (ctx.scored_place_matches_.size() != max_scored_matches ||
                 ctx.scored_place_matches_.back().score_ > p_match_score) {
               utl::insert_sorted(ctx.scored_place_matches_,
                                  {.score_ = p_match_score,
@@ -584,7 +675,7 @@ void get_scored_matches(
                                   .string_idx_ = m.idx_,
                                   .idx_ = place_idx});
               ctx.scored_place_matches_.resize(std::min(
-                  kMaxScoredMatches, ctx.scored_place_matches_.size()));
+                  max_scored_matches, ctx.scored_place_matches_.size()));
               trace("  -> PLACE {} [phrase={:?}]", place_idx,
                     ctx.phrases_[p_idx].s_);
             } else {
@@ -600,10 +691,115 @@ void get_scored_matches(
     }
   }
 
+  // Adaptive cutoff: drop matches far behind the best one.
+  ctx.scored_street_matches_.resize(
+      ctx.limits_.get_score_limit(ctx.scored_street_matches_));
+  ctx.scored_place_matches_.resize(
+      ctx.limits_.get_score_limit(ctx.scored_place_matches_));
+
   UTL_STOP_TIMING(t);
   trace("score matches [{} ms]", UTL_TIMING_MS(t));
 }
 
+// Resolves the place filter once: the per candidate check is inlined.
+template <typename Fn>
+void with_place_filter(place_filter const& allowed_places, Fn&& fn) {
+  if (allowed_places.allowed_ != nullptr) {
+    auto const& allowed = *allowed_places.allowed_;
+    fn([&](place_idx_t const p) {
+      return to_idx(p) < allowed.size() && allowed.test(to_idx(p));
+    });
+  } else if (allowed_places.fn_) {
+    fn(allowed_places.fn_);
+  } else {
+    fn([](place_idx_t) { return true; });
+  }
+}
+
+// Inputs of up to kMaxShortPrefix characters: bigram similarity is
+// meaningless, suggest the most popular places with this name prefix
+// instead. Only names in the default or a requested language match.
+template <bool Debug>
+void get_short_prefix_suggestions(typeahead const& t,
+                                  guess_context& ctx,
+                                  std::string_view normalized,
+                                  unsigned const n_suggestions,
+                                  language_list_t const& languages,
+                                  filter_type const filter,
+                                  place_filter const& allowed_places,
+                                  std::optional<geo::box> const& bbox) {
+  auto const prefix_idx = t.find_short_prefix(normalized);
+  trace("short prefix {:?}: {}", normalized, prefix_idx.has_value());
+  if (!prefix_idx.has_value()) {
+    return;
+  }
+
+  auto const is_requested_lang = [&](short_prefix_match const& m) {
+    auto const names = t.place_names_[m.place_];
+    auto const it = utl::find(names, m.str_);
+    if (it == end(names)) {
+      return false;
+    }
+    auto const lang = t.place_name_lang_[m.place_][static_cast<unsigned>(
+        std::distance(begin(names), it))];
+    return lang == kDefaultLang || utl::find(languages, lang) != end(languages);
+  };
+
+  with_place_filter(allowed_places, [&](auto&& is_allowed) {
+    for (auto const [i, m] :
+         utl::enumerate(t.short_prefix_matches_[*prefix_idx])) {
+      if (ctx.suggestions_.size() == n_suggestions) {
+        break;
+      }
+      auto const required =
+          t.place_type_[m.place_] == amenity_category::kExtra
+              ? filter_type::kExtra
+              : filter_type::kPlace;
+      if (!allows(filter, required) ||
+          !is_within(bbox, t.place_coordinates_[m.place_]) ||
+          !is_allowed(m.place_) || !is_requested_lang(m)) {
+        continue;
+      }
+      ctx.suggestions_.emplace_back(
+          suggestion{.str_ = m.str_,
+                     .location_ = m.place_,
+                     .coordinates_ = t.place_coordinates_[m.place_],
+                     .area_set_ = t.place_areas_[m.place_],
+                     .matched_area_lang_ = {},
+                     .matched_areas_ = 0U,
+                     .matched_tokens_ = 1U,
+                     .score_ = static_cast<float>(i)});
+    }
+  });
+
+  for (auto& s : ctx.suggestions_) {
+    s.populate_areas(t);
+  }
+}
+
+// Adds the total time to the context's query profile and passes the profile
+// to the query metrics (if any) on every return path of get_suggestions().
+struct query_scope {
+  explicit query_scope(guess_context& ctx)
+      : ctx_{ctx}, start_{query_profile::clock::now()} {
+    ctx_.profile_.reset();
+  }
+
+  query_scope(query_scope const&) = delete;
+  query_scope& operator=(query_scope const&) = delete;
+
+  ~query_scope() {
+    ctx_.profile_.add(query_stage::kTotal,
+                      query_profile::clock::now() - start_);
+    if (ctx_.query_metrics_ != nullptr) {
+      ctx_.query_metrics_->add(ctx_.profile_);
+    }
+  }
+
+  guess_context& ctx_;
+  query_profile::clock::time_point start_;
+};
+
 template <bool Debug>
 std::vector<token> get_suggestions(
     typeahead const& t,
@@ -614,24 +810,42 @@ std::vector<token> get_suggestions(
     std::optional<geo::latlng> const& coord,
     float const bias,
     filter_type const filter,
-    std::function<bool(adr::place_idx_t)> const& place_filter,
+    place_filter const& allowed_places,
     std::optional<geo::box> const& bbox) {
   UTL_START_TIMING(t);
 
+  auto const scope = query_scope{ctx};
+  auto& profile = ctx.profile_;
+  ctx.budget_.start();
+  auto stopwatch = query_profile::stopwatch{profile};
+
   ctx.suggestions_.clear();
-  if (in.size() < 3) {
-    return {};
+  ctx.reset_arena();
+  auto& arena = *ctx.arena_;
+
+  auto const normalized_in = std::string{normalize(in, ctx.normalize_buf_)};
+  if (utf8_codepoint_count(normalized_in) <= kMaxShortPrefix) {
+    if (normalized_in.empty()) {
+      return {};
+    }
+    profile.short_prefix_ = true;
+    get_short_prefix_suggestions<Debug>(t, ctx, normalized_in, n_suggestions,
+                                        languages, filter, allowed_places,
+                                        bbox);
+    return {token{0U, static_cast<std::uint16_t>(in.size())}};
   }
 
   auto token_pos = std::vector<token>{};
-  auto tokens = std::vector<std::string>{};
+  auto tokens = std::pmr::vector<std::string_view>{&arena};
   auto all_tokens_mask = token_bitmask_t{0U};
+  auto token_mem = std::string{};
   utl::for_each_token(utl::cstr{in}, ' ', [&, i = 0U](utl::cstr tok) mutable {
     if (tok.empty()) {
       return;
     }
-    tokens.emplace_back(normalize(tok.view(), ctx.normalize_buf_));
-    erase_fillers(tokens.back());
+    token_mem = normalize(tok.view(), ctx.normalize_buf_);
+    erase_fillers(token_mem);
+    tokens.emplace_back(arena.copy(token_mem));
     all_tokens_mask |= 1U << (i++);
 
     token_pos.push_back(
@@ -639,7 +853,39 @@ std::vector<token> get_suggestions(
               static_cast<std::uint16_t>(tok.length())});
   });
   tokens.resize(std::min(tokens.size(), kMaxTokens));
-  ctx.phrases_ = get_sorted_phrases(tokens);
+  profile.n_tokens_ = static_cast<std::uint32_t>(tokens.size());
+
+  // Place filters can't be part of the cache key: don't cache those queries.
+  auto const use_result_cache = !Debug && ctx.result_cache_ != nullptr &&
+                                allowed_places.allowed_ == nullptr &&
+                                !allowed_places.fn_;
+  auto const query_coord = use_result_cache && coord.has_value()
+                               ? std::optional{result_cache::quantize(*coord)}
+                               : coord;
+  // guess() input: the full normalized input (punctuation, repeated spaces
+  // and tokens after kMaxTokens included) plus exact token alternatives.
+  auto guess_str = normalized_in;
+  for (auto const& token : tokens) {
+    if (auto const alt = get_exact_alt(token); alt.has_value()) {
+      guess_str += *alt;
+    }
+  }
+
+  auto cache_key = std::string{};
+  if (use_result_cache) {
+    cache_key = result_cache::make_key(guess_str, tokens, languages, filter,
+                                       n_suggestions, coord, bias, bbox);
+    if (auto const cached = ctx.result_cache_->get(cache_key);
+        cached != nullptr) {
+      ctx.suggestions_ = cached->suggestions_;
+      profile.result_cache_hit_ = true;
+      stopwatch.lap(query_stage::kTokenize);
+      return token_pos;
+    }
+  }
+
+  get_sorted_phrases(tokens, ctx.phrase_mem_, ctx.phrases_);
+  ctx.numeric_phrase_match_scores_.clear();
 
   trace("tokens: {}, phrases: {}, languages={}", tokens,
         ctx.phrases_ | sv::transform([](auto&& x) { return x.s_; }),
@@ -647,13 +893,15 @@ std::vector<token> get_suggestions(
           return t.lang_names_[lang].view();
         }));
 
-  auto guess_str = std::string{normalize(in, ctx.normalize_buf_)};
-  for (auto const& token : tokens) {
-    if (auto const alt = get_exact_alt(token); alt.has_value()) {
-      guess_str += *alt;
-    }
-  }
-  t.guess<Debug>(guess_str, ctx);
+  stopwatch.lap(query_stage::kTokenize);
+
+  // guess() adds the count and cos sim stages itself.
+  t.guess<Debug>(
+      guess_str, ctx,
+      ctx.geo_candidates_ ? query_coord : std::optional<geo::latlng>{}, filter);
+  profile.n_string_matches_ =
+      static_cast<std::uint32_t>(ctx.string_matches_.size());
+  stopwatch.restart();
 
   compute_string_phrase_match_scores<Debug>(ctx, t);
 
@@ -661,23 +909,38 @@ std::vector<token> get_suggestions(
 
   auto const numeric_tokens_mask = get_numeric_tokens_mask(tokens);
 
-  get_scored_matches<Debug>(t, ctx, languages, filter, place_filter);
+  with_place_filter(allowed_places, [&](auto&& is_allowed) {
+    get_scored_matches<Debug>(t, ctx, languages, filter, bbox, is_allowed);
+  });
+  profile.n_street_matches_ =
+      static_cast<std::uint32_t>(ctx.scored_street_matches_.size());
+  profile.n_place_matches_ =
+      static_cast<std::uint32_t>(ctx.scored_place_matches_.size());
+  stopwatch.lap(query_stage::kPhraseScore);
 
   match_streets<Debug>(all_tokens_mask, numeric_tokens_mask, t, ctx, tokens,
-                       languages);
+                       languages, bbox);
+  stopwatch.lap(query_stage::kStreetMatch);
+
   match_places<Debug>(all_tokens_mask, numeric_tokens_mask, t, ctx, tokens,
                       languages);
+  stopwatch.lap(query_stage::kPlaceMatch);
+  profile.n_suggestions_ = static_cast<std::uint32_t>(ctx.suggestions_.size());
 
   UTL_STOP_TIMING(t);
   trace("{} suggestions [{} ms]", ctx.suggestions_.size(), UTL_TIMING_MS(t));
 
   if (ctx.suggestions_.empty()) {
+    profile.truncated_ = ctx.budget_.truncated();
+    if (use_result_cache && !profile.truncated_) {
+      ctx.result_cache_->add(std::move(cache_key), {});
+    }
     return token_pos;
   }
 
-  if (coord.has_value()) {
+  if (query_coord.has_value()) {
     for (auto& s : ctx.suggestions_) {
-      auto const dist = geo::distance(s.coordinates_.as_latlng(), *coord);
+      auto const dist = geo::distance(s.coordinates_.as_latlng(), *query_coord);
 
       auto dist_bonus = 0.F;
       if (dist < 2'000) {
@@ -694,17 +957,11 @@ std::vector<token> get_suggestions(
     }
   }
 
-  if (bbox.has_value()) {
-    std::erase_if(ctx.suggestions_, [&](suggestion const& s) {
-      return !bbox->contains(s.coordinates_.as_latlng());
-    });
-  }
-
   // MARK DUPLICATES
   {
     // Create sorted permutation.
     // Sort by (location, score) to keep best scored entry for each location.
-    auto sorted = std::vector<std::uint32_t>{};
+    auto sorted = std::pmr::vector<std::uint32_t>{&arena};
     sorted.resize(ctx.suggestions_.size());
     std::generate(begin(sorted), end(sorted),
                   [i = 0U]() mutable { return i++; });
@@ -762,6 +1019,13 @@ std::vector<token> get_suggestions(
     }
   }
 
+  profile.truncated_ = ctx.budget_.truncated();
+  if (use_result_cache && !profile.truncated_) {
+    ctx.result_cache_->add(std::move(cache_key), ctx.suggestions_);
+  }
+
+  stopwatch.lap(query_stage::kFinalize);
+
   if constexpr (Debug) {
     for (auto const [i, s] : utl::enumerate(ctx.suggestions_)) {
       std::cout << "[" << i << "]\t";
@@ -781,7 +1045,7 @@ template std::vector<token> get_suggestions<true>(
     std::optional<geo::latlng> const&,
     float,
     filter_type,
-    std::function<bool(place_idx_t)> const&,
+    place_filter const&,
     std::optional<geo::box> const&);
 
 template std::vector<token> get_suggestions<false>(
@@ -793,7 +1057,7 @@ template std::vector<token> get_suggestions<false>(
     std::optional<geo::latlng> const&,
     float,
     filter_type,
-    std::function<bool(place_idx_t)> const&,
+    place_filter const&,
     std::optional<geo::box> const&);
 
 }  // namespace adr
@@ -151,4 +151,58 @@ void guess_context::resize(typeahead const& t) {
   area_active_.resize(t.area_names_.size());
 }
 
+void guess_context::reset_arena() {
+  // Drop the arena buffers before they are handed out again.
+  phrases_ = std::pmr::vector<query_phrase>{arena_.get()};
+  arena_->reset();
+}
+
+template <typename Vec>
+std::size_t capacity_bytes(Vec const& v) {
+  return v.capacity() * sizeof(typename Vec::value_type);
+}
+
+// Approximation: one bucket (8 bytes) and one value slot per bucket.
+template <typename Map>
+std::size_t map_bytes(Map const& m) {
+  return m.bucket_count() * (sizeof(typename Map::value_type) + 8U);
+}
+
+std::size_t candidate_limits::get_cos_sim_limit(
+    std::vector<cos_sim_match> const& v) const {
+  if (cos_sim_ratio_ <= 0.0F || v.empty()) {
+    return std::min(v.size(), max_matches_);
+  }
+  auto best = v.front().cos_sim_;
+  for (auto const& m : v) {
+    best = std::max(best, m.cos_sim_);
+  }
+  auto const threshold = best * cos_sim_ratio_;
+  auto const n = static_cast<std::size_t>(
+      std::count_if(begin(v), end(v), [&](cos_sim_match const& m) {
+        return m.cos_sim_ >= threshold;
+      }));
+  return std::min(std::clamp(n, min_matches_, max_matches_), v.size());
+}
+
+std::size_t guess_context::memory_usage() const {
+  auto bytes = sizeof(guess_context) + arena_->capacity();
+  bytes += phrase_mem_.capacity() + capacity_bytes(sift4_offset_arr_) +
+           capacity_bytes(s_tokens_mem_) + capacity_bytes(suggestions_) +
+           capacity_bytes(string_matches_) + area_active_.capacity() / 8U +
+           capacity_bytes(window_counts_) + capacity_bytes(window_strings_) +
+           capacity_bytes(string_phrase_match_scores_) +
+           capacity_bytes(scored_street_matches_) +
+           capacity_bytes(scored_place_matches_);
+  bytes += area_phrase_match_scores_.size() * sizeof(phrase_match_scores_t) +
+           area_phrase_lang_.size() * sizeof(phrase_lang_t);
+  bytes += map_bytes(geo_match_counts_) +
+           map_bytes(numeric_phrase_match_scores_) +
+           map_bytes(item_matched_masks_) + map_bytes(area_match_items_);
+  for (auto const& [set_idx, items] : area_match_items_) {
+    bytes += capacity_bytes(items);
+  }
+  return bytes;
+}
+
 }  // namespace adr
\ No newline at end of file
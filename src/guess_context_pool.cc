@@ -0,0 +1,98 @@
+#include "adr/guess_context_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "utl/verify.h"
+
+namespace adr {
+
+guess_context_pool::lease::lease(guess_context_pool& pool,
+                                 std::shared_ptr<index_generation const> g,
+                                 std::unique_ptr<entry> e)
+    : pool_{&pool}, generation_{std::move(g)}, entry_{std::move(e)} {}
+
+guess_context_pool::lease::~lease() {
+  if (entry_ != nullptr) {
+    pool_->release(std::move(entry_));
+  }
+}
+
+guess_context_pool::guess_context_pool(index_handle const& index,
+                                       config const& c)
+    : index_{index}, config_{c} {
+  utl::verify(config_.max_size_ != 0U, "guess_context_pool: max_size = 0");
+}
+
+guess_context_pool::lease guess_context_pool::acquire() {
+  auto const g = index_.get();
+
+  auto e = std::unique_ptr<entry>{};
+  {
+    auto lock = std::unique_lock{mtx_};
+    cv_.wait(lock,
+             [&]() { return !idle_.empty() || size_ < config_.max_size_; });
+
+    if (!idle_.empty()) {
+      // Prefer a context that is already bound to the current generation.
+      auto it = std::find_if(idle_.rbegin(), idle_.rend(), [&](auto&& x) {
+        return x->generation_id_ == g->id_;
+      });
+      if (it == idle_.rend()) {
+        it = idle_.rbegin();
+        ++rebinds_;
+      }
+      e = std::move(*it);
+      idle_.erase(std::next(it).base());
+    } else {
+      ++size_;
+      ++created_;
+    }
+    ++in_use_;
+    max_in_use_ = std::max(max_in_use_, in_use_);
+  }
+
+  // Context creation and rebinding (area vector resize) outside the lock.
+  if (e == nullptr) {
+    e = std::make_unique<entry>(
+        entry{.generation_id_ = g->id_, .ctx_ = g->make_context()});
+  } else if (e->generation_id_ != g->id_) {
+    g->bind(e->ctx_);
+    e->generation_id_ = g->id_;
+  }
+  return lease{*this, g, std::move(e)};
+}
+
+void guess_context_pool::release(std::unique_ptr<entry> e) {
+  auto const before = e->memory_bytes_;
+  e->memory_bytes_ = e->ctx_.memory_usage();
+  auto const drop = e->memory_bytes_ > config_.max_context_bytes_;
+  {
+    auto const lock = std::scoped_lock{mtx_};
+    --in_use_;
+    memory_bytes_ = memory_bytes_ - before + e->memory_bytes_;
+    high_water_bytes_ = std::max(high_water_bytes_, memory_bytes_);
+    if (drop) {
+      memory_bytes_ -= e->memory_bytes_;
+      --size_;
+      ++dropped_;
+    } else {
+      idle_.emplace_back(std::move(e));
+    }
+  }
+  cv_.notify_one();
+}
+
+guess_context_pool::stats guess_context_pool::get_stats() const {
+  auto const lock = std::scoped_lock{mtx_};
+  return {.size_ = size_,
+          .in_use_ = in_use_,
+          .max_in_use_ = max_in_use_,
+          .memory_bytes_ = memory_bytes_,
+          .high_water_bytes_ = high_water_bytes_,
+          .created_ = created_,
+          .rebinds_ = rebinds_,
+          .dropped_ = dropped_};
+}
+
+}  // namespace adr
\ No newline at end of file
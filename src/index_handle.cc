@@ -0,0 +1,58 @@
+#include "adr/index_handle.h"
+
+#include <utility>
+
+namespace adr {
+
+std::uint64_t next_generation_id() {
+  static auto id = std::atomic_uint64_t{0U};
+  return id++;
+}
+
+index_generation::index_generation(std::filesystem::path const& dir,
+                                   config const& c)
+    : id_{next_generation_id()},
+      t_{read(dir / "t.bin", c.load_mode_)},
+      r_{dir, cista::mmap::protection::READ},
+      area_db_{dir, cista::mmap::protection::READ},
+      cache_{t_->strings_.size(), c.cache_size_},
+      result_cache_{c.result_cache_size_ == 0U
+                        ? nullptr
+                        : std::make_unique<result_cache>(
+                              c.result_cache_size_)} {}
+
+guess_context index_generation::make_context() const {
+  auto ctx = guess_context{cache_};
+  bind(ctx);
+  return ctx;
+}
+
+void index_generation::bind(guess_context& ctx) const {
+  ctx.cache_ = &cache_;
+  ctx.result_cache_ = result_cache_.get();
+  ctx.suggestions_.clear();
+  ctx.resize(*t_);
+}
+
+index_handle::index_handle(std::shared_ptr<index_generation const> g)
+    : current_{std::move(g)} {}
+
+index_handle::index_handle(std::filesystem::path const& dir,
+                           index_generation::config const& c)
+    : current_{std::make_shared<index_generation const>(dir, c)} {}
+
+std::shared_ptr<index_generation const> index_handle::get() const {
+  return current_.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<index_generation const> index_handle::swap(
+    std::shared_ptr<index_generation const> g) {
+  return current_.exchange(std::move(g), std::memory_order_acq_rel);
+}
+
+std::shared_ptr<index_generation const> index_handle::reload(
+    std::filesystem::path const& dir, index_generation::config const& c) {
+  return swap(std::make_shared<index_generation const>(dir, c));
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "adr/json.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+
+#include "utl/enumerate.h"
+#include "utl/overloaded.h"
+
+#include "adr/area_set.h"
+#include "adr/guess_context.h"
+#include "adr/typeahead.h"
+
+namespace adr {
+
+void append_json_string(std::string& out, std::string_view s) {
+  constexpr auto const kHex = std::string_view{"0123456789abcdef"};
+
+  out.push_back('"');
+  auto clean_from = std::size_t{0U};
+  for (auto i = 0U; i != s.size(); ++i) {
+    auto const c = static_cast<unsigned char>(s[i]);
+    if (c >= 0x20U && c != '"' && c != '\\') {
+      continue;  // UTF-8 sequences are valid JSON as is
+    }
+    out.append(s.substr(clean_from, i - clean_from));
+    clean_from = i + 1U;
+    switch (c) {
+      case '"': out.append("\\\""); break;
+      case '\\': out.append("\\\\"); break;
+      case '\n': out.append("\\n"); break;
+      case '\r': out.append("\\r"); break;
+      case '\t': out.append("\\t"); break;
+      default:
+        out.append("\\u00");
+        out.push_back(kHex[c >> 4U]);
+        out.push_back(kHex[c & 0xFU]);
+    }
+  }
+  out.append(s.substr(clean_from));
+  out.push_back('"');
+}
+
+void append_json_number(std::string& out, double const x) {
+  if (!std::isfinite(x)) {
+    out.append("null");
+    return;
+  }
+  auto buf = std::array<char, 32U>{};
+  auto const res = std::to_chars(buf.data(), buf.data() + buf.size(), x);
+  out.append(buf.data(), res.ptr);
+}
+
+void append_json_number(std::string& out, std::uint64_t const x) {
+  auto buf = std::array<char, 24U>{};
+  auto const res = std::to_chars(buf.data(), buf.data() + buf.size(), x);
+  out.append(buf.data(), res.ptr);
+}
+
+void append_key(std::string& out, std::string_view key) {
+  out.push_back('"');
+  out.append(key);
+  out.append("\":");
+}
+
+void append_areas_json(std::string& out,
+                       typeahead const& t,
+                       language_list_t const& languages,
+                       suggestion const& s) {
+  auto const set = s.areas(t, languages);
+  auto const areas = t.area_sets_[s.area_set_];
+  auto first = true;
+  out.push_back('[');
+  for (auto const [i, a] : utl::enumerate(areas)) {
+    auto const admin_lvl = t.area_admin_level_[a];
+    if (admin_lvl == kTimezoneAdminLevel) {
+      continue;
+    }
+
+    auto const matched = ((1U << i) & s.matched_areas_) != 0U;
+    auto const lang_idx =
+        matched ? s.matched_area_lang_[i] : set.get_area_lang_idx(a);
+    auto const name =
+        t.strings_[t.area_names_[a][lang_idx < 0
+                                        ? kDefaultLangIdx
+                                        : static_cast<unsigned>(lang_idx)]]
+            .view();
+
+    if (!first) {
+      out.push_back(',');
+    }
+    first = false;
+    out.push_back('{');
+    append_key(out, "name");
+    append_json_string(out, name);
+    out.push_back(',');
+    append_key(out, "admin_level");
+    append_json_number(out, std::uint64_t{to_idx(admin_lvl)});
+    out.push_back(',');
+    append_key(out, "matched");
+    out.append(matched ? "true" : "false");
+    out.push_back('}');
+  }
+  out.push_back(']');
+}
+
+void append_suggestions_json(std::string& out,
+                             typeahead const& t,
+                             language_list_t const& languages,
+                             std::span<suggestion const> suggestions) {
+  out.push_back('[');
+  for (auto const [i, s] : utl::enumerate(suggestions)) {
+    if (i != 0U) {
+      out.push_back(',');
+    }
+    out.push_back('{');
+    std::visit(
+        utl::overloaded{
+            [&](place_idx_t const p) {
+              append_key(out, "type");
+              out.append("\"place\",");
+              append_key(out, "name");
+              append_json_string(out, t.strings_[s.str_].view());
+              out.push_back(',');
+              append_key(out, "category");
+              append_json_string(out, to_str(t.place_type_[p]));
+            },
+            [&](address const addr) {
+              append_key(out, "type");
+              out.append("\"address\",");
+              append_key(out, "name");
+              append_json_string(out, t.strings_[s.str_].view());
+              if (addr.house_number_ != address::kNoHouseNumber) {
+                out.push_back(',');
+                append_key(out, "house_number");
+                append_json_string(
+                    out, t.strings_[t.house_numbers_[addr.street_]
+                                                    [addr.house_number_]]
+                             .view());
+              }
+            }},
+        s.location_);
+
+    auto const pos = s.coordinates_.as_latlng();
+    out.push_back(',');
+    append_key(out, "lat");
+    append_json_number(out, pos.lat());
+    out.push_back(',');
+    append_key(out, "lng");
+    append_json_number(out, pos.lng());
+    out.push_back(',');
+    append_key(out, "score");
+    append_json_number(out, static_cast<double>(s.score_));
+    out.push_back(',');
+    append_key(out, "tz");
+    if (s.tz_ == timezone_idx_t::invalid()) {
+      out.append("null");
+    } else {
+      append_json_string(out, t.timezone_names_[s.tz_].view());
+    }
+    out.push_back(',');
+    append_key(out, "areas");
+    append_areas_json(out, t, languages, s);
+    out.push_back('}');
+  }
+  out.push_back(']');
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "adr/keystroke_trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <random>
+
+#include "utl/parser/cstr.h"
+#include "utl/read_file.h"
+#include "utl/verify.h"
+
+#include "adr/normalize.h"
+
+namespace fs = std::filesystem;
+
+namespace adr {
+
+std::vector<keystroke> generate_keystroke_trace(
+    std::vector<std::string> const& queries,
+    std::uint32_t const n_sessions,
+    keystroke_trace_config const& c) {
+  auto trace = std::vector<keystroke>{};
+  if (queries.empty()) {
+    return trace;
+  }
+
+  auto rng = std::mt19937{c.seed_};
+  auto session_gap =
+      std::exponential_distribution{1.0 / c.mean_session_gap_ms_};
+  auto key_delay =
+      std::lognormal_distribution{std::log(c.median_key_delay_ms_),
+                                  c.key_delay_sigma_};
+
+  auto session_start = 0.0;
+  for (auto session = 0U; session != n_sessions; ++session) {
+    session_start += session_gap(rng);
+
+    auto const& query = queries[session % queries.size()];
+    auto t = session_start;
+    for (auto i = 0U; i != query.size(); ++i) {
+      auto const prefix_end = i + 1U;
+      if (prefix_end != query.size() &&
+          is_utf8_continuation(query[prefix_end])) {
+        continue;  // prefix would end inside a code point
+      }
+      if (query[i] == ' ') {
+        t += key_delay(rng);  // pause before the next word
+        continue;
+      }
+      trace.push_back({.session_ = session,
+                       .offset_ms_ = static_cast<std::uint64_t>(t),
+                       .input_ = query.substr(0U, prefix_end)});
+      t += key_delay(rng);
+    }
+  }
+
+  std::stable_sort(begin(trace), end(trace), [](auto&& a, auto&& b) {
+    return a.offset_ms_ < b.offset_ms_;
+  });
+  return trace;
+}
+
+std::vector<keystroke> read_keystroke_trace(fs::path const& p) {
+  auto const content = utl::read_file(p.generic_string().c_str());
+  utl::verify(content.has_value(), "unable to read trace {}",
+              p.generic_string());
+
+  auto trace = std::vector<keystroke>{};
+  utl::for_each_line(utl::cstr{*content}, [&](utl::cstr const line) {
+    auto const v = line.view();
+    auto const tab1 = v.find('\t');
+    auto const tab2 = tab1 == std::string_view::npos
+                          ? std::string_view::npos
+                          : v.find('\t', tab1 + 1U);
+    if (tab2 == std::string_view::npos) {
+      return;
+    }
+    auto k = keystroke{.session_ = 0U,
+                       .offset_ms_ = 0U,
+                       .input_ = std::string{v.substr(tab2 + 1U)}};
+    std::from_chars(v.data(), v.data() + tab1, k.session_);
+    std::from_chars(v.data() + tab1 + 1U, v.data() + tab2, k.offset_ms_);
+    trace.emplace_back(std::move(k));
+  });
+
+  std::stable_sort(begin(trace), end(trace), [](auto&& a, auto&& b) {
+    return a.offset_ms_ < b.offset_ms_;
+  });
+  return trace;
+}
+
+void write_keystroke_trace(std::ostream& out,
+                           std::vector<keystroke> const& trace) {
+  for (auto const& k : trace) {
+    out << k.session_ << '\t' << k.offset_ms_ << '\t' << k.input_ << '\n';
+  }
+}
+
+std::vector<std::string> read_queries(fs::path const& p) {
+  auto const content = utl::read_file(p.generic_string().c_str());
+  utl::verify(content.has_value(), "unable to read {}", p.generic_string());
+
+  auto queries = std::vector<std::string>{};
+  utl::for_each_line(utl::cstr{*content}, [&](utl::cstr const line) {
+    if (!line.empty()) {
+      queries.emplace_back(line.view());
+    }
+  });
+  return queries;
+}
+
+std::uint64_t percentile(std::vector<std::uint64_t> const& sorted,
+                         double const p) {
+  if (sorted.empty()) {
+    return 0U;
+  }
+  auto const rank = static_cast<std::size_t>(
+      std::ceil(p * static_cast<double>(sorted.size())));
+  return sorted[std::clamp(rank, std::size_t{1U}, sorted.size()) - 1U];
+}
+
+}  // namespace adr
\ No newline at end of file
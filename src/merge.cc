@@ -0,0 +1,287 @@
+#include <iostream>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "utl/enumerate.h"
+#include "utl/helpers/algorithm.h"
+#include "utl/timer.h"
+#include "utl/to_vec.h"
+#include "utl/verify.h"
+#include "utl/zip.h"
+
+#include "adr/adr.h"
+#include "adr/area_database.h"
+#include "adr/import_context.h"
+#include "adr/osm_filter.h"
+#include "adr/reverse.h"
+#include "adr/typeahead.h"
+
+namespace fs = std::filesystem;
+
+namespace adr {
+
+struct merge_input {
+  explicit merge_input(fs::path const& p)
+      : t_{read(p / "t.bin", load_mode::kMmap)},
+        area_db_{p, cista::mmap::protection::READ},
+        r_{p, cista::mmap::protection::READ} {}
+
+  cista::wrapped<typeahead> t_;
+  area_database area_db_;
+  reverse r_;
+};
+
+// Areas from different shards are the same if they share the admin level,
+// country code, population and names and their bounding boxes overlap (e.g.
+// a state boundary contained in two regional extracts). Areas of one shard
+// are never merged: distinct areas can share all of these (several
+// "Neustadt" without population).
+using area_key_t = std::tuple<admin_level_t,
+                              country_code_t,
+                              std::uint16_t,
+                              std::vector<string_idx_t>>;
+
+struct merged_area {
+  area_idx_t idx_;
+  geo::box bounds_;
+  std::size_t last_input_;  // input of the last part added
+};
+
+bool overlaps(geo::box const& a, geo::box const& b) {
+  return a.min_.lat_ <= b.max_.lat_ && b.min_.lat_ <= a.max_.lat_ &&
+         a.min_.lng_ <= b.max_.lng_ && b.min_.lng_ <= a.max_.lng_;
+}
+
+// Exact duplicate key of a street position / house number.
+std::uint64_t position_key(coordinates const c) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(c.lat_))
+          << 32U) |
+         static_cast<std::uint32_t>(c.lng_);
+}
+
+void merge(std::vector<fs::path> const& in, fs::path const& out) {
+  utl::verify(!in.empty(), "merge: no input");
+
+  auto ec = std::error_code{};
+  fs::create_directories(out, ec);
+
+  auto const inputs = utl::to_vec(
+      in, [](fs::path const& p) { return std::make_unique<merge_input>(p); });
+
+  auto ctx = import_context{};
+  auto t = typeahead{};
+  auto r = reverse{out, cista::mmap::protection::WRITE};
+  auto area_db = area_database{out, cista::mmap::protection::WRITE};
+  t.lang_names_.emplace_back("default");
+
+  auto area_lookup = std::map<area_key_t, std::vector<merged_area>>{};
+  auto area_parts =
+      std::vector<std::vector<std::pair<area_database const*, area_idx_t>>>{};
+  auto place_lookup = cista::raw::ankerl_set<std::uint64_t>{};
+  auto street_areas =
+      import_context::raw_mutable_vecvec<street_idx_t, area_set_idx_t>{};
+  auto house_areas =
+      import_context::raw_mutable_vecvec<street_idx_t, area_set_idx_t>{};
+  auto street_pos_seen = std::vector<cista::raw::ankerl_set<std::uint64_t>>{};
+  auto house_numbers_seen =
+      std::vector<std::set<std::pair<std::uint64_t, string_idx_t>>>{};
+
+  for (auto const [input_idx, input] : utl::enumerate(inputs)) {
+    std::clog << "merging " << input->t_->place_names_.size() << " places, "
+              << input->t_->street_names_.size() << " streets\n";
+    auto const& s = *input->t_;
+
+    // Languages, strings and timezones.
+    auto langs =
+        std::vector<language_idx_t>(s.lang_names_.size(), kDefaultLang);
+    for (auto l = language_idx_t{1U}; l < s.lang_names_.size(); ++l) {
+      langs[to_idx(l)] = t.get_or_create_lang_idx(s.lang_names_[l].view());
+    }
+    auto const remap_langs = [&](auto&& x) {
+      return utl::to_vec(
+          x, [&](language_idx_t const l) { return langs[to_idx(l)]; });
+    };
+
+    auto const strings = utl::to_vec(s.strings_, [&](auto&& str) {
+      return t.get_or_create_string(ctx, str.view());
+    });
+    auto const remap_strings = [&](auto&& x) {
+      return utl::to_vec(
+          x, [&](string_idx_t const str) { return strings[to_idx(str)]; });
+    };
+
+    auto const timezones = utl::to_vec(s.timezone_names_, [&](auto&& tz) {
+      return t.get_or_create_timezone(ctx, tz.view());
+    });
+
+    // Areas.
+    auto areas = std::vector<area_idx_t>{};
+    areas.reserve(s.area_admin_level_.size());
+    for (auto a = area_idx_t{0U}; a < s.area_admin_level_.size(); ++a) {
+      auto names = remap_strings(s.area_names_[a]);
+      auto const bounds = input->area_db_.get_bounds(a);
+      auto& candidates = area_lookup[area_key_t{
+          s.area_admin_level_[a], s.area_country_code_[a],
+          s.area_population_[a].value_, names}];
+      auto const it = utl::find_if(candidates, [&](merged_area const& m) {
+        return m.last_input_ != input_idx && overlaps(m.bounds_, bounds);
+      });
+      if (it != end(candidates)) {
+        area_parts[to_idx(it->idx_)].emplace_back(&input->area_db_, a);
+        it->bounds_.extend(bounds.min_);
+        it->bounds_.extend(bounds.max_);
+        it->last_input_ = input_idx;
+        areas.emplace_back(it->idx_);
+        continue;
+      }
+
+      auto const idx = area_idx_t{t.area_admin_level_.size()};
+      t.area_names_.emplace_back(names);
+      t.area_name_lang_.emplace_back(remap_langs(s.area_name_lang_[a]));
+      t.area_admin_level_.emplace_back(s.area_admin_level_[a]);
+      t.area_population_.emplace_back(s.area_population_[a]);
+      t.area_country_code_.emplace_back(s.area_country_code_[a]);
+      auto const tz = s.area_timezone_[a];
+      t.area_timezone_.emplace_back(
+          tz == timezone_idx_t::invalid() ? tz : timezones[to_idx(tz)]);
+      area_parts.push_back({{&input->area_db_, a}});
+      candidates.push_back(
+          {.idx_ = idx, .bounds_ = bounds, .last_input_ = input_idx});
+      areas.emplace_back(idx);
+    }
+
+    auto mapped = basic_string<area_idx_t>{};
+    auto const area_sets = utl::to_vec(s.area_sets_, [&](auto&& set) {
+      mapped.clear();
+      for (auto const a : set) {
+        auto const m = areas[to_idx(a)];
+        if (utl::find(mapped, m) == end(mapped)) {
+          mapped.push_back(m);
+        }
+      }
+      return t.get_or_create_area_set(ctx, mapped);
+    });
+
+    // Places. Places contained in several shards are only added once.
+    for (auto p = place_idx_t{0U}; p < s.place_names_.size(); ++p) {
+      auto const is_way = s.place_is_way_.test(to_idx(p));
+      auto const& ids = s.place_osm_ids_[p];
+      if (!ids.empty() &&
+          !place_lookup.emplace(osm_key(ids[0], is_way)).second) {
+        continue;
+      }
+
+      auto const idx = place_idx_t{t.place_names_.size()};
+      auto const names = remap_strings(s.place_names_[p]);
+      for (auto const str : names) {
+        ctx.string_to_location_[str].emplace_back(to_idx(idx),
+                                                  location_type_t::kPlace);
+      }
+      t.place_names_.emplace_back(names);
+      t.place_name_lang_.emplace_back(remap_langs(s.place_name_lang_[p]));
+      t.place_osm_ids_.emplace_back(ids);
+      t.place_coordinates_.emplace_back(s.place_coordinates_[p]);
+      t.place_areas_.emplace_back(area_sets[to_idx(s.place_areas_[p])]);
+      t.place_population_.emplace_back(s.place_population_[p]);
+      t.place_type_.emplace_back(s.place_type_[p]);
+      t.place_is_way_.resize(static_cast<unsigned>(to_idx(idx) + 1U));
+      t.place_is_way_.set(to_idx(idx), is_way);
+    }
+
+    // Streets (one per name, like in extract). Positions and house numbers
+    // from other shards are appended, exact duplicates skipped.
+    for (auto st = street_idx_t{0U}; st < s.street_names_.size(); ++st) {
+      auto const name = s.strings_[s.street_names_[st][kDefaultLangIdx]];
+      auto const street = t.get_or_create_street(ctx, name.view());
+      street_areas[street];
+      house_areas[street];
+      street_pos_seen.resize(std::max(street_pos_seen.size(),
+                                      std::size_t{to_idx(street)} + 1U));
+      house_numbers_seen.resize(street_pos_seen.size());
+
+      for (auto const [pos, area_set] :
+           utl::zip(s.street_pos_[st], s.street_areas_[st])) {
+        if (!street_pos_seen[to_idx(street)]
+                 .emplace(position_key(pos))
+                 .second) {
+          continue;
+        }
+        ctx.street_pos_[street].emplace_back(pos);
+        street_areas[street].emplace_back(area_sets[to_idx(area_set)]);
+      }
+
+      if (st < s.house_numbers_.size()) {
+        for (auto const [hn, c, area_set] :
+             utl::zip(s.house_numbers_[st], s.house_coordinates_[st],
+                      s.house_areas_[st])) {
+          auto const hn_str = strings[to_idx(hn)];
+          if (!house_numbers_seen[to_idx(street)]
+                   .emplace(position_key(c), hn_str)
+                   .second) {
+            continue;
+          }
+          ctx.house_numbers_[street].emplace_back(hn_str);
+          ctx.house_coordinates_[street].emplace_back(c);
+          house_areas[street].emplace_back(area_sets[to_idx(area_set)]);
+        }
+      }
+
+      r.add_street_segments(ctx, street, input->r_, st);
+    }
+  }
+
+  {  // Area geometries (the union of all shards containing the area).
+    auto const timer = utl::scoped_timer{"merge area geometries"};
+    for (auto const [i, parts] : utl::enumerate(area_parts)) {
+      area_db.add_area(area_idx_t{i}, parts);
+    }
+  }
+
+  {  // Copy data from context to typeahead.
+    for (auto const b : ctx.street_pos_) {
+      t.street_pos_.emplace_back(b);
+    }
+    for (auto const b : street_areas) {
+      t.street_areas_.emplace_back(b);
+    }
+    for (auto const b : ctx.house_numbers_) {
+      t.house_numbers_.emplace_back(b);
+    }
+    for (auto const b : ctx.house_coordinates_) {
+      t.house_coordinates_.emplace_back(b);
+    }
+    for (auto const b : house_areas) {
+      t.house_areas_.emplace_back(b);
+    }
+    for (auto const locations : ctx.string_to_location_) {
+      auto idxs = t.string_to_location_.add_back_sized(locations.size());
+      auto types = t.string_to_type_.add_back_sized(locations.size());
+      for (auto i = 0U; i != locations.size(); ++i) {
+        idxs[i] = locations[i].first;
+        types[i] = locations[i].second;
+      }
+    }
+    t.string_to_location_.resize(t.strings_.size());
+    t.string_to_type_.resize(t.strings_.size());
+    r.write(ctx);
+  }
+
+  {  // Finalize.
+    auto const timer = utl::scoped_timer{"merge build index"};
+    t.build_ngram_index();
+    if (utl::any_of(inputs, [](auto&& input) {
+          return !input->t_->geo_bigrams_.empty();
+        })) {
+      t.build_geo_ngram_index();
+    }
+    t.build_short_prefix_index();
+    t.ext_start_ = t.place_names_.size();
+  }
+
+  write(out / "t.bin", t);
+  r.build_rtree(t);
+  r.write();
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,413 @@
+#include "adr/overlay.h"
+
+#include "osmium/handler.hpp"
+#include "osmium/io/xml_input.hpp"
+#include "osmium/visitor.hpp"
+
+#include "utl/enumerate.h"
+#include "utl/get_or_create.h"
+#include "utl/helpers/algorithm.h"
+#include "utl/verify.h"
+#include "utl/zip.h"
+
+#include "adr/area_database.h"
+#include "adr/import_context.h"
+#include "adr/osm_filter.h"
+#include "adr/reverse.h"
+
+namespace fs = std::filesystem;
+namespace osm_io = osmium::io;
+
+namespace adr {
+
+struct change_collector : public osmium::handler::Handler {
+  void node(osmium::Node const& n) {
+    auto& v = latest_node_[n.id()];
+    v = std::max(v, static_cast<std::uint32_t>(n.version()));
+    changed_.emplace(osm_key(n.id(), false));
+  }
+
+  // Way and area places can't be re-created from a change file (no node
+  // locations): modified ones keep their base version, only deleted ones
+  // are tombstoned.
+  void way(osmium::Way const& w) {
+    if (w.visible()) {
+      return;
+    }
+    // Way places are referenced by way id, areas by 2 * way id.
+    changed_.emplace(osm_key(w.id(), true));
+    changed_.emplace(osm_key(w.id() * 2, true));
+  }
+
+  void relation(osmium::Relation const& r) {
+    if (!r.visible()) {
+      changed_.emplace(osm_key(r.id() * 2 + 1, true));
+    }
+  }
+
+  cista::raw::ankerl_map<std::int64_t, std::uint32_t> latest_node_;
+  cista::raw::ankerl_set<std::uint64_t> changed_;
+};
+
+struct change_handler : public osmium::handler::Handler {
+  change_handler(typeahead& t,
+                 import_context& ctx,
+                 change_collector const& changes)
+      : t_{t}, ctx_{ctx}, changes_{changes} {}
+
+  void node(osmium::Node const& n) {
+    auto const it = changes_.latest_node_.find(n.id());
+    if (!n.visible() || it == end(changes_.latest_node_) ||
+        it->second != n.version()) {
+      return;
+    }
+    auto const c = classify_tags(n.tags());
+    if (c.is_relevant_node()) {
+      t_.add_address(ctx_, n.tags(), c, n.location());
+      t_.add_place(ctx_, n.id(), false, n.tags(), c, n.location());
+    }
+  }
+
+  typeahead& t_;
+  import_context& ctx_;
+  change_collector const& changes_;
+};
+
+void copy_string_to_location(typeahead& t, import_context& ctx) {
+  t.string_to_location_.clear();
+  t.string_to_type_.clear();
+  for (auto const locations : ctx.string_to_location_) {
+    auto idxs = t.string_to_location_.add_back_sized(locations.size());
+    auto types = t.string_to_type_.add_back_sized(locations.size());
+    for (auto i = 0U; i != locations.size(); ++i) {
+      idxs[i] = locations[i].first;
+      types[i] = locations[i].second;
+    }
+  }
+  t.string_to_location_.resize(t.strings_.size());
+  t.string_to_type_.resize(t.strings_.size());
+}
+
+void build_indices(typeahead& t, bool const geo_index) {
+  t.build_ngram_index();
+  if (geo_index) {
+    t.build_geo_ngram_index();
+  }
+  t.build_short_prefix_index();
+  t.ext_start_ = t.place_names_.size();
+}
+
+overlay::overlay(typeahead const& base,
+                 area_database const& base_areas,
+                 fs::path const& osc)
+    : t_{std::make_unique<typeahead>()} {
+  auto& t = *t_;
+  t.lang_ = base.lang_;
+  t.lang_names_ = base.lang_names_;
+
+  auto const file = osm_io::File{osc.generic_string()};
+
+  auto changes = change_collector{};
+  {
+    auto reader = osm_io::Reader{file};
+    osmium::apply(reader, changes);
+    reader.close();
+  }
+
+  auto ctx = import_context{};
+  {
+    auto reader = osm_io::Reader{file, osmium::osm_entity_bits::node};
+    auto handler = change_handler{t, ctx, changes};
+    osmium::apply(reader, handler);
+    reader.close();
+  }
+
+  // Overlay streets only hold the house numbers of address nodes (no street
+  // positions: ways are not applied).
+  t.cluster_street_positions(ctx);
+  for (auto const b : ctx.house_numbers_) {
+    t.house_numbers_.emplace_back(b);
+  }
+  for (auto const b : ctx.house_coordinates_) {
+    t.house_coordinates_.emplace_back(b);
+  }
+
+  // Copy the base areas containing the new places and house numbers.
+  auto area_lookup = cista::raw::ankerl_map<area_idx_t, area_idx_t>{};
+  auto const import_area = [&](area_idx_t const a) {
+    return utl::get_or_create(area_lookup, a, [&]() {
+      auto const idx = area_idx_t{t.area_admin_level_.size()};
+      auto names = t.area_names_.add_back_sized(0U);
+      for (auto const s : base.area_names_[a]) {
+        names.push_back(t.get_or_create_string(ctx, base.strings_[s].view()));
+      }
+      t.area_name_lang_.emplace_back(base.area_name_lang_[a]);
+      t.area_admin_level_.emplace_back(base.area_admin_level_[a]);
+      t.area_population_.emplace_back(base.area_population_[a]);
+      t.area_country_code_.emplace_back(base.area_country_code_[a]);
+      auto const tz = base.area_timezone_[a];
+      t.area_timezone_.emplace_back(
+          tz == timezone_idx_t::invalid()
+              ? tz
+              : t.get_or_create_timezone(ctx, base.timezone_names_[tz].view()));
+      base_area_.emplace_back(a);
+      return idx;
+    });
+  };
+
+  auto areas = basic_string<area_idx_t>{};
+  auto overlay_areas = basic_string<area_idx_t>{};
+  auto const get_area_set = [&](coordinates const c) {
+    base_areas.lookup(base, c, areas);
+    overlay_areas.clear();
+    for (auto const a : areas) {
+      overlay_areas.push_back(import_area(a));
+    }
+    return t.get_or_create_area_set(ctx, overlay_areas);
+  };
+  for (auto const c : t.place_coordinates_) {
+    t.place_areas_.emplace_back(get_area_set(c));
+  }
+  for (auto s = street_idx_t{0U}; s < t.street_names_.size(); ++s) {
+    t.street_areas_.add_back_sized(0U);
+    t.house_areas_.add_back_sized(0U);
+    for (auto const c : t.house_coordinates_[s]) {
+      t.house_areas_[s].push_back(get_area_set(c));
+    }
+  }
+
+  copy_string_to_location(t, ctx);
+  build_indices(t, !base.geo_bigrams_.empty());
+
+  // Tombstone base places touched by the change file.
+  tombstones_.resize(static_cast<unsigned>(base.place_names_.size()));
+  for (auto p = place_idx_t{0U}; p < base.place_names_.size(); ++p) {
+    auto const is_way = base.place_is_way_.test(to_idx(p));
+    if (utl::any_of(base.place_osm_ids_[p], [&](std::int64_t const id) {
+          return changes.changed_.contains(osm_key(id, is_way));
+        })) {
+      tombstones_.set(to_idx(p), true);
+      ++n_tombstones_;
+    }
+  }
+}
+
+bool overlay::is_deleted(place_idx_t const p) const {
+  return to_idx(p) < tombstones_.size() && tombstones_.test(to_idx(p));
+}
+
+template <bool Debug>
+std::vector<overlay_suggestion> get_suggestions(
+    typeahead const& base,
+    overlay const& o,
+    std::string const& input,
+    unsigned const n_suggestions,
+    language_list_t const& languages,
+    guess_context& ctx,
+    guess_context& overlay_ctx,
+    std::optional<geo::latlng> const& coord,
+    float const bias,
+    filter_type const filter) {
+  auto const not_deleted = [&](place_idx_t const p) {
+    return !o.is_deleted(p);
+  };
+  get_suggestions<Debug>(
+      base, input, n_suggestions, languages, ctx, coord, bias, filter,
+      o.n_tombstones_ == 0U ? place_filter{} : place_filter{not_deleted});
+  get_suggestions<Debug>(o.t(), input, n_suggestions, languages, overlay_ctx,
+                         coord, bias, filter);
+
+  auto merged = std::vector<overlay_suggestion>{};
+  merged.reserve(ctx.suggestions_.size() + overlay_ctx.suggestions_.size());
+  for (auto const& s : ctx.suggestions_) {
+    merged.push_back({.s_ = s, .from_overlay_ = false});
+  }
+  for (auto const& s : overlay_ctx.suggestions_) {
+    merged.push_back({.s_ = s, .from_overlay_ = true});
+  }
+  utl::sort(merged, [](auto&& a, auto&& b) { return a.s_ < b.s_; });
+  merged.resize(std::min(merged.size(), std::size_t{n_suggestions}));
+  return merged;
+}
+
+void compact(fs::path const& base_dir, overlay const& o, fs::path const& out) {
+  utl::verify(fs::weakly_canonical(base_dir) != fs::weakly_canonical(out),
+              "compact: output directory must differ from base directory");
+
+  auto ec = std::error_code{};
+  fs::create_directories(out, ec);
+  for (auto const& e : fs::directory_iterator{base_dir}) {
+    if (e.is_regular_file() && e.path().filename() != "t.bin") {
+      fs::copy_file(e.path(), out / e.path().filename(),
+                    fs::copy_options::overwrite_existing);
+    }
+  }
+
+  auto base = read(base_dir / "t.bin", load_mode::kRead);
+  auto& t = *base;
+  auto const& ot = o.t();
+
+  // The overlay started with the base languages: same indices after this.
+  // Index 0 is the default language.
+  for (auto l = language_idx_t{1U}; l < ot.lang_names_.size(); ++l) {
+    t.get_or_create_lang_idx(ot.lang_names_[l].view());
+  }
+
+  auto ctx = import_context{};
+  for (auto const [i, s] : utl::enumerate(t.area_sets_)) {
+    ctx.area_set_lookup_.emplace(basic_string<area_idx_t>{begin(s), end(s)},
+                                 area_set_idx_t{i});
+  }
+
+  // Rebuild places: keep non-tombstoned base places, append overlay places.
+  auto c = typeahead{};
+  auto const add_place = [&](place_idx_t const p, typeahead const& src,
+                             auto&& names, area_set_idx_t const area_set) {
+    auto const idx = place_idx_t{c.place_names_.size()};
+    c.place_names_.emplace_back(names);
+    c.place_name_lang_.emplace_back(src.place_name_lang_[p]);
+    c.place_osm_ids_.emplace_back(src.place_osm_ids_[p]);
+    c.place_coordinates_.emplace_back(src.place_coordinates_[p]);
+    c.place_areas_.emplace_back(area_set);
+    c.place_population_.emplace_back(src.place_population_[p]);
+    c.place_type_.emplace_back(src.place_type_[p]);
+    c.place_is_way_.resize(static_cast<unsigned>(to_idx(idx) + 1U));
+    c.place_is_way_.set(to_idx(idx), src.place_is_way_.test(to_idx(p)));
+    for (auto const s : names) {
+      ctx.string_to_location_[s].emplace_back(to_idx(idx),
+                                              location_type_t::kPlace);
+    }
+  };
+
+  for (auto const [i, locations] : utl::enumerate(t.string_to_location_)) {
+    for (auto const [l, type] :
+         utl::zip(locations, t.string_to_type_[string_idx_t{i}])) {
+      if (type == location_type_t::kStreet) {
+        ctx.string_to_location_[string_idx_t{i}].emplace_back(l, type);
+      }
+    }
+  }
+
+  for (auto p = place_idx_t{0U}; p < t.place_names_.size(); ++p) {
+    if (!o.is_deleted(p)) {
+      add_place(p, t, t.place_names_[p], t.place_areas_[p]);
+    }
+  }
+
+  auto areas = basic_string<area_idx_t>{};
+  auto const to_base_area_set = [&](area_set_idx_t const overlay_set) {
+    areas.clear();
+    for (auto const a : ot.area_sets_[overlay_set]) {
+      areas.push_back(o.base_area_[to_idx(a)]);
+    }
+    return t.get_or_create_area_set(ctx, areas);
+  };
+
+  auto names = std::vector<string_idx_t>{};
+  for (auto p = place_idx_t{0U}; p < ot.place_names_.size(); ++p) {
+    names.clear();
+    for (auto const s : ot.place_names_[p]) {
+      names.push_back(t.get_or_create_string(ctx, ot.strings_[s].view()));
+    }
+    add_place(p, ot, names, to_base_area_set(ot.place_areas_[p]));
+  }
+
+  t.place_names_ = std::move(c.place_names_);
+  t.place_name_lang_ = std::move(c.place_name_lang_);
+  t.place_osm_ids_ = std::move(c.place_osm_ids_);
+  t.place_coordinates_ = std::move(c.place_coordinates_);
+  t.place_areas_ = std::move(c.place_areas_);
+  t.place_population_ = std::move(c.place_population_);
+  t.place_type_ = std::move(c.place_type_);
+  t.place_is_way_ = std::move(c.place_is_way_);
+
+  // Append overlay house numbers to the base street with the same name.
+  if (!ot.street_names_.empty()) {
+    auto const n_base_streets = t.street_names_.size();
+    for (auto s = street_idx_t{0U}; s < n_base_streets; ++s) {
+      ctx.street_lookup_.emplace(t.street_names_[s][kDefaultLangIdx], s);
+    }
+
+    auto house_areas =
+        import_context::raw_mutable_vecvec<street_idx_t, area_set_idx_t>{};
+    for (auto os = street_idx_t{0U}; os < ot.street_names_.size(); ++os) {
+      auto const name = ot.strings_[ot.street_names_[os][kDefaultLangIdx]];
+      auto const s = t.get_or_create_street(ctx, name.view());
+      for (auto const [hn, pos, area_set] :
+           utl::zip(ot.house_numbers_[os], ot.house_coordinates_[os],
+                    ot.house_areas_[os])) {
+        ctx.house_numbers_[s].emplace_back(
+            t.get_or_create_string(ctx, ot.strings_[hn].view()));
+        ctx.house_coordinates_[s].emplace_back(pos);
+        house_areas[s].emplace_back(to_base_area_set(area_set));
+      }
+    }
+
+    for (auto s = street_idx_t{0U}; s < t.street_names_.size(); ++s) {
+      c.house_numbers_.add_back_sized(0U);
+      c.house_coordinates_.add_back_sized(0U);
+      c.house_areas_.add_back_sized(0U);
+      if (to_idx(s) < n_base_streets) {
+        for (auto const [hn, pos, area_set] :
+             utl::zip(t.house_numbers_[s], t.house_coordinates_[s],
+                      t.house_areas_[s])) {
+          c.house_numbers_[s].push_back(hn);
+          c.house_coordinates_[s].push_back(pos);
+          c.house_areas_[s].push_back(area_set);
+        }
+      } else {  // New street: house numbers only.
+        t.street_pos_.add_back_sized(0U);
+        t.street_areas_.add_back_sized(0U);
+      }
+      if (to_idx(s) < house_areas.size()) {
+        for (auto const [hn, pos, area_set] :
+             utl::zip(ctx.house_numbers_[s], ctx.house_coordinates_[s],
+                      house_areas[s])) {
+          c.house_numbers_[s].push_back(hn);
+          c.house_coordinates_[s].push_back(pos);
+          c.house_areas_[s].push_back(area_set);
+        }
+      }
+    }
+
+    t.house_numbers_ = std::move(c.house_numbers_);
+    t.house_coordinates_ = std::move(c.house_coordinates_);
+    t.house_areas_ = std::move(c.house_areas_);
+  }
+
+  copy_string_to_location(t, ctx);
+  build_indices(t, !t.geo_bigrams_.empty());
+  write(out / "t.bin", t);
+
+  auto const base_r = reverse{base_dir, cista::mmap::protection::READ};
+  auto r = reverse{out, cista::mmap::protection::WRITE};
+  r.add_street_segments(base_r);
+  r.build_rtree(t);
+  r.write();
+}
+
+template std::vector<overlay_suggestion> get_suggestions<true>(
+    typeahead const&,
+    overlay const&,
+    std::string const&,
+    unsigned,
+    language_list_t const&,
+    guess_context&,
+    guess_context&,
+    std::optional<geo::latlng> const&,
+    float,
+    filter_type);
+
+template std::vector<overlay_suggestion> get_suggestions<false>(
+    typeahead const&,
+    overlay const&,
+    std::string const&,
+    unsigned,
+    language_list_t const&,
+    guess_context&,
+    guess_context&,
+    std::optional<geo::latlng> const&,
+    float,
+    filter_type);
+
+}  // namespace adr
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "adr/query_arena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace adr {
+
+query_arena::query_arena(std::size_t const size)
+    : block_{std::make_unique_for_overwrite<std::byte[]>(size)},
+      block_size_{size} {}
+
+query_arena::~query_arena() { free_overflow(); }
+
+void query_arena::reset() {
+  auto const peak = used();
+  high_water_ = std::max(high_water_, peak);
+  if (!overflow_.empty()) {
+    free_overflow();
+    block_size_ = std::bit_ceil(peak);
+    block_ = std::make_unique_for_overwrite<std::byte[]>(block_size_);
+  }
+  offset_ = 0U;
+  overflow_bytes_ = 0U;
+}
+
+std::string_view query_arena::copy(std::string_view s) {
+  if (s.empty()) {
+    return {};
+  }
+  auto const mem = static_cast<char*>(do_allocate(s.size(), 1U));
+  std::memcpy(mem, s.data(), s.size());
+  return {mem, s.size()};
+}
+
+std::size_t query_arena::high_water() const {
+  return std::max(high_water_, used());
+}
+
+void* query_arena::do_allocate(std::size_t const bytes,
+                               std::size_t const alignment) {
+  auto space = block_size_ - offset_;
+  auto ptr = static_cast<void*>(block_.get() + offset_);
+  if (std::align(alignment, bytes, ptr, space) != nullptr) {
+    offset_ = block_size_ - space + bytes;
+    return ptr;
+  }
+
+  auto const mem =
+      std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  overflow_.push_back({mem, bytes, alignment});
+  overflow_bytes_ += bytes;
+  return mem;
+}
+
+bool query_arena::do_is_equal(
+    std::pmr::memory_resource const& o) const noexcept {
+  return this == &o;
+}
+
+void query_arena::free_overflow() {
+  for (auto const& o : overflow_) {
+    std::pmr::new_delete_resource()->deallocate(o.ptr_, o.bytes_,
+                                                o.alignment_);
+  }
+  overflow_.clear();
+}
+
+}  // namespace adr
\ No newline at end of file
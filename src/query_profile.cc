@@ -0,0 +1,126 @@
+#include "adr/query_profile.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+
+namespace adr {
+
+void query_profile::print(std::ostream& out) const {
+  for (auto i = 0U; i != kQueryStages; ++i) {
+    if ((stages_run_ & (1U << i)) != 0U) {
+      out << kQueryStageNames[i] << "=" << (stage_ns_[i] / 1000U) << "us ";
+    }
+  }
+  out << "tokens=" << n_tokens_ << " ngrams=" << n_ngrams_
+      << " cached_ngrams=" << n_cached_ngrams_
+      << " strings=" << n_string_matches_ << " streets=" << n_street_matches_
+      << " places=" << n_place_matches_ << " suggestions=" << n_suggestions_;
+  if (short_prefix_) {
+    out << " short_prefix";
+  }
+  if (result_cache_hit_) {
+    out << " result_cache_hit";
+  }
+  if (geo_candidates_) {
+    out << " geo_candidates";
+  }
+  if (pruned_) {
+    out << " pruned";
+  }
+  if (truncated_) {
+    out << " truncated";
+  }
+}
+
+void query_metrics::histogram::observe(std::uint64_t const ns) {
+  auto const us = ns / 1000U;
+  auto const bucket = static_cast<std::size_t>(std::distance(
+      begin(kLatencyBucketsUs), std::lower_bound(begin(kLatencyBucketsUs),
+                                                 end(kLatencyBucketsUs), us)));
+  buckets_[bucket].fetch_add(1U, std::memory_order_relaxed);
+  sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+  count_.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void query_metrics::add(query_profile const& p) {
+  for (auto i = 0U; i != kQueryStages; ++i) {
+    if ((p.stages_run_ & (1U << i)) != 0U) {
+      stages_[i].observe(p.stage_ns_[i]);
+    }
+  }
+
+  constexpr auto const kRelaxed = std::memory_order_relaxed;
+  queries_.fetch_add(1U, kRelaxed);
+  short_prefix_queries_.fetch_add(p.short_prefix_ ? 1U : 0U, kRelaxed);
+  result_cache_hits_.fetch_add(p.result_cache_hit_ ? 1U : 0U, kRelaxed);
+  geo_candidate_queries_.fetch_add(p.geo_candidates_ ? 1U : 0U, kRelaxed);
+  pruned_queries_.fetch_add(p.pruned_ ? 1U : 0U, kRelaxed);
+  truncated_queries_.fetch_add(p.truncated_ ? 1U : 0U, kRelaxed);
+  ngrams_.fetch_add(p.n_ngrams_, kRelaxed);
+  cached_ngrams_.fetch_add(p.n_cached_ngrams_, kRelaxed);
+  string_matches_.fetch_add(p.n_string_matches_, kRelaxed);
+  street_matches_.fetch_add(p.n_street_matches_, kRelaxed);
+  place_matches_.fetch_add(p.n_place_matches_, kRelaxed);
+  suggestions_.fetch_add(p.n_suggestions_, kRelaxed);
+}
+
+void query_metrics::print_prometheus(std::ostream& out) const {
+  constexpr auto const kRelaxed = std::memory_order_relaxed;
+
+  out << "# HELP adr_query_stage_seconds Time spent per query stage.\n"
+      << "# TYPE adr_query_stage_seconds histogram\n";
+  for (auto i = 0U; i != kQueryStages; ++i) {
+    auto const& h = stages_[i];
+    auto const name = kQueryStageNames[i];
+    auto cumulative = std::uint64_t{0U};
+    for (auto b = 0U; b != kBuckets; ++b) {
+      cumulative += h.buckets_[b].load(kRelaxed);
+      out << "adr_query_stage_seconds_bucket{stage=\"" << name << "\",le=\"";
+      if (b == kLatencyBucketsUs.size()) {
+        out << "+Inf";
+      } else {
+        out << static_cast<double>(kLatencyBucketsUs[b]) / 1e6;
+      }
+      out << "\"} " << cumulative << "\n";
+    }
+    out << "adr_query_stage_seconds_sum{stage=\"" << name << "\"} "
+        << static_cast<double>(h.sum_ns_.load(kRelaxed)) / 1e9 << "\n"
+        << "adr_query_stage_seconds_count{stage=\"" << name << "\"} "
+        << h.count_.load(kRelaxed) << "\n";
+  }
+
+  auto const counter = [&](std::string_view name, std::string_view help,
+                           std::atomic_uint64_t const& value) {
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " counter\n"
+        << name << " " << value.load(kRelaxed) << "\n";
+  };
+  counter("adr_queries_total", "Number of queries.", queries_);
+  counter("adr_short_prefix_queries_total",
+          "Queries answered from the short prefix index.",
+          short_prefix_queries_);
+  counter("adr_result_cache_hits_total",
+          "Queries answered by the result cache.", result_cache_hits_);
+  counter("adr_geo_candidate_queries_total",
+          "Queries with candidates from the region around the coordinate.",
+          geo_candidate_queries_);
+  counter("adr_pruned_queries_total",
+          "Queries with candidates from dynamic pruning.", pruned_queries_);
+  counter("adr_truncated_queries_total",
+          "Queries that ran out of their time / work budget.",
+          truncated_queries_);
+  counter("adr_ngrams_total", "Query bigrams.", ngrams_);
+  counter("adr_cached_ngrams_total",
+          "Query bigrams with counts from the ngram cache.", cached_ngrams_);
+  counter("adr_string_matches_total", "Cosine similarity candidates.",
+          string_matches_);
+  counter("adr_street_matches_total", "Scored street candidates.",
+          street_matches_);
+  counter("adr_place_matches_total", "Scored place candidates.",
+          place_matches_);
+  counter("adr_suggestions_total", "Suggestions before truncation.",
+          suggestions_);
+}
+
+}  // namespace adr
\ No newline at end of file
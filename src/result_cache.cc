@@ -0,0 +1,208 @@
+#include "adr/result_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#include "utl/helpers/algorithm.h"
+
+namespace adr {
+
+std::uint64_t hash_cache_key(std::string_view key) {
+  return std::hash<std::string_view>{}(key);
+}
+
+std::uint64_t mix_hash(std::uint64_t x) {
+  x ^= x >> 33U;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33U;
+  x *= 0xC4CEB9FE1A85EC53ULL;
+  x ^= x >> 33U;
+  return x;
+}
+
+template <typename T>
+void append_bytes(std::string& key, T const& x) {
+  auto buf = std::array<char, sizeof(T)>{};
+  std::memcpy(buf.data(), &x, sizeof(T));
+  key.append(buf.data(), buf.size());
+}
+
+result_cache::sketch::sketch(std::size_t const width)
+    : width_{std::max(std::size_t{64U}, width)},
+      sample_size_{10U * width_},
+      counters_(kDepth * width_, 0U) {}
+
+void result_cache::sketch::increment(std::uint64_t hash) {
+  for (auto i = 0U; i != kDepth; ++i) {
+    hash = mix_hash(hash + i);
+    auto& c = counters_[i * width_ + hash % width_];
+    if (c != std::numeric_limits<std::uint8_t>::max()) {
+      ++c;
+    }
+  }
+
+  // Aging: halve all counters so that the sketch follows the recent traffic.
+  if (++additions_ == sample_size_) {
+    for (auto& c : counters_) {
+      c /= 2U;
+    }
+    additions_ /= 2U;
+  }
+}
+
+std::uint8_t result_cache::sketch::estimate(std::uint64_t hash) const {
+  auto min = std::numeric_limits<std::uint8_t>::max();
+  for (auto i = 0U; i != kDepth; ++i) {
+    hash = mix_hash(hash + i);
+    min = std::min(min, counters_[i * width_ + hash % width_]);
+  }
+  return min;
+}
+
+result_cache::shard::shard(std::size_t const max_entries)
+    : max_entries_{max_entries}, frequency_{max_entries} {}
+
+result_cache::result_cache(std::size_t const max_entries) {
+  auto const per_shard = std::max(std::size_t{1U}, max_entries / kShards);
+  shards_.reserve(kShards);
+  for (auto i = 0U; i != kShards; ++i) {
+    shards_.emplace_back(std::make_unique<shard>(per_shard));
+  }
+}
+
+geo::latlng result_cache::quantize(geo::latlng const& x) {
+  auto const snap = [](double const v) {
+    return (std::floor(v / kResultCacheCoordinatePrecision) + 0.5) *
+           kResultCacheCoordinatePrecision;
+  };
+  return {snap(x.lat()), snap(x.lng())};
+}
+
+std::string result_cache::make_key(std::string_view const guess_str,
+                                   std::span<std::string_view const> tokens,
+                                   language_list_t const& languages,
+                                   filter_type const filter,
+                                   unsigned const n_suggestions,
+                                   std::optional<geo::latlng> const& coord,
+                                   float const bias,
+                                   std::optional<geo::box> const& bbox) {
+  auto key = std::string{guess_str};
+  key.push_back('\0');
+  for (auto const& t : tokens) {
+    key.append(t);
+    key.push_back('\0');
+  }
+  append_bytes(key, static_cast<std::uint8_t>(languages.size()));
+  for (auto const l : languages) {
+    append_bytes(key, l);
+  }
+  append_bytes(key, filter);
+  append_bytes(key, n_suggestions);
+  if (coord.has_value()) {
+    auto const q = quantize(*coord);
+    append_bytes(key, static_cast<std::int32_t>(
+                    std::lround(q.lat() / kResultCacheCoordinatePrecision)));
+    append_bytes(key, static_cast<std::int32_t>(
+                    std::lround(q.lng() / kResultCacheCoordinatePrecision)));
+    append_bytes(key, bias);
+  }
+  if (bbox.has_value()) {
+    append_bytes(key, bbox->min_.lat());
+    append_bytes(key, bbox->min_.lng());
+    append_bytes(key, bbox->max_.lat());
+    append_bytes(key, bbox->max_.lng());
+  }
+  return key;
+}
+
+result_cache::shard& result_cache::get_shard(std::uint64_t const hash) {
+  return *shards_[mix_hash(hash) % kShards];
+}
+
+std::shared_ptr<result_cache::entry const> result_cache::get(
+    std::string_view key) {
+  auto const hash = hash_cache_key(key);
+  auto& s = get_shard(hash);
+
+  auto const lock = std::lock_guard{s.mtx_};
+  s.frequency_.increment(hash);
+
+  auto const it = s.index_.find(key);
+  if (it == end(s.index_)) {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  s.lru_.splice(begin(s.lru_), s.lru_, it->second);
+  auto const& e = *it->second;
+  ++e->hits_;
+  return e;
+}
+
+void result_cache::add(std::string key, std::vector<suggestion> suggestions) {
+  auto const hash = hash_cache_key(key);
+  auto& s = get_shard(hash);
+
+  auto const lock = std::lock_guard{s.mtx_};
+  if (s.index_.contains(std::string_view{key})) {
+    return;
+  }
+
+  if (s.lru_.size() >= s.max_entries_) {
+    auto const& victim = s.lru_.back();
+    if (s.frequency_.estimate(hash) <=
+        s.frequency_.estimate(hash_cache_key(victim->key_))) {
+      ++rejected_;
+      return;
+    }
+    s.index_.erase(std::string_view{victim->key_});
+    s.lru_.pop_back();
+    ++evictions_;
+  }
+
+  auto e = std::make_shared<entry>();
+  e->key_ = std::move(key);
+  e->suggestions_ = std::move(suggestions);
+  s.lru_.emplace_front(std::move(e));
+  s.index_.emplace(std::string_view{s.lru_.front()->key_}, begin(s.lru_));
+  ++inserts_;
+}
+
+void result_cache::clear() {
+  for (auto& s : shards_) {
+    auto const lock = std::lock_guard{s->mtx_};
+    s->index_.clear();
+    s->lru_.clear();
+  }
+}
+
+result_cache::stats result_cache::get_stats() const {
+  return {.hits_ = hits_,
+          .misses_ = misses_,
+          .inserts_ = inserts_,
+          .rejected_ = rejected_,
+          .evictions_ = evictions_};
+}
+
+std::vector<std::pair<std::string, std::uint32_t>> result_cache::hot_keys(
+    std::size_t const n) const {
+  auto keys = std::vector<std::pair<std::string, std::uint32_t>>{};
+  for (auto const& s : shards_) {
+    auto const lock = std::lock_guard{s->mtx_};
+    for (auto const& e : s->lru_) {
+      keys.emplace_back(e->key_, e->hits_.load());
+    }
+  }
+  auto const count = std::min(n, keys.size());
+  std::partial_sort(
+      begin(keys), begin(keys) + static_cast<std::ptrdiff_t>(count), end(keys),
+      [](auto&& a, auto&& b) { return a.second > b.second; });
+  keys.resize(count);
+  return keys;
+}
+
+}  // namespace adr
\ No newline at end of file
@@ -153,6 +153,28 @@ void reverse::write(import_context& ctx) {
   ctx.street_segments_.clear();
 }
 
+void reverse::add_street_segments(import_context& ctx,
+                                  street_idx_t const street,
+                                  reverse const& o,
+                                  street_idx_t const other_street) {
+  ctx.street_segments_.resize(
+      std::max(ctx.street_segments_.size(),
+               static_cast<std::size_t>(to_idx(street) + 1U)));
+  auto& segments = ctx.street_segments_[to_idx(street)];
+  if (to_idx(other_street) >= o.street_segments_.size()) {
+    return;
+  }
+  for (auto const segment : o.street_segments_[other_street]) {
+    segments.emplace_back(segment);
+  }
+}
+
+void reverse::add_street_segments(reverse const& o) {
+  for (auto const street_segments : o.street_segments_) {
+    street_segments_.emplace_back(street_segments);
+  }
+}
+
 void reverse::build_rtree(typeahead const& t) {
   auto const timer = utl::scoped_timer{"build rtree"};
 
@@ -0,0 +1,117 @@
+#include "adr/shard_router.h"
+
+#include <array>
+#include <cstring>
+
+#include "oneapi/tbb/parallel_for.h"
+
+#include "ankerl/cista_adapter.h"
+
+#include "utl/enumerate.h"
+#include "utl/helpers/algorithm.h"
+#include "utl/to_vec.h"
+
+#include "adr/osm_filter.h"
+#include "adr/typeahead.h"
+
+namespace fs = std::filesystem;
+
+namespace adr {
+
+template <typename T>
+void append_bytes(std::string& key, T const& x) {
+  auto buf = std::array<char, sizeof(T)>{};
+  std::memcpy(buf.data(), &x, sizeof(T));
+  key.append(buf.data(), buf.size());
+}
+
+// Identity of a result across shards: places by OSM id, streets and house
+// numbers by street name, house number and position.
+std::string get_dedup_key(typeahead const& t, suggestion const& s) {
+  auto key = std::string{};
+  if (std::holds_alternative<place_idx_t>(s.location_)) {
+    auto const p = std::get<place_idx_t>(s.location_);
+    key.push_back('p');
+    append_bytes(key, osm_key(static_cast<std::int64_t>(s.get_osm_id(t)),
+                              t.place_is_way_.test(to_idx(p))));
+    return key;
+  }
+
+  auto const& a = std::get<address>(s.location_);
+  key.push_back('a');
+  key.append(t.strings_[t.street_names_[a.street_][kDefaultLangIdx]].view());
+  key.push_back('\0');
+  if (a.house_number_ != address::kNoHouseNumber) {
+    key.append(t.strings_[t.house_numbers_[a.street_][a.house_number_]].view());
+  }
+  key.push_back('\0');
+  append_bytes(key, s.coordinates_.lat_);
+  append_bytes(key, s.coordinates_.lng_);
+  return key;
+}
+
+shard_router::shard_router(std::vector<fs::path> const& dirs,
+                           index_generation::config const& c)
+    : shards_{utl::to_vec(dirs, [&](fs::path const& dir) {
+        return std::make_unique<index_handle>(dir, c);
+      })} {}
+
+std::vector<shard_suggestion> shard_router::get_suggestions(
+    context& ctx,
+    std::string const& input,
+    unsigned const n_suggestions,
+    std::vector<std::string> const& languages,
+    std::optional<geo::latlng> const& coord,
+    float const bias,
+    filter_type const filter) const {
+  ctx.generations_.resize(shards_.size());
+  ctx.ctxs_.resize(shards_.size());
+
+  oneapi::tbb::parallel_for(std::size_t{0U}, shards_.size(), [&](auto i) {
+    auto const g = shards_[i]->get();
+    if (ctx.generations_[i] != g) {
+      if (ctx.ctxs_[i] == nullptr) {
+        ctx.ctxs_[i] = std::make_unique<guess_context>(g->make_context());
+      } else {
+        g->bind(*ctx.ctxs_[i]);
+      }
+      ctx.generations_[i] = g;
+    }
+
+    auto langs = basic_string<language_idx_t>{{kDefaultLang}};
+    for (auto const& l : languages) {
+      auto const l_idx = g->t_->resolve_language(l);
+      if (l_idx != language_idx_t::invalid()) {
+        langs.push_back(l_idx);
+      }
+    }
+
+    adr::get_suggestions<false>(*g->t_, input, n_suggestions, langs,
+                                *ctx.ctxs_[i], coord, bias, filter);
+  });
+
+  auto merged = std::vector<shard_suggestion>{};
+  for (auto const [i, shard_ctx] : utl::enumerate(ctx.ctxs_)) {
+    for (auto const& s : shard_ctx->suggestions_) {
+      merged.push_back({.shard_ = i, .s_ = s});
+    }
+  }
+  utl::sort(merged, [](auto&& a, auto&& b) { return a.s_ < b.s_; });
+
+  // Regional shards overlap at their borders: keep the best scored result
+  // of each place / address only.
+  auto seen = cista::raw::ankerl_set<std::string>{};
+  auto deduplicated = std::vector<shard_suggestion>{};
+  for (auto& x : merged) {
+    if (deduplicated.size() == n_suggestions) {
+      break;
+    }
+    if (seen.emplace(get_dedup_key(*ctx.generations_[x.shard_]->t_, x.s_))
+            .second) {
+      deduplicated.push_back(std::move(x));
+    }
+  }
+  return deduplicated;
+}
+
+}  // namespace adr
\ No newline at end of file
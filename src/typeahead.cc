@@ -1,14 +1,30 @@
 #include "adr/typeahead.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <span>
 #include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 #include "cista/io.h"
+#include "cista/memory_holder.h"
+#include "cista/mmap.h"
+#include "cista/serialization.h"
 
 #include "utl/erase_duplicates.h"
 #include "utl/get_or_create.h"
 #include "utl/insert_sorted.h"
+#include "utl/parallel_for.h"
 #include "utl/parser/arg_parser.h"
 #include "utl/timing.h"
+#include "utl/to_vec.h"
 #include "utl/zip.h"
 
 #include "osmium/geom/coordinates.hpp"
@@ -17,6 +33,7 @@
 #include "adr/adr.h"
 #include "adr/guess_context.h"
 #include "adr/import_context.h"
+#include "adr/osm_filter.h"
 #include "adr/trace.h"
 
 using namespace std::string_view_literals;
@@ -201,12 +218,14 @@ street_idx_t typeahead::get_or_create_street(import_context& ctx,
 
 void typeahead::add_address(import_context& ctx,
                             osmium::TagList const& tags,
+                            tag_class const c,
                             osmium::Location const& l) {
-  auto const house_number = tags["addr:housenumber"];
-  if (house_number == nullptr) {
+  if (!c.is_address()) {
     return;
   }
 
+  auto const house_number = tags["addr:housenumber"];
+
   // Addresses in quarters without street names (e.g. Bulgarian ж.к. housing
   // estates) reference the quarter by name via addr:place instead of
   // addr:street. Index the quarter name like a street name in that case.
@@ -214,9 +233,6 @@ void typeahead::add_address(import_context& ctx,
   if (street == nullptr) {
     street = tags["addr:place"];
   }
-  if (street == nullptr) {
-    return;
-  }
 
   auto const lock = std::scoped_lock{ctx.mutex_};
   auto const street_idx = get_or_create_street(ctx, street);
@@ -231,34 +247,122 @@ void typeahead::add_address(import_context& ctx,
 
 street_idx_t typeahead::add_street(import_context& ctx,
                                    osmium::TagList const& tags,
+                                   tag_class const c,
                                    osmium::Location const& l) {
-  auto const name = tags["name"];
-  if (name == nullptr) {
+  if (!c.has(tag_class::kName)) {
     return street_idx_t::invalid();
   }
 
+  auto const name = tags["name"];
+
   auto const lock = std::scoped_lock{ctx.mutex_};
   auto const street_idx = get_or_create_street(ctx, name);
-  for (auto const p : ctx.street_pos_[street_idx]) {
-    if (osmium::geom::haversine::distance(
-            osmium::geom::Coordinates{l},
-            osmium::geom::Coordinates{p.as_location()}) < 1500.0) {
-      return street_idx;
+  ctx.street_pos_[street_idx].emplace_back(coordinates::from_location(l));
+  return street_idx;
+}
+
+// Cluster representatives of one street name, hashed by their cell in a 3D
+// (earth centered) grid with cells of kStreetClusterRadius. The straight line
+// distance is shorter than the great circle distance, so all representatives
+// within the radius are in the 27 cells around a position.
+struct street_cluster_grid {
+  static constexpr auto const kNoRep =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct rep {
+    coordinates c_;
+    std::uint32_t next_;
+  };
+
+  static std::array<std::int32_t, 3U> get_cell(coordinates const c) {
+    constexpr auto const kEarthRadius = 6'371'000.0;
+    constexpr auto const kToRad = std::numbers::pi / 180.0;
+    auto const lat = c.lat() * kToRad;
+    auto const lng = c.lon() * kToRad;
+    auto const cell = [](double const x) {
+      return static_cast<std::int32_t>(
+          std::floor(kEarthRadius * x / kStreetClusterRadius));
+    };
+    return {cell(std::cos(lat) * std::cos(lng)),
+            cell(std::cos(lat) * std::sin(lng)), cell(std::sin(lat))};
+  }
+
+  static std::uint64_t get_key(std::int32_t const x,
+                               std::int32_t const y,
+                               std::int32_t const z) {
+    constexpr auto const kOffset = std::int32_t{1} << 20U;
+    constexpr auto const kMask = (std::uint64_t{1U} << 21U) - 1U;
+    return ((static_cast<std::uint64_t>(x + kOffset) & kMask) << 42U) |
+           ((static_cast<std::uint64_t>(y + kOffset) & kMask) << 21U) |
+           (static_cast<std::uint64_t>(z + kOffset) & kMask);
+  }
+
+  void clear() {
+    cells_.clear();
+    reps_.clear();
+  }
+
+  // Adds c as representative if there is none within the radius.
+  bool add(coordinates const c) {
+    auto const [x, y, z] = get_cell(c);
+    for (auto dx = -1; dx <= 1; ++dx) {
+      for (auto dy = -1; dy <= 1; ++dy) {
+        for (auto dz = -1; dz <= 1; ++dz) {
+          auto const it = cells_.find(get_key(x + dx, y + dy, z + dz));
+          if (it == end(cells_)) {
+            continue;
+          }
+          for (auto r = it->second; r != kNoRep; r = reps_[r].next_) {
+            if (osmium::geom::haversine::distance(
+                    osmium::geom::Coordinates{c.as_location()},
+                    osmium::geom::Coordinates{reps_[r].c_.as_location()}) <
+                kStreetClusterRadius) {
+              return false;
+            }
+          }
+        }
+      }
     }
+
+    auto& head = cells_.emplace(get_key(x, y, z), kNoRep).first->second;
+    reps_.push_back({.c_ = c, .next_ = head});
+    head = static_cast<std::uint32_t>(reps_.size() - 1U);
+    return true;
   }
 
-  ctx.street_pos_[street_idx].emplace_back(coordinates::from_location(l));
+  cista::raw::ankerl_map<std::uint64_t, std::uint32_t> cells_;
+  std::vector<rep> reps_;
+};
+
+void typeahead::cluster_street_positions(import_context& ctx) {
+  auto clustered = std::vector<std::vector<coordinates>>{};
+  clustered.resize(ctx.street_pos_.size());
+
+  utl::parallel_for_run_threadlocal<street_cluster_grid>(
+      ctx.street_pos_.size(),
+      [&](street_cluster_grid& grid, std::size_t const i) {
+        grid.clear();
+        for (auto const c : ctx.street_pos_[street_idx_t{i}]) {
+          if (grid.add(c)) {
+            clustered[i].emplace_back(c);
+          }
+        }
+      });
 
-  return street_idx;
+  street_pos_.clear();
+  for (auto const& x : clustered) {
+    street_pos_.emplace_back(x);
+  }
+  ctx.street_pos_ = {};
 }
 
 void typeahead::add_place(import_context& ctx,
                           std::int64_t const id,
                           bool const is_way,
                           osmium::TagList const& tags,
+                          tag_class const c,
                           osmium::Location const& l) {
-  auto const name = tags["name"];
-  if (name == nullptr) {
+  if (!c.has(tag_class::kName)) {
     return;
   }
 
@@ -294,15 +398,14 @@ void typeahead::add_place(import_context& ctx,
   place_osm_ids_.emplace_back({id});
   place_is_way_.resize(place_is_way_.size() + 1U);
   place_is_way_.set(idx, is_way);
-  place_type_.emplace_back(amenity_tags{tags}.get_category());
+  place_type_.emplace_back(c.has(tag_class::kAmenity)
+                               ? amenity_tags{tags}.get_category()
+                               : amenity_category::kNone);
 }
 
 string_idx_t typeahead::get_or_create_string(import_context& ctx,
                                              std::string_view s) {
-  return utl::get_or_create(ctx.string_lookup_, s, [&]() {
-    strings_.emplace_back(s);
-    return string_idx_t{strings_.size() - 1U};
-  });
+  return ctx.string_lookup_.get_or_create(strings_, s);
 }
 
 area_set_idx_t typeahead::get_or_create_area_set(
@@ -314,25 +417,268 @@ area_set_idx_t typeahead::get_or_create_area_set(
   });
 }
 
+// Consecutive strings processed by one task of build_ngram_index(): their
+// distinct bigrams (string_ends_[i] = end of string i in bigrams_) and the
+// number of strings per bigram.
+struct ngram_chunk {
+  std::vector<ngram_t> bigrams_;
+  std::vector<std::uint32_t> string_ends_;
+  std::vector<std::uint32_t> counts_;
+};
+
 void typeahead::build_ngram_index() {
-  auto normalize_buf = utf8_normalize_buf_t{};
-  auto tmp = std::vector<std::vector<string_idx_t>>{};
-  tmp.resize(kNBigrams);
+  auto const has_location = [&](string_idx_t const i) {
+    return i < string_to_location_.size() && !string_to_location_[i].empty();
+  };
+
+  numeric_strings_.resize(static_cast<unsigned>(strings_.size()));
+  for (auto const [i, s] : utl::enumerate(strings_)) {
+    numeric_strings_.set(static_cast<unsigned>(i), is_numeric(s.view()));
+  }
   n_bigrams_.resize(strings_.size());
-  for (auto const [i, str_idx] : utl::enumerate(strings_)) {
-    auto const normalized = normalize(str_idx.view(), normalize_buf);
-    n_bigrams_[string_idx_t{i}] = static_cast<std::uint8_t>(std::min(
-        static_cast<std::size_t>(std::numeric_limits<std::uint8_t>::max()),
-        normalized.size() - 1U));
-    for_each_bigram(normalized, [&, i](std::string_view bigram) {
-      tmp[compress_bigram(bigram)].emplace_back(i);
+
+  // Pass 1 (parallel over chunks of consecutive strings): normalize, collect
+  // the distinct bigrams of each string and count them per chunk.
+  auto const n_strings = static_cast<std::size_t>(strings_.size());
+  auto const n_chunks = std::max(
+      std::size_t{1U},
+      std::min(n_strings / 1024U,
+               std::size_t{std::thread::hardware_concurrency()} * 4U));
+  auto const chunk_size = (n_strings + n_chunks - 1U) / n_chunks;
+  auto chunks = std::vector<ngram_chunk>(n_chunks);
+  utl::parallel_for_run(n_chunks, [&](std::size_t const c) {
+    auto& chunk = chunks[c];
+    chunk.counts_.resize(kNBigrams, 0U);
+
+    auto normalize_buf = utf8_normalize_buf_t{};
+    auto last_seen = std::vector<std::uint32_t>(kNBigrams, 0U);
+    auto const from = c * chunk_size;
+    auto const to = std::min(n_strings, from + chunk_size);
+    for (auto i = from; i < to; ++i) {
+      auto const str_idx = string_idx_t{i};
+      auto const normalized =
+          normalize(strings_[str_idx].view(), normalize_buf);
+      n_bigrams_[str_idx] = static_cast<std::uint8_t>(std::min(
+          static_cast<std::size_t>(std::numeric_limits<std::uint8_t>::max()),
+          normalized.size() - 1U));
+      if (!numeric_strings_.test(static_cast<unsigned>(i)) ||
+          has_location(str_idx)) {
+        // Strings are processed in order: a bigram already seen for this
+        // string is a duplicate (last_seen stores string index + 1).
+        for_each_bigram(normalized, [&](std::string_view bigram) {
+          auto const b = compress_bigram(bigram);
+          if (last_seen[b] != i + 1U) {
+            last_seen[b] = static_cast<std::uint32_t>(i + 1U);
+            chunk.bigrams_.push_back(b);
+            ++chunk.counts_[b];
+          }
+        });
+      }
+      chunk.string_ends_.push_back(
+          static_cast<std::uint32_t>(chunk.bigrams_.size()));
+    }
+  });
+
+  // Prefix sum: bucket starts and the write offset of each chunk per bigram.
+  bigrams_.clear();
+  bigrams_.bucket_starts_.resize(kNBigrams + 1U);
+  auto offset = std::uint32_t{0U};
+  for (auto b = 0U; b != kNBigrams; ++b) {
+    bigrams_.bucket_starts_[b] = offset;
+    for (auto& chunk : chunks) {
+      auto const count = chunk.counts_[b];
+      chunk.counts_[b] = offset;
+      offset += count;
+    }
+  }
+  bigrams_.bucket_starts_[kNBigrams] = offset;
+  bigrams_.data_.resize(offset);
+
+  // Pass 2 (parallel): scatter. Each bucket is sorted by string index
+  // because chunks and the strings within a chunk are in order.
+  utl::parallel_for_run(n_chunks, [&](std::size_t const c) {
+    auto& chunk = chunks[c];
+    auto i = c * chunk_size;
+    auto str_begin = std::uint32_t{0U};
+    for (auto const str_end : chunk.string_ends_) {
+      for (auto j = str_begin; j != str_end; ++j) {
+        bigrams_.data_[chunk.counts_[chunk.bigrams_[j]]++] = string_idx_t{i};
+      }
+      str_begin = str_end;
+      ++i;
+    }
+    chunk = {};
+  });
+
+  string_types_.clear();
+  string_types_.resize(strings_.size(), filter_type::kNone);
+  for (auto i = string_idx_t{0U}; i < string_to_location_.size(); ++i) {
+    for (auto const [l, type] :
+         utl::zip(string_to_location_[i], string_to_type_[i])) {
+      switch (type) {
+        case location_type_t::kStreet:
+          string_types_[i] |= filter_type::kAddress;
+          break;
+        case location_type_t::kPlace:
+          string_types_[i] |=
+              place_type_[place_idx_t{l}] == amenity_category::kExtra
+                  ? filter_type::kExtra
+                  : filter_type::kPlace;
+          break;
+      }
+    }
+  }
+}
+
+bool typeahead::is_globally_relevant(place_idx_t const p) const {
+  switch (place_type_[p]) {
+    case amenity_category::kCountry:
+    case amenity_category::kState:
+    case amenity_category::kRegion:
+    case amenity_category::kCity: return true;
+    default: return place_population_[p].get() >= 100'000U;
+  }
+}
+
+void typeahead::build_short_prefix_index() {
+  auto const is_better = [&](short_prefix_match const& a,
+                             short_prefix_match const& b) {
+    auto const pop_a = place_population_[a.place_].get();
+    auto const pop_b = place_population_[b.place_].get();
+    if (pop_a != pop_b) {
+      return pop_a > pop_b;
+    }
+    auto const relevant_a = is_globally_relevant(a.place_);
+    auto const relevant_b = is_globally_relevant(b.place_);
+    if (relevant_a != relevant_b) {
+      return relevant_a;
+    }
+    return a.place_ < b.place_;
+  };
+  auto const keep_top_k = [&](std::vector<short_prefix_match>& matches) {
+    utl::sort(matches, [](auto&& a, auto&& b) {
+      return std::tie(a.place_, a.str_) < std::tie(b.place_, b.str_);
     });
+    matches.erase(std::unique(begin(matches), end(matches),
+                              [](auto&& a, auto&& b) {
+                                return a.place_ == b.place_;
+                              }),
+                  end(matches));
+    if (matches.size() > kShortPrefixTopK) {
+      std::nth_element(begin(matches), begin(matches) + kShortPrefixTopK,
+                       end(matches), is_better);
+      matches.resize(kShortPrefixTopK);
+    }
+  };
+
+  auto normalize_buf = utf8_normalize_buf_t{};
+  auto tmp = cista::raw::ankerl_map<std::string,
+                                    std::vector<short_prefix_match>>{};
+  for (auto p = place_idx_t{0U}; p < place_names_.size(); ++p) {
+    for (auto const str : place_names_[p]) {
+      auto const normalized = normalize(strings_[str].view(), normalize_buf);
+      auto n_codepoints = 0U;
+      for (auto i = 0U; i <= normalized.size(); ++i) {
+        if (i != 0U && (i == normalized.size() ||
+                        !is_utf8_continuation(normalized[i]))) {
+          auto& matches = tmp[std::string{normalized.substr(0U, i)}];
+          matches.push_back({p, str});
+          if (matches.size() > 4U * kShortPrefixTopK) {
+            keep_top_k(matches);
+          }
+          if (++n_codepoints == kMaxShortPrefix) {
+            break;
+          }
+        }
+      }
+    }
   }
 
-  bigrams_.clear();
+  auto prefixes = utl::to_vec(tmp, [](auto&& x) { return x.first; });
+  utl::sort(prefixes);
+
+  short_prefixes_.clear();
+  short_prefix_matches_.clear();
+  for (auto const& prefix : prefixes) {
+    auto& matches = tmp.find(prefix)->second;
+    keep_top_k(matches);
+    utl::sort(matches, is_better);
+    short_prefixes_.emplace_back(prefix);
+    short_prefix_matches_.emplace_back(matches);
+  }
+}
+
+std::optional<std::uint32_t> typeahead::find_short_prefix(
+    std::string_view const normalized_prefix) const {
+  auto lo = std::uint32_t{0U};
+  auto hi = static_cast<std::uint32_t>(short_prefixes_.size());
+  while (lo < hi) {
+    auto const mid = lo + (hi - lo) / 2U;
+    if (short_prefixes_[mid].view() < normalized_prefix) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo != short_prefixes_.size() &&
+                 short_prefixes_[lo].view() == normalized_prefix
+             ? std::optional{lo}
+             : std::nullopt;
+}
+
+void typeahead::build_geo_ngram_index() {
+  auto normalize_buf = utf8_normalize_buf_t{};
+  auto cells = std::vector<geo_cell_t>{};
+  auto str_bigrams = std::vector<ngram_t>{};
+  auto tmp = std::vector<std::vector<geo_posting>>{};
+  tmp.resize(kNBigrams);
+  for (auto i = string_idx_t{0U}; i < string_to_location_.size(); ++i) {
+    cells.clear();
+    for (auto const [l, type] :
+         utl::zip(string_to_location_[i], string_to_type_[i])) {
+      switch (type) {
+        case location_type_t::kStreet:
+          for (auto const& c : street_pos_[street_idx_t{l}]) {
+            cells.emplace_back(to_geo_cell(c.as_latlng()));
+          }
+          break;
+
+        case location_type_t::kPlace: {
+          auto const p = place_idx_t{l};
+          cells.emplace_back(is_globally_relevant(p)
+                                 ? kGlobalGeoCell
+                                 : to_geo_cell(place_coordinates_[p]));
+          break;
+        }
+      }
+    }
+    if (cells.empty()) {
+      continue;
+    }
+    utl::erase_duplicates(cells);
+
+    str_bigrams.clear();
+    for_each_bigram(normalize(strings_[i].view(), normalize_buf),
+                    [&](std::string_view bigram) {
+                      str_bigrams.emplace_back(compress_bigram(bigram));
+                    });
+    utl::erase_duplicates(str_bigrams);
+
+    for (auto const bigram : str_bigrams) {
+      for (auto const cell : cells) {
+        tmp[bigram].emplace_back(geo_posting{.cell_ = cell, .str_ = i});
+      }
+    }
+  }
+
+  geo_bigrams_.clear();
   for (auto& x : tmp) {
-    utl::erase_duplicates(x);
-    bigrams_.emplace_back(x);
+    // Strings were visited in order: stable sort keeps them sorted per cell.
+    std::stable_sort(begin(x), end(x),
+                     [](geo_posting const& a, geo_posting const& b) {
+                       return a.cell_ < b.cell_;
+                     });
+    geo_bigrams_.emplace_back(x);
   }
 }
 
@@ -369,12 +715,282 @@ bool typeahead::verify() {
   return true;
 }
 
+constexpr auto const kCutoff = 0.17;
+
+// Regions (cell radius around the query coordinate) searched before falling
+// back to a full scan. Stops early as soon as enough candidates are found.
+constexpr auto const kGeoSearchRadii = std::array<std::int32_t, 2U>{1, 3};
+constexpr auto const kMinGeoMatches = std::size_t{1000U};
+
+struct geo_cell_cmp {
+  bool operator()(geo_posting const& a, geo_cell_t const b) const {
+    return a.cell_ < b;
+  }
+  bool operator()(geo_cell_t const a, geo_posting const& b) const {
+    return a < b.cell_;
+  }
+};
+
+// Filtered queries skip strings without a location of the requested type.
+bool is_allowed(typeahead const& t,
+                filter_type const filter,
+                string_idx_t const str) {
+  return t.string_types_.empty() || allows(filter, t.string_types_[str]);
+}
+
+// Counts bigram matches of strings located in the cells around `near` (and
+// in the global cell). Returns true if this yields enough candidates to skip
+// the full scan. ctx.geo_match_counts_ holds the strings of the widest
+// searched region afterwards.
 template <bool Debug>
-void typeahead::guess(std::string_view normalized, guess_context& ctx) const {
+bool guess_near(typeahead const& t,
+                ngram_set_t const& ngram_set,
+                unsigned const n_in_ngrams,
+                unsigned const min_match_count,
+                geo::latlng const& near,
+                filter_type const filter,
+                guess_context& ctx) {
+  auto& matches = ctx.string_matches_;
+  auto& counts = ctx.geo_match_counts_;
+  auto stopwatch = query_profile::stopwatch{ctx.profile_};
+  for (auto const radius : kGeoSearchRadii) {
+    UTL_START_TIMING(count);
+    counts.clear();
+    auto ngram_marker = std::uint8_t{0U};
+    for (auto const ngram : ngram_set) {
+      ++ngram_marker;
+      auto const postings = t.geo_bigrams_[ngram];
+      auto const count_cell = [&](geo_cell_t const cell) {
+        auto const [from, to] = std::equal_range(
+            begin(postings), end(postings), cell, geo_cell_cmp{});
+        for (auto it = from; it != to; ++it) {
+          // A string can be located in multiple cells of the region:
+          // count each bigram only once per string.
+          auto& c = counts[it->str_];
+          if (c.last_ngram_ != ngram_marker) {
+            c.last_ngram_ = ngram_marker;
+            ++c.count_;
+          }
+        }
+      };
+      count_cell(kGlobalGeoCell);
+      for_each_geo_cell(near, radius, count_cell);
+    }
+    stopwatch.lap(query_stage::kCount);
+
+    matches.clear();
+    for (auto const& [str, c] : counts) {
+      if (c.count_ < min_match_count || !is_allowed(t, filter, str)) {
+        continue;
+      }
+      auto const cos_sim = static_cast<float>(c.count_ * c.count_) /
+                           (t.n_bigrams_[str] * n_in_ngrams);
+      if (cos_sim >= kCutoff) {
+        matches.emplace_back(cos_sim_match{str, cos_sim});
+      }
+    }
+    stopwatch.lap(query_stage::kCosSim);
+    UTL_STOP_TIMING(count);
+    trace("geo radius={}: {} strings, {} matches [{} ms]", radius,
+          counts.size(), matches.size(), UTL_TIMING_MS(count));
+
+    if (matches.size() >= kMinGeoMatches) {
+      ctx.profile_.geo_candidates_ = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Dynamic pruning is used if the essential postings (see guess_top_k) are at
+// most this share of all postings of the query bigrams.
+constexpr auto const kMaxEssentialShare = 0.5;
+
+// String index range counted at once by guess_top_k.
+constexpr auto const kPruneWindow = std::uint32_t{1U} << 12U;
+
+// Moves pos to the first posting >= s (galloping search).
+std::size_t advance_to(std::span<string_idx_t const> postings,
+                       std::size_t pos,
+                       string_idx_t const s) {
+  auto step = std::size_t{1U};
+  while (pos + step < postings.size() && postings[pos + step] < s) {
+    pos += step;
+    step *= 2U;
+  }
+  auto const last = std::min(pos + step + 1U, postings.size());
+  return static_cast<std::size_t>(std::distance(
+      begin(postings), std::lower_bound(begin(postings) + pos,
+                                        begin(postings) + last, s)));
+}
+
+// Top-k candidate generation with dynamic pruning (MaxScore). Each query
+// bigram adds at most 1 to the match count c of a string and c is at most
+// n_bigrams_ of the string, so cos_sim = c^2 / (n_bigrams_ * n_in) <= c /
+// n_in. A string needs c >= theta to reach kCutoff (or the worst of the k
+// best candidates found so far): it has to occur in one of the m - theta + 1
+// shortest postings lists ("essential"). The theta - 1 longest lists are
+// only probed for strings found in the essential lists and only as long as
+// the string can still reach the threshold.
+//
+// Postings are sorted by string index: the essential lists are counted
+// window by window (kPruneWindow strings), probes advance through the long
+// lists with galloping search. Returns false without generating candidates
+// if pruning would not skip enough postings.
+template <bool Debug>
+bool guess_top_k(typeahead const& t,
+                 ngram_set_t const& ngram_set,
+                 unsigned const n_in_ngrams,
+                 unsigned const min_match_count,
+                 filter_type const filter,
+                 guess_context& ctx) {
+  auto lists = std::array<std::span<string_idx_t const>, 128U>{};
+  auto m = 0U;
+  for (auto const ngram : ngram_set) {
+    if (m == lists.size()) {
+      break;
+    }
+    auto const postings = t.bigrams_[ngram];
+    lists[m++] = {postings.begin(), postings.end()};
+  }
+  std::sort(begin(lists), begin(lists) + m,
+            [](auto&& a, auto&& b) { return a.size() < b.size(); });
+
+  auto const cos_sim = [&](unsigned const c, unsigned const n_bigrams) {
+    return static_cast<float>(c * c) / (n_bigrams * n_in_ngrams);
+  };
+
+  // Smallest match count that can reach the threshold (m + 1 = none).
+  auto const min_count = [&](float const threshold) {
+    for (auto c = std::max(min_match_count, 1U); c <= m; ++c) {
+      if (cos_sim(c, c) >= threshold) {
+        return c;
+      }
+    }
+    return m + 1U;
+  };
+
+  auto threshold = static_cast<float>(kCutoff);
+  auto n_essential = m - std::min(m, min_count(threshold) - 1U);
+  auto essential_postings = std::size_t{0U};
+  auto total_postings = std::size_t{0U};
+  for (auto i = 0U; i != m; ++i) {
+    essential_postings += i < n_essential ? lists[i].size() : 0U;
+    total_postings += lists[i].size();
+  }
+  if (n_essential == m || static_cast<double>(essential_postings) >
+                              kMaxEssentialShare * total_postings) {
+    return false;
+  }
+
+  auto& matches = ctx.string_matches_;
+  auto& counts = ctx.window_counts_;
+  auto& window = ctx.window_strings_;
+  counts.resize(kPruneWindow);
+  matches.clear();
+
+  auto const k = std::max(ctx.limits_.max_matches_, std::size_t{1U});
+
+  // Can a string reach the threshold with at most c_max matches?
+  auto const can_reach = [&](unsigned const c_max, unsigned const n_bigrams) {
+    auto const c = std::min(c_max, n_bigrams);
+    return c >= min_match_count && n_bigrams != 0U &&
+           cos_sim(c, n_bigrams) >= threshold;
+  };
+
+  auto pos = std::array<std::size_t, 128U>{};
+  auto n_probes = std::size_t{0U};
+  while (true) {
+    // The next window starts at the smallest unprocessed essential posting.
+    auto from = std::numeric_limits<std::uint32_t>::max();
+    for (auto i = 0U; i != n_essential; ++i) {
+      if (pos[i] != lists[i].size()) {
+        from = std::min(from, to_idx(lists[i][pos[i]]));
+      }
+    }
+    if (from == std::numeric_limits<std::uint32_t>::max()) {
+      break;
+    }
+    auto const to = string_idx_t{static_cast<std::uint32_t>(
+        std::min(std::uint64_t{from} + kPruneWindow,
+                 std::uint64_t{std::numeric_limits<std::uint32_t>::max()}))};
+
+    window.clear();
+    for (auto i = 0U; i != n_essential; ++i) {
+      auto const list = lists[i];
+      for (; pos[i] != list.size() && list[pos[i]] < to; ++pos[i]) {
+        auto const offset = to_idx(list[pos[i]]) - from;
+        if (counts[offset]++ == 0U) {
+          window.push_back(offset);
+        }
+      }
+    }
+    std::sort(begin(window), end(window));
+
+    for (auto const offset : window) {
+      auto c = static_cast<unsigned>(counts[offset]);
+      counts[offset] = 0U;
+
+      auto const s = string_idx_t{from + offset};
+      auto const n_bigrams = static_cast<unsigned>(t.n_bigrams_[s]);
+      if (!can_reach(c + (m - n_essential), n_bigrams) ||
+          !is_allowed(t, filter, s)) {
+        continue;
+      }
+
+      auto reachable = true;
+      for (auto j = n_essential; j != m; ++j) {
+        if (!can_reach(c + (m - j), n_bigrams)) {
+          reachable = false;
+          break;
+        }
+        pos[j] = advance_to(lists[j], pos[j], s);
+        c += pos[j] != lists[j].size() && lists[j][pos[j]] == s ? 1U : 0U;
+        ++n_probes;
+      }
+      if (!reachable || !can_reach(c, n_bigrams)) {
+        continue;
+      }
+
+      // Heap: front = worst of the k best candidates.
+      auto const match = cos_sim_match{s, cos_sim(c, n_bigrams)};
+      if (matches.size() == k) {
+        if (match.cos_sim_ <= matches.front().cos_sim_) {
+          continue;
+        }
+        std::pop_heap(begin(matches), end(matches));
+        matches.back() = match;
+      } else {
+        matches.push_back(match);
+      }
+      std::push_heap(begin(matches), end(matches));
+      if (matches.size() == k) {
+        threshold = std::max(threshold, matches.front().cos_sim_);
+      }
+    }
+
+    // A higher threshold needs more matches: longer lists become
+    // non-essential (their cursors are already past this window).
+    n_essential =
+        std::min(n_essential, m - std::min(m, min_count(threshold) - 1U));
+  }
+
+  ctx.profile_.pruned_ = true;
+  trace("pruning: {}/{} essential postings, {} probes, {} matches",
+        essential_postings, total_postings, n_probes, matches.size());
+  return true;
+}
+
+template <bool Debug>
+void typeahead::guess(std::string_view normalized,
+                      guess_context& ctx,
+                      std::optional<geo::latlng> const& near,
+                      filter_type const filter) const {
   trace("guess: {}", normalized);
 
   auto& matches = ctx.string_matches_;
   matches.clear();
+  ctx.geo_match_counts_.clear();
 
   // ====================
   // COUNT NGRAM MATCHES
@@ -385,35 +1001,84 @@ void typeahead::guess(std::string_view normalized, guess_context& ctx) const {
 
   ctx.sqrt_len_vec_in_ = static_cast<float>(std::sqrt(normalized.size() - 1U));
   auto const [in_ngrams_buf, n_in_ngrams] = split_ngrams(normalized);
+  auto const ngram_set =
+      ngram_set_t{begin(in_ngrams_buf), begin(in_ngrams_buf) + n_in_ngrams};
+  auto const min_match_count = 2U + n_in_ngrams / (4U + n_in_ngrams / 10U);
+  ctx.profile_.n_ngrams_ = static_cast<std::uint32_t>(ngram_set.size());
+
+  // ===================
+  // LOCAL CANDIDATES
+  // -------------------
+  if (near.has_value() && !geo_bigrams_.empty() &&
+      guess_near<Debug>(*this, ngram_set, n_in_ngrams, min_match_count, *near,
+                        filter, ctx)) {
+    auto stopwatch = query_profile::stopwatch{ctx.profile_};
+    auto const limit = ctx.limits_.get_cos_sim_limit(matches);
+    if (matches.size() > limit) {
+      std::nth_element(begin(matches), begin(matches) + limit, end(matches));
+      matches.resize(limit);
+    }
+    utl::sort(matches);
+    stopwatch.lap(query_stage::kCosSim);
+    trace("{} local matches", matches.size());
+    return;
+  }
+
+  // =================
+  // DYNAMIC PRUNING
+  // -----------------
+  // Not combined with local candidates (they are kept regardless of their
+  // rank, see below).
+  if (ctx.prune_candidates_ && ctx.geo_match_counts_.empty()) {
+    auto stopwatch = query_profile::stopwatch{ctx.profile_};
+    if (guess_top_k<Debug>(*this, ngram_set, n_in_ngrams, min_match_count,
+                           filter, ctx)) {
+      stopwatch.lap(query_stage::kCount);
+      auto const limit = ctx.limits_.get_cos_sim_limit(matches);
+      if (matches.size() > limit) {
+        std::nth_element(begin(matches), begin(matches) + limit,
+                         end(matches));
+        matches.resize(limit);
+      }
+      utl::sort(matches);
+      stopwatch.lap(query_stage::kCosSim);
+      trace("{} pruned matches", matches.size());
+      return;
+    }
+  }
 
   // Collect candidate indices matched by the bigrams in the input
   // string.
   UTL_START_TIMING(t1);
-  auto const ngram_set =
-      ngram_set_t{begin(in_ngrams_buf), begin(in_ngrams_buf) + n_in_ngrams};
+  auto stopwatch = query_profile::stopwatch{ctx.profile_};
   auto missing = ngram_set_t{};
-  auto string_match_counts_ptr = ctx.cache_.get_closest(ngram_set, missing);
+  auto string_match_counts_ptr = ctx.cache_->get_closest(ngram_set, missing);
+  ctx.profile_.n_cached_ngrams_ =
+      static_cast<std::uint32_t>(ngram_set.size() - missing.size());
   auto& string_match_counts = *string_match_counts_ptr;
   for (auto const& missing_ngram : missing) {
     for (auto const string_idx : bigrams_[missing_ngram]) {
       ++string_match_counts[string_idx];
     }
   }
-  ctx.cache_.add(ngram_set, string_match_counts_ptr);
+  ctx.cache_->add(ngram_set, string_match_counts_ptr);
+  stopwatch.lap(query_stage::kCount);
   UTL_STOP_TIMING(t1);
   trace("counting matches [{} ms]", UTL_TIMING_MS(t1));
 
   // ================
   // COMPUTE COS SIM
   // ----------------
-  auto min_match_count = 2U + n_in_ngrams / (4U + n_in_ngrams / 10U);
   auto const n_strings = strings_.size();
   UTL_START_TIMING(t3);
-  constexpr auto kCutoff = 0.17;
+  matches.clear();
   for (auto i = string_idx_t{0U}; i < n_strings; ++i) {
     if (string_match_counts[i] < min_match_count) {
       [[likely]] continue;
     }
+    if (!is_allowed(*this, filter, i)) {
+      continue;
+    }
     auto const match_count = string_match_counts[i];
     auto const cos_sim = static_cast<float>(match_count * match_count) /
                          (n_bigrams_[i] * n_in_ngrams);
@@ -425,26 +1090,89 @@ void typeahead::guess(std::string_view normalized, guess_context& ctx) const {
   // ===============
   // RESTRICT + SORT
   // ---------------
-  constexpr auto kMaxMatches = std::size_t{6000U};
-  auto const n_matches = std::min(kMaxMatches, matches.size());
-  if (matches.size() >= n_matches) {
-    std::nth_element(begin(matches), begin(matches) + n_matches, end(matches));
-    matches.resize(n_matches);
+  auto const limit = ctx.limits_.get_cos_sim_limit(matches);
+  if (matches.size() > limit) {
+    // Candidates from the region around the query coordinate (if any) are
+    // kept, the remaining slots are filled with the best global candidates.
+    // More local candidates than slots: the best local ones are kept.
+    auto const is_local = [&](cos_sim_match const m) {
+      return ctx.geo_match_counts_.contains(m.idx_);
+    };
+    auto const n_local = static_cast<std::size_t>(std::distance(
+        begin(matches), std::partition(begin(matches), end(matches), is_local)));
+    if (n_local >= limit) {
+      std::nth_element(begin(matches), begin(matches) + limit,
+                       begin(matches) + n_local);
+    } else {
+      std::nth_element(begin(matches) + n_local, begin(matches) + limit,
+                       end(matches));
+    }
+    matches.resize(limit);
   }
   utl::sort(matches);
+  stopwatch.lap(query_stage::kCosSim);
 
   UTL_STOP_TIMING(t3);
 
   trace("{} matches [{} ms]", matches.size(), UTL_TIMING_MS(t3));
 }
 
-cista::wrapped<typeahead> read(std::filesystem::path const& p) {
-  return cista::read<typeahead>(p);
+constexpr auto const kMode = cista::mode::NONE;
+
+void write(std::filesystem::path const& p, typeahead const& t) {
+  auto mmap =
+      cista::mmap{p.generic_string().c_str(), cista::mmap::protection::WRITE};
+  auto writer = cista::buf<cista::mmap>(std::move(mmap));
+  cista::serialize<kMode>(writer, t);
+}
+
+void advise(cista::buf<cista::mmap>& b, load_mode const mode) {
+#if defined(__linux__)
+  auto const base = static_cast<void*>(b.base());
+  auto const size = b.size();
+#if defined(MADV_HUGEPAGE)
+  ::madvise(base, size, MADV_HUGEPAGE);
+#endif
+  if (mode == load_mode::kMmapPrefault) {
+#if defined(MADV_POPULATE_READ)
+    if (::madvise(base, size, MADV_POPULATE_READ) == 0) {
+      return;
+    }
+#endif
+    ::madvise(base, size, MADV_WILLNEED);
+  }
+#else
+  (void)b;
+  (void)mode;
+#endif
+}
+
+cista::wrapped<typeahead> read(std::filesystem::path const& p,
+                               load_mode const mode) {
+  if (mode == load_mode::kRead) {
+    auto b = cista::file{p.generic_string().c_str(), "r"}.content();
+    auto const ptr = cista::deserialize<typeahead, kMode>(b);
+    return cista::wrapped{cista::memory_holder{std::move(b)}, ptr};
+  }
+
+  // Zero-copy: offset containers are used in place (CAST), the mapping is
+  // shared with other processes through the page cache.
+  auto mem = cista::memory_holder{cista::buf<cista::mmap>{
+      cista::mmap{p.generic_string().c_str(), cista::mmap::protection::READ}}};
+  auto& b = std::get<cista::buf<cista::mmap>>(mem);
+  advise(b, mode);
+  auto const ptr =
+      cista::deserialize<typeahead, kMode | cista::mode::CAST>(b);
+  return cista::wrapped{std::move(mem), ptr};
 }
 
 template void typeahead::guess<true>(std::string_view normalized,
-                                     guess_context&) const;
+                                     guess_context&,
+                                     std::optional<geo::latlng> const&,
+                                     filter_type) const;
 template void typeahead::guess<false>(std::string_view normalized,
-                                      guess_context&) const;
+                                      guess_context&,
+                                      std::optional<geo::latlng> const&,
+                                      filter_type) const;
 
 }  // namespace adr
\ No newline at end of file
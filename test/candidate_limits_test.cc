@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/typeahead.h"
+
+TEST(adr, candidate_limits) {
+  auto const cos_sim = [](std::initializer_list<float> values) {
+    auto v = std::vector<adr::cos_sim_match>{};
+    for (auto const x : values) {
+      v.push_back({.idx_ = adr::string_idx_t{0U}, .cos_sim_ = x});
+    }
+    return v;
+  };
+  auto const scored = [](std::initializer_list<float> values) {
+    auto v = std::vector<adr::scored_match<adr::place_idx_t>>{};
+    for (auto const x : values) {
+      v.push_back({.score_ = x,
+                   .phrase_idx_ = 0U,
+                   .string_idx_ = adr::string_idx_t{0U},
+                   .idx_ = adr::place_idx_t{0U}});
+    }
+    return v;
+  };
+
+  auto fixed = adr::candidate_limits::fixed();
+  fixed.max_matches_ = 3U;
+  fixed.max_scored_matches_ = 3U;
+  EXPECT_EQ(3U, fixed.get_cos_sim_limit(cos_sim({0.2F, 0.9F, 0.3F, 0.8F})));
+  EXPECT_EQ(2U, fixed.get_cos_sim_limit(cos_sim({0.2F, 0.9F})));
+  EXPECT_EQ(3U, fixed.get_score_limit(scored({1.F, 2.F, 3.F, 20.F})));
+
+  auto adaptive = adr::candidate_limits::adaptive();
+  adaptive.cos_sim_ratio_ = 0.5F;
+  adaptive.score_gap_ = 2.F;
+  adaptive.min_matches_ = 1U;
+  adaptive.min_scored_matches_ = 1U;
+  EXPECT_EQ(2U,
+            adaptive.get_cos_sim_limit(cos_sim({0.2F, 0.9F, 0.3F, 0.8F})));
+  EXPECT_EQ(3U, adaptive.get_score_limit(scored({1.F, 2.F, 3.F, 20.F})));
+  EXPECT_EQ(0U, adaptive.get_score_limit(scored({})));
+
+  // At least min_* candidates are kept.
+  adaptive.min_matches_ = 3U;
+  adaptive.min_scored_matches_ = 4U;
+  EXPECT_EQ(3U,
+            adaptive.get_cos_sim_limit(cos_sim({0.2F, 0.9F, 0.3F, 0.8F})));
+  EXPECT_EQ(4U, adaptive.get_score_limit(scored({1.F, 2.F, 3.F, 20.F})));
+}
+
+TEST(adr, candidate_limits_adaptive) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_limits", "/tmp");
+  auto const t = adr::read("adr_darmstadt_limits/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const query = std::string{"Landwehrstraße 4 Darmstadt"};
+
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  ASSERT_FALSE(ctx.suggestions_.empty());
+  auto const best = ctx.suggestions_.front().location_;
+  auto const fixed_strings = ctx.profile_.n_string_matches_;
+
+  ctx.limits_ = adr::candidate_limits::adaptive();
+  ctx.limits_.min_matches_ = 10U;
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  ASSERT_FALSE(ctx.suggestions_.empty());
+  EXPECT_EQ(best, ctx.suggestions_.front().location_);
+  EXPECT_LE(ctx.profile_.n_string_matches_, fixed_strings);
+}
\ No newline at end of file
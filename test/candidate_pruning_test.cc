@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/normalize.h"
+#include "adr/typeahead.h"
+
+TEST(adr, candidate_pruning) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_pruning", "/tmp");
+  auto const t = adr::read("adr_darmstadt_pruning/t.bin");
+
+  auto no_cache = adr::cache{t->strings_.size(), 0U};
+  auto dense = adr::guess_context{no_cache};
+  auto pruned = adr::guess_context{no_cache};
+  dense.resize(*t);
+  pruned.resize(*t);
+  pruned.prune_candidates_ = true;
+
+  auto const cos_sims = [](adr::guess_context const& ctx) {
+    auto v = std::vector<float>{};
+    for (auto const& m : ctx.string_matches_) {
+      v.push_back(m.cos_sim_);
+    }
+    return v;
+  };
+
+  auto buf = adr::utf8_normalize_buf_t{};
+  auto n_pruned = 0U;
+  for (auto const max_matches : {std::size_t{6000U}, std::size_t{20U}}) {
+    dense.limits_.max_matches_ = max_matches;
+    pruned.limits_.max_matches_ = max_matches;
+    for (auto const query :
+         {"Landwehrstraße 4 Darmstadt", "Darmstadt Hauptbahnhof",
+          "Karlstraße Darmstadt Innenstadt", "Schlossgartenstraße",
+          "Luisenplatz"}) {
+      auto const normalized = adr::normalize(query, buf);
+      t->guess<false>(normalized, dense, std::nullopt,
+                      adr::filter_type::kNone);
+      pruned.profile_.reset();
+      t->guess<false>(normalized, pruned, std::nullopt,
+                      adr::filter_type::kNone);
+      n_pruned += pruned.profile_.pruned_ ? 1U : 0U;
+
+      // Same candidates (ties at the max_matches boundary may differ).
+      EXPECT_EQ(cos_sims(dense), cos_sims(pruned)) << query;
+      if (dense.string_matches_.size() < max_matches) {
+        auto a = dense.string_matches_;
+        auto b = pruned.string_matches_;
+        auto const by_idx = [](auto&& x, auto&& y) { return x.idx_ < y.idx_; };
+        std::sort(begin(a), end(a), by_idx);
+        std::sort(begin(b), end(b), by_idx);
+        ASSERT_EQ(a.size(), b.size()) << query;
+        for (auto i = 0U; i != a.size(); ++i) {
+          EXPECT_EQ(a[i].idx_, b[i].idx_) << query;
+        }
+      }
+    }
+  }
+  EXPECT_NE(0U, n_pruned);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "osmium/builder/osm_object_builder.hpp"
+#include "osmium/memory/buffer.hpp"
+
+#include "adr/categories.h"
+
+#include "categories_reference.h"
+
+using tags_t = std::map<std::string, std::string>;
+
+template <typename AmenityTags>
+static adr::amenity_category classify(tags_t const& tags) {
+  auto buf = osmium::memory::Buffer{1024U,
+                                    osmium::memory::Buffer::auto_grow::yes};
+  {
+    auto b = osmium::builder::TagListBuilder{buf};
+    for (auto const& [k, v] : tags) {
+      b.add_tag(k, v);
+    }
+  }
+  buf.commit();
+  return AmenityTags{buf.get<osmium::TagList>(0U)}.get_category();
+}
+
+// Reference: the old generated first-match if chain.
+static adr::amenity_category reference_category(tags_t const& tags) {
+  return classify<adr::test::legacy_amenity_tags>(tags);
+}
+
+static adr::amenity_category category(tags_t const& tags) {
+  return classify<adr::amenity_tags>(tags);
+}
+
+// Tags satisfying rule r (wildcards get a value no rule asks for).
+static bool add_rule_tags(tags_t& tags, adr::amenity_rule const& r) {
+  for (auto i = 0U; i != r.n_conditions_; ++i) {
+    auto const& c = r.conditions_[i];
+    auto const value =
+        c.value_.empty() ? std::string{"__any"} : std::string{c.value_};
+    auto const [it, inserted] = tags.emplace(std::string{c.key_}, value);
+    if (!inserted && it->second != value) {
+      if (c.value_.empty()) {
+        continue;  // wildcard satisfied by the other rule's value
+      }
+      if (it->second != "__any") {
+        return false;  // conflicting values
+      }
+      it->second = value;
+    }
+  }
+  return true;
+}
+
+TEST(adr, categories_single_rule) {
+  for (auto const& r : adr::amenity_rules) {
+    auto tags = tags_t{};
+    ASSERT_TRUE(add_rule_tags(tags, r));
+    EXPECT_EQ(reference_category(tags), category(tags));
+  }
+  EXPECT_EQ(adr::amenity_category::kNone, category({}));
+  EXPECT_EQ(adr::amenity_category::kNone, category({{"amenity", "xyz"}}));
+}
+
+TEST(adr, categories_rule_pairs) {
+  for (auto const& a : adr::amenity_rules) {
+    for (auto const& b : adr::amenity_rules) {
+      auto tags = tags_t{};
+      if (add_rule_tags(tags, a) && add_rule_tags(tags, b)) {
+        ASSERT_EQ(reference_category(tags), category(tags));
+      }
+    }
+  }
+}
\ No newline at end of file
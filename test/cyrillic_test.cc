@@ -87,3 +87,95 @@ TEST(adr, extract_and_suggest_cyrillic) {
   ASSERT_FALSE(ctx.suggestions_.empty());
   EXPECT_EQ("Индже войвода", t->strings_[ctx.suggestions_[0].str_].view());
 }
+
+TEST(adr, place_filter_and_bbox) {
+  adr::extract("test/IndzheVoyvoda.osm.pbf", "adr_indzhe_filter", "/tmp");
+  auto const t = adr::read("adr_indzhe_filter/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const is_place = [](adr::suggestion const& s) {
+    return std::holds_alternative<adr::place_idx_t>(s.location_);
+  };
+
+  auto allowed = cista::raw::bitvec{};
+  allowed.resize(static_cast<unsigned>(t->place_names_.size()));
+  adr::get_suggestions<false>(*t, "Индже войвода", 10U, langs, ctx,
+                              std::nullopt, 1.0F, adr::filter_type::kNone,
+                              adr::place_filter{allowed});
+  EXPECT_FALSE(utl::any_of(ctx.suggestions_, is_place));
+
+  adr::get_suggestions<false>(*t, "Индже войвода", 10U, langs, ctx,
+                              std::nullopt, 1.0F, adr::filter_type::kNone,
+                              [](adr::place_idx_t) { return true; });
+  EXPECT_TRUE(utl::any_of(ctx.suggestions_, is_place));
+
+  auto far_away = geo::box{};
+  far_away.extend(geo::latlng{0.0, 0.0});
+  far_away.extend(geo::latlng{1.0, 1.0});
+  adr::get_suggestions<false>(*t, "Индже войвода", 10U, langs, ctx,
+                              std::nullopt, 1.0F, adr::filter_type::kNone, {},
+                              far_away);
+  EXPECT_TRUE(ctx.suggestions_.empty());
+}
+
+TEST(adr, guess_filter_type) {
+  adr::extract("test/IndzheVoyvoda.osm.pbf", "adr_indzhe_types", "/tmp");
+  auto const t = adr::read("adr_indzhe_types/t.bin");
+  ASSERT_EQ(t->strings_.size(), t->string_types_.size());
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const normalized = adr::normalize("Индже войвода");
+  t->guess<false>(normalized, ctx, std::nullopt, adr::filter_type::kAddress);
+  ASSERT_FALSE(ctx.string_matches_.empty());
+  for (auto const& m : ctx.string_matches_) {
+    EXPECT_TRUE(
+        adr::any(t->string_types_[m.idx_] & adr::filter_type::kAddress));
+  }
+}
+
+TEST(adr, short_prefix) {
+  adr::extract("test/IndzheVoyvoda.osm.pbf", "adr_indzhe_prefix", "/tmp");
+  auto const t = adr::read("adr_indzhe_prefix/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  adr::get_suggestions<false>(*t, "Ин", 10U, langs, ctx, std::nullopt, 1.0F);
+  ASSERT_FALSE(ctx.suggestions_.empty());
+  EXPECT_LE(ctx.suggestions_.size(), 10U);
+
+  auto const prefix = std::string{adr::normalize("Ин")};
+  for (auto const& s : ctx.suggestions_) {
+    EXPECT_TRUE(std::holds_alternative<adr::place_idx_t>(s.location_));
+    auto const name = t->strings_[s.str_].view();
+    EXPECT_TRUE(adr::normalize(name).starts_with(prefix)) << name;
+  }
+
+  adr::get_suggestions<false>(*t, "Ин", 10U, langs, ctx, std::nullopt, 1.0F,
+                              adr::filter_type::kAddress);
+  EXPECT_TRUE(ctx.suggestions_.empty());
+
+  // Three code points are still answered from the prefix index.
+  adr::get_suggestions<false>(*t, "Инд", 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_TRUE(ctx.profile_.short_prefix_);
+  auto const prefix3 = std::string{adr::normalize("Инд")};
+  for (auto const& s : ctx.suggestions_) {
+    auto const name = t->strings_[s.str_].view();
+    EXPECT_TRUE(adr::normalize(name).starts_with(prefix3)) << name;
+  }
+
+  adr::get_suggestions<false>(*t, "Индж", 10U, langs, ctx, std::nullopt,
+                              1.0F);
+  EXPECT_FALSE(ctx.profile_.short_prefix_);
+}
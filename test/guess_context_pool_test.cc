@@ -0,0 +1,121 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/guess_context_pool.h"
+#include "adr/index_handle.h"
+#include "adr/query_arena.h"
+
+TEST(adr, query_arena) {
+  auto a = adr::query_arena{64U};
+  EXPECT_EQ(64U, a.capacity());
+
+  auto const s = a.copy("darmstadt");
+  EXPECT_EQ("darmstadt", s);
+  EXPECT_EQ(9U, a.used());
+
+  // Aligned allocations.
+  auto v = std::pmr::vector<std::uint64_t>{&a};
+  v.push_back(42U);
+  EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(v.data()) %
+                    alignof(std::uint64_t));
+
+  // Overflow goes to the heap, the next reset grows the block.
+  v.resize(100U);
+  EXPECT_GT(a.used(), 64U);
+  v = std::pmr::vector<std::uint64_t>{&a};
+  auto const peak = a.used();
+  a.reset();
+  EXPECT_EQ(0U, a.used());
+  EXPECT_GE(a.capacity(), peak);
+  EXPECT_EQ(peak, a.high_water());
+
+  // Fits into the block now.
+  auto const capacity = a.capacity();
+  v.resize(100U);
+  v = std::pmr::vector<std::uint64_t>{&a};
+  a.reset();
+  EXPECT_EQ(capacity, a.capacity());
+}
+
+TEST(adr, guess_context_pool) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_pool", "/tmp");
+
+  auto handle = adr::index_handle{"adr_darmstadt_pool",
+                                  {.load_mode_ = adr::load_mode::kMmap}};
+  auto pool = adr::guess_context_pool{handle, {.max_size_ = 2U}};
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+
+  auto first = std::vector<adr::suggestion>{};
+  {
+    auto l = pool.acquire();
+    adr::get_suggestions<false>(l.t(), "Landwehrstraße", 10U, langs, l.ctx(),
+                                std::nullopt, 1.0F);
+    EXPECT_FALSE(l.ctx().suggestions_.empty());
+    first = l.ctx().suggestions_;
+  }
+  {
+    auto l = pool.acquire();  // reused
+    EXPECT_EQ(1U, pool.get_stats().created_);
+  }
+  EXPECT_GT(pool.get_stats().memory_bytes_, 0U);
+  EXPECT_GE(pool.get_stats().high_water_bytes_,
+            pool.get_stats().memory_bytes_);
+
+  // Reload: the pooled context is rebound lazily, results are the same.
+  handle.reload("adr_darmstadt_pool");
+  {
+    auto l = pool.acquire();
+    EXPECT_EQ(handle.get()->id_, l.generation().id_);
+    adr::get_suggestions<false>(l.t(), "Landwehrstraße", 10U, langs, l.ctx(),
+                                std::nullopt, 1.0F);
+    ASSERT_EQ(first.size(), l.ctx().suggestions_.size());
+    for (auto i = 0U; i != first.size(); ++i) {
+      EXPECT_EQ(first[i].location_, l.ctx().suggestions_[i].location_);
+    }
+  }
+  EXPECT_EQ(1U, pool.get_stats().rebinds_);
+
+  // Bounded: never more than max_size_ contexts in use.
+  auto queries = std::atomic_uint32_t{0U};
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0U; i != 8U; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0U; j != 4U; ++j) {
+        auto l = pool.acquire();
+        adr::get_suggestions<false>(l.t(), "Luisenplatz Darmstadt", 5U, langs,
+                                    l.ctx(), std::nullopt, 1.0F);
+        ++queries;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto const stats = pool.get_stats();
+  EXPECT_EQ(32U, queries.load());
+  EXPECT_EQ(0U, stats.in_use_);
+  EXPECT_LE(stats.max_in_use_, 2U);
+  EXPECT_LE(stats.size_, 2U);
+}
+
+TEST(adr, guess_context_pool_drop) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_pool_drop", "/tmp");
+
+  auto handle = adr::index_handle{"adr_darmstadt_pool_drop",
+                                  {.load_mode_ = adr::load_mode::kMmap}};
+  auto pool = adr::guess_context_pool{
+      handle, {.max_size_ = 1U, .max_context_bytes_ = 1U}};
+  {
+    auto l = pool.acquire();
+  }
+  auto const stats = pool.get_stats();
+  EXPECT_EQ(0U, stats.size_);
+  EXPECT_EQ(1U, stats.dropped_);
+  EXPECT_EQ(0U, stats.memory_bytes_);
+  EXPECT_GT(stats.high_water_bytes_, 0U);
+}
\ No newline at end of file
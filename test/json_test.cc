@@ -0,0 +1,57 @@
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/json.h"
+#include "adr/typeahead.h"
+
+TEST(adr, json_string) {
+  auto out = std::string{};
+  adr::append_json_string(out, "Landwehrstraße");
+  EXPECT_EQ("\"Landwehrstraße\"", out);
+
+  out.clear();
+  adr::append_json_string(out, "a\"b\\c\nd\te\x01");
+  EXPECT_EQ(R"("a\"b\\c\nd\te\u0001")", out);
+
+  out.clear();
+  adr::append_json_number(out, 49.5);
+  out.push_back(',');
+  adr::append_json_number(out, std::uint64_t{42U});
+  out.push_back(',');
+  adr::append_json_number(out, std::numeric_limits<double>::infinity());
+  EXPECT_EQ("49.5,42,null", out);
+}
+
+TEST(adr, json_suggestions) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_json", "/tmp");
+  auto const t = adr::read("adr_darmstadt_json/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  adr::get_suggestions<false>(*t, "Landwehrstraße 4 Darmstadt", 3U, langs,
+                              ctx, std::nullopt, 1.0F);
+  ASSERT_FALSE(ctx.suggestions_.empty());
+
+  auto out = std::string{};
+  adr::append_suggestions_json(out, *t, langs, ctx.suggestions_);
+  EXPECT_TRUE(
+      out.starts_with(R"([{"type":"address","name":"Landwehrstraße")"));
+  EXPECT_NE(std::string::npos, out.find(R"(,"lat":49.)"));
+  EXPECT_NE(std::string::npos, out.find(R"("name":"Darmstadt")"));
+  EXPECT_TRUE(out.ends_with("}]"));
+
+  auto n_objects = std::size_t{0U};
+  for (auto pos = out.find(R"("type":)"); pos != std::string::npos;
+       pos = out.find(R"("type":)", pos + 1U)) {
+    ++n_objects;
+  }
+  EXPECT_EQ(ctx.suggestions_.size(), n_objects);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "adr/cache.h"
+#include "adr/keystroke_trace.h"
+
+TEST(adr, generate_keystroke_trace) {
+  auto const trace =
+      adr::generate_keystroke_trace({"Darmstadt Hbf", "Käthe"}, 3U);
+
+  auto by_session = std::vector<std::vector<adr::keystroke>>(3U);
+  for (auto i = 0U; i != trace.size(); ++i) {
+    if (i != 0U) {
+      EXPECT_LE(trace[i - 1U].offset_ms_, trace[i].offset_ms_);
+    }
+    ASSERT_LT(trace[i].session_, 3U);
+    by_session[trace[i].session_].push_back(trace[i]);
+  }
+
+  auto const inputs = [](std::vector<adr::keystroke> const& s) {
+    auto v = std::vector<std::string>{};
+    for (auto const& k : s) {
+      v.push_back(k.input_);
+    }
+    return v;
+  };
+  EXPECT_EQ((std::vector<std::string>{"D", "Da", "Dar", "Darm", "Darms",
+                                      "Darmst", "Darmsta", "Darmstad",
+                                      "Darmstadt", "Darmstadt H",
+                                      "Darmstadt Hb", "Darmstadt Hbf"}),
+            inputs(by_session[0]));
+  EXPECT_EQ((std::vector<std::string>{"K", "Kä", "Kät", "Käth", "Käthe"}),
+            inputs(by_session[1]));
+  EXPECT_EQ(inputs(by_session[0]), inputs(by_session[2]));
+
+  // Pause before the next word: at least one extra delay.
+  auto const& s0 = by_session[0];
+  EXPECT_LT(s0[8].offset_ms_, s0[9].offset_ms_);
+}
+
+TEST(adr, keystroke_trace_round_trip) {
+  auto const trace = adr::generate_keystroke_trace({"Luisenplatz 5"}, 10U);
+
+  auto const path = std::string{"/tmp/adr_keystroke_trace.tsv"};
+  {
+    auto out = std::ofstream{path};
+    adr::write_keystroke_trace(out, trace);
+  }
+  auto const read = adr::read_keystroke_trace(path);
+
+  ASSERT_EQ(trace.size(), read.size());
+  for (auto i = 0U; i != trace.size(); ++i) {
+    EXPECT_EQ(trace[i].session_, read[i].session_);
+    EXPECT_EQ(trace[i].offset_ms_, read[i].offset_ms_);
+    EXPECT_EQ(trace[i].input_, read[i].input_);
+  }
+}
+
+TEST(adr, cache_stats) {
+  auto c = adr::cache{16U, 10U};
+  auto missing = adr::ngram_set_t{};
+
+  auto const ab = adr::ngram_set_t{1U, 2U};
+  c.add(ab, c.get_closest(ab, missing));
+  EXPECT_EQ(ab, missing);
+
+  c.get_closest(ab, missing);
+  EXPECT_TRUE(missing.empty());
+
+  c.get_closest({1U, 2U, 3U}, missing);
+  EXPECT_EQ((adr::ngram_set_t{3U}), missing);
+
+  auto const stats = c.get_stats();
+  EXPECT_EQ(1U, stats.hits_);
+  EXPECT_EQ(1U, stats.partial_hits_);
+  EXPECT_EQ(1U, stats.misses_);
+}
\ No newline at end of file
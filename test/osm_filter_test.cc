@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include "osmium/builder/attr.hpp"
+#include "osmium/io/pbf_input.hpp"
+#include "osmium/memory/buffer.hpp"
+#include "osmium/osm/node.hpp"
+#include "osmium/osm/way.hpp"
+
+#include "adr/categories.h"
+#include "adr/osm_filter.h"
+#include "adr/osm_filter_reference.h"
+
+TEST(adr, classify_tags) {
+  using adr::tag_class;
+  using namespace osmium::builder::attr;
+
+  auto buffer = osmium::memory::Buffer{1024U,
+                                       osmium::memory::Buffer::auto_grow::yes};
+  auto const add_node =
+      [&](std::initializer_list<std::pair<char const*, char const*>> tags) {
+        auto const offset = osmium::builder::add_node(buffer, _tags(tags));
+        return adr::classify_tags(buffer.get<osmium::Node>(offset).tags());
+      };
+
+  auto const tree = add_node({{"natural", "tree"}, {"name", "Eiche"}});
+  EXPECT_FALSE(tree.is_relevant_node());
+  EXPECT_TRUE(tree.is_relevant_way());
+  EXPECT_TRUE(tree.has(tag_class::kName));
+
+  auto const wood = add_node({{"natural", "wood"}});
+  EXPECT_FALSE(wood.is_relevant_node());
+  EXPECT_FALSE(wood.is_relevant_way());
+
+  auto const street = add_node({{"highway", "residential"}, {"name", "A"}});
+  EXPECT_FALSE(street.is_relevant_node());
+  EXPECT_TRUE(street.is_relevant_way());
+  EXPECT_TRUE(street.has(tag_class::kHighway));
+
+  auto const address = add_node(
+      {{"addr:housenumber", "1"}, {"addr:place", "Musagenitsa"}});
+  EXPECT_TRUE(address.is_relevant_node());
+  EXPECT_TRUE(address.is_address());
+  EXPECT_FALSE(address.has(tag_class::kName));
+  EXPECT_FALSE(address.has(tag_class::kAmenity));
+
+  auto const no_street = add_node({{"addr:housenumber", "1"}});
+  EXPECT_FALSE(no_street.is_address());
+
+  auto const cafe = add_node({{"amenity", "cafe"}, {"name", "C"}});
+  EXPECT_TRUE(cafe.is_relevant_node());
+  EXPECT_TRUE(cafe.has(tag_class::kAmenity));
+}
+
+// Compares classify_tags() with the tag list searches it replaces on all
+// nodes and ways of the test extract (timing: adr-bench --micro --osm).
+TEST(adr, classify_tags_pbf) {
+  auto n_objects = 0U;
+  auto n_mismatches = 0U;
+
+  auto const check = [&](osmium::TagList const& tags, bool const is_way) {
+    auto const reference_relevant =
+        is_way ? adr::is_relevant_way_reference(tags)
+               : adr::is_relevant_node_reference(tags);
+    auto const has_name = tags.has_key("name");
+    auto const has_highway = tags.has_key("highway");
+    auto const is_address = adr::is_address_reference(tags);
+    auto const c = adr::classify_tags(tags);
+    auto const relevant = is_way ? c.is_relevant_way() : c.is_relevant_node();
+
+    ++n_objects;
+    if (relevant != reference_relevant ||
+        c.has(adr::tag_class::kName) != has_name ||
+        c.has(adr::tag_class::kHighway) != has_highway ||
+        c.is_address() != is_address ||
+        (!c.has(adr::tag_class::kAmenity) &&
+         adr::amenity_tags{tags}.get_category() !=
+             adr::amenity_category::kNone)) {
+      ++n_mismatches;
+    }
+  };
+
+  auto reader =
+      osmium::io::Reader{"test/Darmstadt.osm.pbf",
+                         osmium::osm_entity_bits::node |
+                             osmium::osm_entity_bits::way};
+  while (auto buffer = reader.read()) {
+    for (auto const& n : buffer.select<osmium::Node>()) {
+      check(n.tags(), false);
+    }
+    for (auto const& w : buffer.select<osmium::Way>()) {
+      check(w.tags(), true);
+    }
+  }
+  reader.close();
+
+  EXPECT_GT(n_objects, 0U);
+  EXPECT_EQ(0U, n_mismatches);
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/query_budget.h"
+#include "adr/result_cache.h"
+#include "adr/typeahead.h"
+
+TEST(adr, query_budget_work) {
+  auto b = adr::query_budget{};
+  EXPECT_FALSE(b.is_limited());
+  b.start();
+  for (auto i = 0U; i != 100U; ++i) {
+    EXPECT_FALSE(b.stop_before(i));
+  }
+  EXPECT_FALSE(b.truncated());
+
+  b.work_limit_ = 10U;
+  b.min_candidates_ = 2U;
+  EXPECT_TRUE(b.is_limited());
+  b.start();
+  EXPECT_FALSE(b.stop_before(0U, 10U));
+  EXPECT_FALSE(b.stop_before(1U));  // exhausted, but min_candidates_
+  EXPECT_FALSE(b.truncated());
+  EXPECT_TRUE(b.stop_before(2U));
+  EXPECT_TRUE(b.truncated());
+
+  // Next stage: its best candidates are still processed.
+  EXPECT_FALSE(b.stop_before(0U));
+  EXPECT_TRUE(b.stop_before(2U));
+}
+
+TEST(adr, query_budget_time_limit_us) {
+  using namespace std::chrono_literals;
+
+  auto b = adr::query_budget{};
+  b.set_time_limit_us(1'000U);
+  EXPECT_EQ(1ms, b.time_limit_);
+  EXPECT_TRUE(b.is_limited());
+
+  // 0 and out of range values (client input) are unlimited.
+  for (auto const us :
+       {std::uint64_t{0U}, adr::query_budget::kMaxTimeLimitUs + 1U,
+        std::numeric_limits<std::uint64_t>::max()}) {
+    b.set_time_limit_us(us);
+    EXPECT_FALSE(b.is_limited());
+    b.start();
+    for (auto i = 0U; i != 100U; ++i) {
+      EXPECT_FALSE(b.stop_before(i));
+    }
+    EXPECT_FALSE(b.truncated());
+  }
+
+  // A huge limit set directly doesn't overflow the deadline either.
+  b.time_limit_ = adr::query_budget::clock::duration::max() - 1ns;
+  b.start();
+  for (auto i = 0U; i != 100U; ++i) {
+    EXPECT_FALSE(b.stop_before(i));
+  }
+  EXPECT_FALSE(b.truncated());
+}
+
+TEST(adr, query_budget_within) {
+  auto b = adr::query_budget{};
+  b.work_limit_ = 10U;
+  b.start();
+  EXPECT_FALSE(b.stop_before(0U));
+  EXPECT_FALSE(b.stop_within(9U));
+  EXPECT_FALSE(b.truncated());
+
+  // Applies to the first min_candidates_ candidates, too.
+  EXPECT_TRUE(b.stop_within(1U));
+  EXPECT_TRUE(b.truncated());
+  EXPECT_EQ(11U, b.work());
+}
+
+TEST(adr, query_budget_house_numbers) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_budget_hn", "/tmp");
+  auto const t = adr::read("adr_darmstadt_budget_hn/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const query =
+      std::string{"Landwehrstraße 1 2 3 4 5 6 7 8 9 10 11 12 Darmstadt"};
+
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  auto const unlimited_work = ctx.budget_.work();
+
+  // Every charge is at most one phrase score per phrase: the work stays
+  // within one charge of the limit, no matter how many house numbers the
+  // matched streets have.
+  constexpr auto const kLimit = std::uint64_t{200U};
+  ctx.budget_.work_limit_ = kLimit;
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_TRUE(ctx.profile_.truncated_);
+  EXPECT_LE(ctx.budget_.work(), kLimit + ctx.phrases_.size());
+  EXPECT_GT(unlimited_work, 4U * kLimit);
+}
+
+TEST(adr, query_budget) {
+  using namespace std::chrono_literals;
+
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_budget", "/tmp");
+  auto const t = adr::read("adr_darmstadt_budget/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto result_cache = adr::result_cache{1000U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+  ctx.result_cache_ = &result_cache;
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const query = std::string{"Landwehrstraße 4 Darmstadt"};
+
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  auto const full = ctx.suggestions_;
+  EXPECT_FALSE(ctx.profile_.truncated_);
+  ASSERT_FALSE(full.empty());
+  result_cache.clear();
+
+  // Expired deadline: the best candidates of each stage are still matched.
+  ctx.budget_.time_limit_ = 0ns;
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_TRUE(ctx.profile_.truncated_);
+  EXPECT_FALSE(ctx.suggestions_.empty());
+
+  // Truncated results are not cached.
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_FALSE(ctx.profile_.result_cache_hit_);
+  EXPECT_TRUE(ctx.profile_.truncated_);
+
+  // Generous budget: same as unlimited.
+  ctx.budget_.time_limit_ = 10s;
+  adr::get_suggestions<false>(*t, query, 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_FALSE(ctx.profile_.truncated_);
+  ASSERT_EQ(full.size(), ctx.suggestions_.size());
+  for (auto i = 0U; i != full.size(); ++i) {
+    EXPECT_EQ(full[i].location_, ctx.suggestions_[i].location_);
+  }
+}
\ No newline at end of file
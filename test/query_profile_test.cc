@@ -0,0 +1,93 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/query_profile.h"
+#include "adr/typeahead.h"
+
+TEST(adr, query_metrics_prometheus) {
+  using namespace std::chrono_literals;
+
+  auto p = adr::query_profile{};
+  p.add(adr::query_stage::kCount, 30us);
+  p.add(adr::query_stage::kCount, 20us);
+  p.add(adr::query_stage::kTotal, 2ms);
+  p.n_string_matches_ = 7U;
+  p.result_cache_hit_ = true;
+  EXPECT_TRUE(p.has_run(adr::query_stage::kCount));
+  EXPECT_FALSE(p.has_run(adr::query_stage::kCosSim));
+  EXPECT_EQ(50'000U, p.ns(adr::query_stage::kCount));
+
+  auto m = adr::query_metrics{};
+  m.add(p);
+  m.add(p);
+
+  auto ss = std::stringstream{};
+  m.print_prometheus(ss);
+  auto const out = ss.str();
+
+  auto const has = [&](std::string_view line) {
+    return out.find(line) != std::string::npos;
+  };
+  EXPECT_TRUE(has("adr_query_stage_seconds_bucket{stage=\"count\","
+                  "le=\"2.5e-05\"} 0\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_bucket{stage=\"count\","
+                  "le=\"5e-05\"} 2\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_bucket{stage=\"count\","
+                  "le=\"+Inf\"} 2\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_count{stage=\"count\"} 2\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_count{stage=\"cos_sim\"} 0\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_bucket{stage=\"total\","
+                  "le=\"0.001\"} 0\n"));
+  EXPECT_TRUE(has("adr_query_stage_seconds_bucket{stage=\"total\","
+                  "le=\"0.0025\"} 2\n"));
+  EXPECT_TRUE(has("adr_queries_total 2\n"));
+  EXPECT_TRUE(has("adr_result_cache_hits_total 2\n"));
+  EXPECT_TRUE(has("adr_string_matches_total 14\n"));
+}
+
+TEST(adr, query_profile) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_profile", "/tmp");
+  auto const t = adr::read("adr_darmstadt_profile/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto metrics = adr::query_metrics{};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+  ctx.query_metrics_ = &metrics;
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  adr::get_suggestions<false>(*t, "Landwehrstraße 4 Darmstadt", 10U, langs,
+                              ctx, std::nullopt, 1.0F);
+
+  auto const& p = ctx.profile_;
+  for (auto const s :
+       {adr::query_stage::kTokenize, adr::query_stage::kCount,
+        adr::query_stage::kCosSim, adr::query_stage::kPhraseScore,
+        adr::query_stage::kStreetMatch, adr::query_stage::kPlaceMatch,
+        adr::query_stage::kFinalize, adr::query_stage::kTotal}) {
+    EXPECT_TRUE(p.has_run(s));
+  }
+  EXPECT_GE(p.ns(adr::query_stage::kTotal),
+            p.ns(adr::query_stage::kCount) + p.ns(adr::query_stage::kCosSim));
+  EXPECT_EQ(3U, p.n_tokens_);
+  EXPECT_GT(p.n_string_matches_, 0U);
+  EXPECT_GT(p.n_suggestions_, 0U);
+  EXPECT_FALSE(p.short_prefix_);
+
+  // Second query: bigram counts come from the cache.
+  adr::get_suggestions<false>(*t, "Landwehrstraße 4 Darmstadt", 10U, langs,
+                              ctx, std::nullopt, 1.0F);
+  EXPECT_EQ(ctx.profile_.n_ngrams_, ctx.profile_.n_cached_ngrams_);
+
+  adr::get_suggestions<false>(*t, "La", 10U, langs, ctx, std::nullopt, 1.0F);
+  EXPECT_TRUE(ctx.profile_.short_prefix_);
+  EXPECT_FALSE(ctx.profile_.has_run(adr::query_stage::kCount));
+
+  EXPECT_EQ(3U, metrics.queries_.load());
+  EXPECT_EQ(1U, metrics.short_prefix_queries_.load());
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+
+#include "adr/adr.h"
+#include "adr/cache.h"
+#include "adr/guess_context.h"
+#include "adr/normalize.h"
+#include "adr/result_cache.h"
+#include "adr/typeahead.h"
+
+static adr::suggestion make_suggestion(float const score) {
+  return adr::suggestion{.str_ = adr::string_idx_t{0U},
+                         .location_ = adr::place_idx_t{0U},
+                         .coordinates_ = {},
+                         .area_set_ = adr::area_set_idx_t{0U},
+                         .matched_area_lang_ = {},
+                         .matched_areas_ = 0U,
+                         .matched_tokens_ = 0U,
+                         .score_ = score};
+}
+
+TEST(adr, result_cache_key) {
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const key = [&](std::string_view guess_str,
+                       std::vector<std::string_view> const& tokens,
+                       std::optional<geo::latlng> const& coord) {
+    return adr::result_cache::make_key(guess_str, tokens, langs,
+                                       adr::filter_type::kNone, 10U, coord,
+                                       1.0F, std::nullopt);
+  };
+
+  EXPECT_EQ(key("haupt bahnhof", {"haupt", "bahnhof"}, std::nullopt),
+            key("haupt bahnhof", {"haupt", "bahnhof"}, std::nullopt));
+  EXPECT_NE(key("hauptbahnhof", {"hauptbahnhof"}, std::nullopt),
+            key("haupt bahnhof", {"haupt", "bahnhof"}, std::nullopt));
+  EXPECT_NE(key("hauptbahnhof.", {"hauptbahnhof"}, std::nullopt),
+            key("hauptbahnhof", {"hauptbahnhof"}, std::nullopt));
+
+  auto const near = [&](geo::latlng const& coord) {
+    return key("hauptbahnhof", {"hauptbahnhof"}, coord);
+  };
+  EXPECT_EQ(near({49.8721, 8.6312}), near({49.8729, 8.6318}));
+  EXPECT_NE(near({49.8721, 8.6312}), near({50.1107, 8.6821}));
+}
+
+// Inputs with the same tokens but a different guess() string (punctuation,
+// repeated spaces, tokens after kMaxTokens) must not share a cache entry.
+TEST(adr, result_cache_guess_str) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_result_cache", "/tmp");
+  auto const t = adr::read("adr_darmstadt_result_cache/t.bin");
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto result_cache = adr::result_cache{1000U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const suggest = [&](std::string const& in, bool const use_cache) {
+    ctx.result_cache_ = use_cache ? &result_cache : nullptr;
+    adr::get_suggestions<false>(*t, in, 10U, langs, ctx, std::nullopt, 1.0F);
+    return ctx.suggestions_;
+  };
+
+  auto long_query = std::string{};
+  for (auto i = 0U; i != adr::kMaxTokens; ++i) {
+    long_query += "Darmstadt ";
+  }
+
+  auto const pairs = std::vector<std::pair<std::string, std::string>>{
+      {"Hauptbahnhof", "Hauptbahnhof."},
+      {"Landwehrstraße Darmstadt", "Landwehrstraße  Darmstadt"},
+      {long_query + "Luisenplatz", long_query + "Landwehrstraße"}};
+  for (auto const& [a, b] : pairs) {
+    result_cache.clear();
+    suggest(a, true);
+    suggest(a, true);
+    EXPECT_TRUE(ctx.profile_.result_cache_hit_) << a;
+
+    auto const cached = suggest(b, true);
+    EXPECT_FALSE(ctx.profile_.result_cache_hit_) << b;
+    auto const fresh = suggest(b, false);
+    ASSERT_EQ(fresh.size(), cached.size()) << b;
+    for (auto i = 0U; i != fresh.size(); ++i) {
+      EXPECT_EQ(fresh[i].location_, cached[i].location_) << b;
+      EXPECT_EQ(fresh[i].str_, cached[i].str_) << b;
+    }
+  }
+}
+
+TEST(adr, result_cache_admission) {
+  // One entry per shard.
+  auto c = adr::result_cache{adr::result_cache::kShards};
+
+  EXPECT_EQ(nullptr, c.get("a"));
+  c.add("a", {make_suggestion(1.0F)});
+  auto const a = c.get("a");
+  ASSERT_NE(nullptr, a);
+  ASSERT_EQ(1U, a->suggestions_.size());
+  EXPECT_EQ(1.0F, a->suggestions_.front().score_);
+  EXPECT_EQ(1U, a->hits_);
+
+  for (auto i = 0U; i != 3U; ++i) {
+    c.get("a");
+  }
+
+  // Find a key in the same shard as "a": it is rejected (never requested).
+  auto other = std::string{};
+  for (auto i = 0U; other.empty(); ++i) {
+    auto candidate = std::to_string(i);
+    c.add(candidate, {});
+    if (c.get(candidate) == nullptr) {
+      other = candidate;
+    } else {
+      c.clear();
+      c.add("a", {make_suggestion(1.0F)});
+    }
+  }
+
+  // A rarely requested key does not replace a frequently requested one...
+  c.add(other, {});
+  EXPECT_NE(nullptr, c.get("a"));
+  EXPECT_EQ(nullptr, c.get(other));
+
+  // ... but a popular key does.
+  for (auto i = 0U; i != 32U; ++i) {
+    c.get(other);
+  }
+  c.add(other, {});
+  EXPECT_NE(nullptr, c.get(other));
+  EXPECT_EQ(nullptr, c.get("a"));
+
+  auto const stats = c.get_stats();
+  EXPECT_NE(0U, stats.hits_);
+  EXPECT_NE(0U, stats.rejected_);
+  EXPECT_NE(0U, stats.evictions_);
+}
\ No newline at end of file
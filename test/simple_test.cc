@@ -1,15 +1,28 @@
+#include <array>
+#include <cmath>
+#include <fstream>
+
 #include "gtest/gtest.h"
 
+#include "utl/erase_duplicates.h"
+#include "utl/helpers/algorithm.h"
 #include "utl/to_vec.h"
 
 #include "fmt/core.h"
 
 #include "adr/adr.h"
+#include "adr/area_database.h"
 #include "adr/cache.h"
+#include "adr/geo_cell.h"
+#include "adr/import_context.h"
+#include "adr/index_handle.h"
 #include "adr/ngram.h"
 #include "adr/normalize.h"
+#include "adr/overlay.h"
 #include "adr/score.h"
+#include "adr/shard_router.h"
 #include "adr/sift4.h"
+#include "adr/typeahead.h"
 
 using adr::basic_string;
 
@@ -17,6 +30,564 @@ TEST(adr, simple) {
   adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt.cista", "/tmp");
 }
 
+TEST(adr, normalize_ascii_fast_path) {
+  auto fast_buf = adr::utf8_normalize_buf_t{};
+  auto ref_buf = adr::utf8_normalize_buf_t{};
+  for (auto const in :
+       {"", "A", "Darmstadt", "An der Hauptwache 15 Frankfurt am Main",
+        "4500 Kingsway #1001 Burnaby British Columbia @[`{~",
+        "Neustadt An Der Weinstraße Königsbach", "ABCDEFGHIJKLMNOPQRSTUVWXYZÄ",
+        "abcdefghijklmnopqrstuvwxyzÉ", "Индже войвода"}) {
+    EXPECT_EQ(adr::normalize_utf8proc(in, ref_buf),
+              adr::normalize(in, fast_buf));
+  }
+}
+
+TEST(adr, normalize_ascii_fast_path_dataset) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_normalize", "/tmp");
+  auto const t = adr::read("adr_darmstadt_normalize/t.bin");
+
+  auto fast_buf = adr::utf8_normalize_buf_t{};
+  auto ref_buf = adr::utf8_normalize_buf_t{};
+  for (auto const s : t->strings_) {
+    EXPECT_EQ(adr::normalize_utf8proc(s.view(), ref_buf),
+              adr::normalize(s.view(), fast_buf))
+        << s.view();
+  }
+}
+
+TEST(adr, read_mmap) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_mmap", "/tmp");
+  auto const a = adr::read("adr_darmstadt_mmap/t.bin", adr::load_mode::kRead);
+  auto const b =
+      adr::read("adr_darmstadt_mmap/t.bin", adr::load_mode::kMmapPrefault);
+
+  ASSERT_EQ(a->strings_.size(), b->strings_.size());
+  for (auto i = adr::string_idx_t{0U}; i < a->strings_.size(); ++i) {
+    EXPECT_EQ(a->strings_[i].view(), b->strings_[i].view());
+  }
+  EXPECT_EQ(a->bigrams_.size(), b->bigrams_.size());
+  EXPECT_EQ(a->place_coordinates_.size(), b->place_coordinates_.size());
+}
+
+TEST(adr, index_handle_swap) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_handle", "/tmp");
+
+  auto handle = adr::index_handle{
+      "adr_darmstadt_handle", {.load_mode_ = adr::load_mode::kMmap}};
+  auto const old_gen = handle.get();
+  auto old_ctx = old_gen->make_context();
+
+  auto const swapped = handle.reload("adr_darmstadt_handle");
+  EXPECT_EQ(old_gen, swapped);
+
+  auto const new_gen = handle.get();
+  EXPECT_NE(old_gen->id_, new_gen->id_);
+  EXPECT_NE(&old_gen->cache_, &new_gen->cache_);
+
+  // In-flight queries keep working on the generation they pinned.
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  adr::get_suggestions<false>(*old_gen->t_, "Landwehrstraße", 10U, langs,
+                              old_ctx, std::nullopt, 1.0F);
+  EXPECT_FALSE(old_ctx.suggestions_.empty());
+
+  auto new_ctx = new_gen->make_context();
+  adr::get_suggestions<false>(*new_gen->t_, "Landwehrstraße", 10U, langs,
+                              new_ctx, std::nullopt, 1.0F);
+  EXPECT_EQ(old_ctx.suggestions_.size(), new_ctx.suggestions_.size());
+}
+
+TEST(adr, overlay) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_overlay", "/tmp");
+  auto const base = adr::read("adr_darmstadt_overlay/t.bin");
+  auto const areas = adr::area_database{"adr_darmstadt_overlay",
+                                        cista::mmap::protection::READ};
+
+  auto deleted = adr::place_idx_t{0U};
+  while (base->place_is_way_.test(cista::to_idx(deleted)) ||
+         base->place_osm_ids_[deleted].empty()) {
+    ++deleted;
+  }
+
+  // Way place with the longest name (unique enough to be found).
+  auto modified = std::optional<adr::place_idx_t>{};
+  auto modified_name = std::string_view{};
+  for (auto p = adr::place_idx_t{0U}; p < base->place_names_.size(); ++p) {
+    if (!base->place_is_way_.test(cista::to_idx(p)) ||
+        base->place_osm_ids_[p].empty() || base->place_names_[p].empty()) {
+      continue;
+    }
+    auto const name = base->strings_[base->place_names_[p][0]].view();
+    if (name.find_first_of("&<>\"'") == std::string_view::npos &&
+        name.size() > modified_name.size()) {
+      modified = p;
+      modified_name = name;
+    }
+  }
+  ASSERT_TRUE(modified.has_value());
+
+  auto const osc = std::filesystem::path{"/tmp/adr_overlay_test.osc"};
+  {
+    auto out = std::ofstream{osc};
+    out << fmt::format(
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6" generator="test">
+  <create>
+    <node id="99000000001" version="1" lat="49.8728" lon="8.6512">
+      <tag k="name" v="Overlayplatz"/>
+      <tag k="amenity" v="restaurant"/>
+    </node>
+    <node id="99000000002" version="1" lat="49.8746" lon="8.6428">
+      <tag k="addr:street" v="Landwehrstraße"/>
+      <tag k="addr:housenumber" v="987"/>
+    </node>
+  </create>
+  <modify>
+    <way id="{}" version="9999">
+      <tag k="name" v="{}"/>
+      <tag k="building" v="yes"/>
+    </way>
+  </modify>
+  <delete>
+    <node id="{}" version="9999" lat="0" lon="0"/>
+  </delete>
+</osmChange>
+)",
+        base->place_osm_ids_[*modified][0], modified_name,
+        base->place_osm_ids_[deleted][0]);
+  }
+
+  auto const o = adr::overlay{*base, areas, osc};
+  EXPECT_TRUE(o.is_deleted(deleted));
+  EXPECT_FALSE(o.is_deleted(*modified));
+  EXPECT_EQ(1U, o.n_tombstones_);
+  ASSERT_EQ(1U, o.t().place_names_.size());
+  ASSERT_EQ(1U, o.t().street_names_.size());
+  EXPECT_EQ(1U, o.t().house_numbers_[adr::street_idx_t{0U}].size());
+
+  auto base_cache = adr::cache{base->strings_.size(), 100U};
+  auto overlay_cache = adr::cache{o.t().strings_.size(), 100U};
+  auto ctx = adr::guess_context{base_cache};
+  auto overlay_ctx = adr::guess_context{overlay_cache};
+  ctx.resize(*base);
+  overlay_ctx.resize(o.t());
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const merged = adr::get_suggestions<false>(
+      *base, o, "Overlayplatz", 10U, langs, ctx, overlay_ctx, std::nullopt,
+      1.0F);
+  ASSERT_FALSE(merged.empty());
+  EXPECT_TRUE(merged.front().from_overlay_);
+  EXPECT_FALSE(utl::any_of(merged, [&](adr::overlay_suggestion const& s) {
+    return !s.from_overlay_ &&
+           std::holds_alternative<adr::place_idx_t>(s.s_.location_) &&
+           std::get<adr::place_idx_t>(s.s_.location_) == deleted;
+  }));
+
+  // A modified way place keeps its base version.
+  auto const way_results = adr::get_suggestions<false>(
+      *base, o, std::string{modified_name}, 10U, langs, ctx, overlay_ctx,
+      std::nullopt, 1.0F);
+  EXPECT_TRUE(utl::any_of(way_results, [&](adr::overlay_suggestion const& s) {
+    return !s.from_overlay_ &&
+           std::holds_alternative<adr::place_idx_t>(s.s_.location_) &&
+           std::get<adr::place_idx_t>(s.s_.location_) == *modified;
+  }));
+
+  // Address nodes: the new house number is found in the overlay.
+  auto const address_results = adr::get_suggestions<false>(
+      *base, o, "Landwehrstraße 987", 10U, langs, ctx, overlay_ctx,
+      std::nullopt, 1.0F);
+  EXPECT_TRUE(
+      utl::any_of(address_results, [&](adr::overlay_suggestion const& s) {
+        return s.from_overlay_ &&
+               std::holds_alternative<adr::address>(s.s_.location_) &&
+               std::get<adr::address>(s.s_.location_).house_number_ !=
+                   adr::address::kNoHouseNumber;
+      }));
+
+  adr::compact("adr_darmstadt_overlay", o, "adr_darmstadt_compacted");
+  auto const compacted = adr::read("adr_darmstadt_compacted/t.bin");
+  EXPECT_EQ(base->place_names_.size(), compacted->place_names_.size());
+  EXPECT_EQ(base->street_names_.size(), compacted->street_names_.size());
+
+  auto const find_street = [](adr::typeahead const& t) {
+    for (auto s = adr::street_idx_t{0U}; s < t.street_names_.size(); ++s) {
+      if (t.strings_[t.street_names_[s][adr::kDefaultLangIdx]].view() ==
+          "Landwehrstraße") {
+        return s;
+      }
+    }
+    return adr::street_idx_t::invalid();
+  };
+  auto const street = find_street(*base);
+  ASSERT_NE(adr::street_idx_t::invalid(), street);
+  EXPECT_EQ(street, find_street(*compacted));
+  EXPECT_EQ(base->house_numbers_[street].size() + 1U,
+            compacted->house_numbers_[street].size());
+}
+
+TEST(adr, merge_shards) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_shard", "/tmp");
+  auto const shard = adr::read("adr_darmstadt_shard/t.bin");
+
+  // Merging a shard with itself deduplicates everything.
+  adr::merge({"adr_darmstadt_shard", "adr_darmstadt_shard"},
+             "adr_darmstadt_merged");
+  auto const merged = adr::read("adr_darmstadt_merged/t.bin");
+  EXPECT_EQ(shard->strings_.size(), merged->strings_.size());
+  EXPECT_EQ(shard->area_names_.size(), merged->area_names_.size());
+  EXPECT_EQ(shard->area_sets_.size(), merged->area_sets_.size());
+  EXPECT_EQ(shard->place_names_.size(), merged->place_names_.size());
+  EXPECT_EQ(shard->street_names_.size(), merged->street_names_.size());
+  for (auto s = adr::street_idx_t{0U}; s < shard->street_names_.size(); ++s) {
+    EXPECT_EQ(shard->street_pos_[s].size(), merged->street_pos_[s].size());
+    EXPECT_EQ(shard->house_numbers_[s].size(),
+              merged->house_numbers_[s].size());
+  }
+
+  // Router: both shards answer, results are merged by score. The shards
+  // hold the same data: each result is returned once, as from one shard.
+  auto const router =
+      adr::shard_router{{"adr_darmstadt_shard", "adr_darmstadt_merged"}};
+  auto const single = adr::shard_router{{"adr_darmstadt_shard"}};
+  auto ctx = adr::shard_router::context{};
+  auto single_ctx = adr::shard_router::context{};
+  auto const results = router.get_suggestions(ctx, "Landwehrstraße", 10U, {},
+                                              std::nullopt, 1.0F);
+  auto const single_results = single.get_suggestions(
+      single_ctx, "Landwehrstraße", 10U, {}, std::nullopt, 1.0F);
+  ASSERT_FALSE(results.empty());
+  EXPECT_LE(results.size(), 10U);
+  EXPECT_EQ(single_results.size(), results.size());
+  EXPECT_TRUE(std::is_sorted(
+      begin(results), end(results),
+      [](auto&& a, auto&& b) { return a.s_ < b.s_; }));
+}
+
+struct neustadt {
+  int base_;  // OSM ids base + 0..4
+  double lat_, lng_;
+};
+
+// Square boundary relations "Neustadt" (+ a place inside each).
+static void write_neustadt_shard(std::filesystem::path const& path,
+                                 std::vector<neustadt> const& areas) {
+  constexpr auto const kCorners = std::array<std::pair<double, double>, 4U>{
+      {{0.0, 0.0}, {0.0, 0.01}, {0.01, 0.01}, {0.01, 0.0}}};
+  auto nodes = std::string{};
+  auto ways = std::string{};
+  auto relations = std::string{};
+  for (auto const& a : areas) {
+    for (auto i = 0U; i != kCorners.size(); ++i) {
+      nodes += fmt::format(
+          "  <node id=\"{}\" version=\"1\" lat=\"{}\" lon=\"{}\"/>\n",
+          a.base_ + static_cast<int>(i), a.lat_ + kCorners[i].first,
+          a.lng_ + kCorners[i].second);
+    }
+    nodes += fmt::format(
+        R"(  <node id="{}" version="1" lat="{}" lon="{}">
+    <tag k="name" v="Marktplatz"/>
+    <tag k="place" v="square"/>
+  </node>
+)",
+        a.base_ + 4, a.lat_ + 0.005, a.lng_ + 0.005);
+    ways += fmt::format(
+        R"(  <way id="{0}" version="1">
+    <nd ref="{0}"/><nd ref="{1}"/><nd ref="{2}"/><nd ref="{3}"/><nd ref="{0}"/>
+  </way>
+)",
+        a.base_, a.base_ + 1, a.base_ + 2, a.base_ + 3);
+    relations += fmt::format(
+        R"(  <relation id="{}" version="1">
+    <member type="way" ref="{}" role="outer"/>
+    <tag k="type" v="boundary"/>
+    <tag k="boundary" v="administrative"/>
+    <tag k="admin_level" v="8"/>
+    <tag k="name" v="Neustadt"/>
+  </relation>
+)",
+        a.base_, a.base_);
+  }
+  auto out = std::ofstream{path};
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<osm version=\"0.6\" generator=\"test\">\n"
+      << nodes << ways << relations << "</osm>\n";
+}
+
+TEST(adr, shard_router_dedup) {
+  // Both shards contain Neustadt A with the same Marktplatz node.
+  write_neustadt_shard("/tmp/adr_router_1.osm",
+                       {{100, 49.0, 8.0}, {200, 50.0, 9.0}});
+  write_neustadt_shard("/tmp/adr_router_2.osm",
+                       {{100, 49.0, 8.0}, {300, 51.0, 10.0}});
+  adr::extract("/tmp/adr_router_1.osm", "adr_router_1", "/tmp");
+  adr::extract("/tmp/adr_router_2.osm", "adr_router_2", "/tmp");
+
+  auto const router = adr::shard_router{{"adr_router_1", "adr_router_2"}};
+  auto ctx = adr::shard_router::context{};
+  auto const results = router.get_suggestions(ctx, "Marktplatz", 10U, {},
+                                              std::nullopt, 1.0F);
+
+  auto ids = std::vector<std::uint64_t>{};
+  for (auto const& r : results) {
+    ASSERT_TRUE(std::holds_alternative<adr::place_idx_t>(r.s_.location_));
+    ids.push_back(r.s_.get_osm_id(*ctx.generations_[r.shard_]->t_));
+  }
+  utl::sort(ids);
+  EXPECT_EQ((std::vector<std::uint64_t>{104U, 204U, 304U}), ids);
+}
+
+TEST(adr, merge_shards_distinct_areas) {
+  // Shard 1: Neustadt A + B, shard 2: Neustadt A (same boundary) + C.
+  write_neustadt_shard("/tmp/adr_neustadt_1.osm",
+                       {{100, 49.0, 8.0}, {200, 50.0, 9.0}});
+  write_neustadt_shard("/tmp/adr_neustadt_2.osm",
+                       {{100, 49.0, 8.0}, {300, 51.0, 10.0}});
+  adr::extract("/tmp/adr_neustadt_1.osm", "adr_neustadt_1", "/tmp");
+  adr::extract("/tmp/adr_neustadt_2.osm", "adr_neustadt_2", "/tmp");
+  adr::merge({"adr_neustadt_1", "adr_neustadt_2"}, "adr_neustadt_merged");
+
+  auto const count_neustadt = [](adr::typeahead const& t) {
+    auto n = 0U;
+    for (auto const names : t.area_names_) {
+      n += !names.empty() && t.strings_[names[0]].view() == "Neustadt" ? 1U
+                                                                      : 0U;
+    }
+    return n;
+  };
+  auto const shard = adr::read("adr_neustadt_1/t.bin");
+  auto const merged = adr::read("adr_neustadt_merged/t.bin");
+  EXPECT_EQ(2U, count_neustadt(*shard));
+  EXPECT_EQ(3U, count_neustadt(*merged));
+}
+
+TEST(adr, build_ngram_index) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_ngram", "/tmp");
+  auto const t = adr::read("adr_darmstadt_ngram/t.bin");
+
+  // Reference: sequential build.
+  auto buf = adr::utf8_normalize_buf_t{};
+  auto expected = std::vector<std::vector<adr::string_idx_t>>(adr::kNBigrams);
+  for (auto i = adr::string_idx_t{0U}; i < t->strings_.size(); ++i) {
+    if (t->numeric_strings_.test(cista::to_idx(i)) &&
+        (i >= t->string_to_location_.size() ||
+         t->string_to_location_[i].empty())) {
+      continue;
+    }
+    adr::for_each_bigram(adr::normalize(t->strings_[i].view(), buf),
+                         [&](std::string_view bigram) {
+                           expected[adr::compress_bigram(bigram)].push_back(i);
+                         });
+  }
+
+  ASSERT_EQ(expected.size(), t->bigrams_.size());
+  for (auto b = 0U; b != adr::kNBigrams; ++b) {
+    utl::erase_duplicates(expected[b]);
+    auto const bucket = t->bigrams_[b];
+    ASSERT_EQ(expected[b].size(), bucket.size());
+    EXPECT_TRUE(std::equal(begin(bucket), end(bucket), begin(expected[b])));
+  }
+}
+
+TEST(adr, string_lookup) {
+  auto ctx = adr::import_context{};
+  auto t = adr::typeahead{};
+  t.strings_.emplace_back(std::string_view{"Darmstadt"});
+
+  // Existing strings are found after binding.
+  EXPECT_EQ(adr::string_idx_t{0U}, t.get_or_create_string(ctx, "Darmstadt"));
+
+  auto const a = t.get_or_create_string(ctx, "Kirchweg");
+  auto const name = std::string{"Kirchweg"};
+  EXPECT_EQ(a, t.get_or_create_string(ctx, std::string_view{name}));
+  EXPECT_NE(a, t.get_or_create_string(ctx, "Kirchwe"));
+  EXPECT_EQ(3U, t.strings_.size());
+  EXPECT_EQ("Kirchwe", t.strings_[adr::string_idx_t{2U}].view());
+}
+
+TEST(adr, cluster_street_positions) {
+  auto ctx = adr::import_context{};
+  auto t = adr::typeahead{};
+  auto const a = t.get_or_create_street(ctx, "Kirchweg");
+  auto const b = t.get_or_create_street(ctx, "Dateline Road");
+
+  auto const add = [&](adr::street_idx_t const s, geo::latlng const& x) {
+    ctx.street_pos_[s].emplace_back(adr::coordinates::from_latlng(x));
+  };
+  add(a, {49.8700, 8.6500});
+  add(a, {49.8790, 8.6500});  // ~1000m north: same cluster
+  add(a, {49.8880, 8.6500});  // ~2000m from the first: new cluster
+  add(a, {49.8700, 8.6500});
+
+  // Clustering across the antimeridian.
+  add(b, {0.0, 179.999});
+  add(b, {0.0, -179.999});
+
+  t.cluster_street_positions(ctx);
+  ASSERT_EQ(2U, t.street_pos_.size());
+  EXPECT_EQ(2U, t.street_pos_[a].size());
+  EXPECT_EQ(1U, t.street_pos_[b].size());
+}
+
+TEST(adr, geo_index_option) {
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_no_geo", "/tmp");
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_geo", "/tmp", true);
+  auto const without = adr::read("adr_darmstadt_no_geo/t.bin");
+  auto const with = adr::read("adr_darmstadt_geo/t.bin");
+  EXPECT_TRUE(without->geo_bigrams_.empty());
+  EXPECT_FALSE(with->geo_bigrams_.empty());
+  EXPECT_EQ(without->bigrams_.size(), with->bigrams_.size());
+}
+
+// Places far away from Darmstadt (lat/lng 10): "Landwehrstraße <i>" for
+// i = 0..n-1 and one "Landwehrstraßenfest", inside a boundary "Fernstadt".
+static void write_far_places(std::filesystem::path const& path,
+                             unsigned const n) {
+  constexpr auto const kBase = std::int64_t{9'100'000'000};
+  auto nodes = std::string{};
+  auto const add_place = [&](std::int64_t const id, std::string_view name) {
+    nodes += fmt::format(
+        R"(  <node id="{}" version="1" lat="{:.6f}" lon="{:.6f}">
+    <tag k="name" v="{}"/>
+    <tag k="place" v="square"/>
+  </node>
+)",
+        id, 10.001 + (id % 100) * 0.0001, 10.001 + (id / 100 % 100) * 0.0001,
+        name);
+  };
+  for (auto i = 0U; i != n; ++i) {
+    add_place(kBase + 10 + i, fmt::format("Landwehrstraße {}", i));
+  }
+  add_place(kBase + 10 + n, "Landwehrstraßenfest");
+
+  auto out = std::ofstream{path};
+  out << fmt::format(
+      R"(<?xml version="1.0" encoding="UTF-8"?>
+<osm version="0.6" generator="test">
+  <node id="{0}" version="1" lat="10.0" lon="10.0"/>
+  <node id="{1}" version="1" lat="10.0" lon="10.02"/>
+  <node id="{2}" version="1" lat="10.02" lon="10.02"/>
+  <node id="{3}" version="1" lat="10.02" lon="10.0"/>
+{4}  <way id="{0}" version="1">
+    <nd ref="{0}"/><nd ref="{1}"/><nd ref="{2}"/><nd ref="{3}"/><nd ref="{0}"/>
+  </way>
+  <relation id="{0}" version="1">
+    <member type="way" ref="{0}" role="outer"/>
+    <tag k="type" v="boundary"/>
+    <tag k="boundary" v="administrative"/>
+    <tag k="admin_level" v="8"/>
+    <tag k="name" v="Fernstadt"/>
+  </relation>
+</osm>
+)",
+      kBase, kBase + 1, kBase + 2, kBase + 3, nodes);
+}
+
+TEST(adr, geo_candidates) {
+  write_far_places("/tmp/adr_far_places.osm", 1200U);
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_geo_candidates",
+               "/tmp", true);
+  adr::extract("/tmp/adr_far_places.osm", "adr_far_places", "/tmp", true);
+  adr::merge({"adr_darmstadt_geo_candidates", "adr_far_places"},
+             "adr_geo_candidates_merged");
+  auto const t = adr::read("adr_geo_candidates_merged/t.bin");
+  ASSERT_FALSE(t->geo_bigrams_.empty());
+
+  auto cache = adr::cache{t->strings_.size(), 100U};
+  auto ctx = adr::guess_context{cache};
+  ctx.resize(*t);
+  ctx.limits_.min_matches_ = 1U;
+  ctx.limits_.max_matches_ = 1U;
+
+  auto const langs =
+      adr::basic_string<adr::language_idx_t>{{adr::kDefaultLang}};
+  auto const suggest = [&](std::string const& in, geo::latlng const& coord,
+                           bool const geo_candidates) {
+    ctx.geo_candidates_ = geo_candidates;
+    adr::get_suggestions<false>(*t, in, 10U, langs, ctx, coord, 1.0F);
+    return ctx.suggestions_;
+  };
+  auto const has_result_near = [](std::vector<adr::suggestion> const& v,
+                                  geo::latlng const& c) {
+    return utl::any_of(v, [&](adr::suggestion const& s) {
+      auto const pos = s.coordinates_.as_latlng();
+      return std::abs(pos.lat() - c.lat()) < 0.1 &&
+             std::abs(pos.lng() - c.lng()) < 0.1;
+    });
+  };
+
+  // Enough candidates around the coordinate: local path only. Globally, the
+  // exact match in Darmstadt takes the only slot.
+  auto const far = geo::latlng{10.01, 10.01};
+  auto const local = suggest("Landwehrstraße", far, true);
+  EXPECT_TRUE(ctx.profile_.geo_candidates_);
+  EXPECT_TRUE(has_result_near(local, far));
+  auto const global = suggest("Landwehrstraße", far, false);
+  EXPECT_FALSE(ctx.profile_.geo_candidates_);
+  EXPECT_FALSE(has_result_near(global, far));
+
+  // Few candidates around the coordinate: full scan, but the local ones are
+  // kept. Globally, the far exact match takes the only slot.
+  auto const darmstadt = geo::latlng{49.8731, 8.6477};
+  auto const kept = suggest("Landwehrstraßenfest", darmstadt, true);
+  EXPECT_FALSE(ctx.profile_.geo_candidates_);
+  EXPECT_TRUE(has_result_near(kept, darmstadt));
+  auto const cut = suggest("Landwehrstraßenfest", darmstadt, false);
+  EXPECT_FALSE(has_result_near(cut, darmstadt));
+  EXPECT_TRUE(has_result_near(cut, far));
+}
+
+TEST(adr, geo_cell_neighbours) {
+  auto cells = std::vector<adr::geo_cell_t>{};
+  adr::for_each_geo_cell({49.87, 8.65}, 1, [&](adr::geo_cell_t const c) {
+    cells.emplace_back(c);
+  });
+  EXPECT_EQ(9U, cells.size());
+  EXPECT_TRUE(utl::any_of(
+      cells, [](auto&& c) { return c == adr::to_geo_cell({49.87, 8.65}); }));
+
+  // Longitudes wrap around at the antimeridian.
+  cells.clear();
+  adr::for_each_geo_cell({0.1, 179.9}, 1, [&](adr::geo_cell_t const c) {
+    cells.emplace_back(c);
+  });
+  EXPECT_TRUE(utl::any_of(
+      cells, [](auto&& c) { return c == adr::to_geo_cell({0.1, -179.9}); }));
+
+  // Latitudes are clamped at the poles.
+  cells.clear();
+  adr::for_each_geo_cell({89.9, 0.0}, 1, [&](adr::geo_cell_t const c) {
+    cells.emplace_back(c);
+  });
+  EXPECT_EQ(6U, cells.size());
+}
+
+TEST(adr, numeric_strings) {
+  EXPECT_TRUE(adr::is_numeric("12"));
+  EXPECT_TRUE(adr::is_numeric("12a"));
+  EXPECT_TRUE(adr::is_numeric("1-3"));
+  EXPECT_TRUE(adr::is_numeric("64283"));
+  EXPECT_FALSE(adr::is_numeric(""));
+  EXPECT_FALSE(adr::is_numeric("Haus 1"));
+  EXPECT_FALSE(adr::is_numeric("бл. 26"));
+
+  adr::extract("test/Darmstadt.osm.pbf", "adr_darmstadt_numeric", "/tmp");
+  auto const t = adr::read("adr_darmstadt_numeric/t.bin");
+
+  // Numeric strings without locations are not part of the bigram index.
+  for (auto const postings : t->bigrams_) {
+    for (auto const str : postings) {
+      EXPECT_TRUE(!t->numeric_strings_.test(cista::to_idx(str)) ||
+                  (str < t->string_to_location_.size() &&
+                   !t->string_to_location_[str].empty()))
+          << t->strings_[str].view();
+    }
+  }
+}
+
 TEST(adr, for_each_trigram) {
   constexpr auto const in = std::string_view{"Landwehrstraße"};
   std::vector<std::string> v;